@@ -0,0 +1,474 @@
+// BatchBlur.cpp : Command line tool that blurs a batch of image files offscreen.
+//
+// Images flow through a pipeline whose stages run concurrently:
+// decoder threads -> upload & blur on the GL thread -> asynchronous PBO readback -> encoder threads.
+// Bounded queues between the stages keep only a handful of images in memory at any time.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <list>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+#include <glad/glad.h>
+#include <stb_image.h>
+#include <filesystem/path.h>
+
+#include "GLHeadlessContext.hpp"
+#include "GLFramebuffer.hpp"
+#include "GLTexture2D.hpp"
+#include "GLReadbackRing.hpp"
+#include "GaussianBlur/GaussianBlurEffect.hpp"
+#include "GaussianBlur/TiledGaussianBlur.hpp"
+#include "GaussianFunction.hpp"
+#include "BlockingQueue.hpp"
+#include "PNGEncoder.hpp"
+#include "PNGDecoder.hpp"
+#include "ParallelUtils.hpp"
+
+namespace {
+
+	/// Number of readbacks allowed to be in flight before the GL thread waits for the oldest one
+	constexpr size_t ReadbackRingSize = 3;
+
+	/// Blur targets of this many most recently used image sizes are kept around
+	constexpr size_t MaxCachedBlurTargets = 4;
+
+	struct Options {
+		std::vector<std::string> inputs;
+		std::string outputDirectory;
+		Engine::GaussianBlurSettings settings{ 15, 7.5f, Engine::GaussianFunction::LDRTruncationEpsilon };
+		size_t decoderCount = std::max(Engine::Utils::Parallel::ConcurrencyLevel() / 2, size_t(1));
+		size_t encoderCount = std::max(Engine::Utils::Parallel::ConcurrencyLevel() / 2, size_t(1));
+	};
+
+	struct STBDeleter {
+		void operator()(stbi_uc *pixels) const { stbi_image_free(pixels); }
+	};
+
+	struct DecodedImage {
+		std::string outputPath;
+		int width = 0;
+		int height = 0;
+		int channels = 0;
+		/// Always RGBA regardless of the source channel count
+		std::unique_ptr<stbi_uc, STBDeleter> pixels;
+		/// Set instead of pixels for images that don't fit into a texture, rows are decoded while they are blurred
+		std::unique_ptr<Engine::PNGDecoder> rows;
+	};
+
+	struct EncodeJob {
+		std::string outputPath;
+		int width = 0;
+		int height = 0;
+		int channels = 0;
+		std::vector<uint8_t> pixels;
+	};
+
+	struct PendingReadback {
+		std::string outputPath;
+		int channels = 0;
+		std::future<Engine::GLReadbackRing::Result> result;
+	};
+
+	/// Everything needed to blur images of a particular size
+	struct BlurTarget {
+		Engine::GaussianBlurEffect effect;
+		Engine::GLNormalizedTexture2D<Engine::GLTexture::Normalized::RGBA> source;
+		Engine::GLNormalizedTexture2D<Engine::GLTexture::Normalized::RGBA> destination;
+		Engine::GLFramebuffer framebuffer;
+
+		BlurTarget(const filesystem::path &resourceRoot, const Engine::Size2D &size)
+			: effect(resourceRoot, size), source(size), destination(size), framebuffer(size) {
+			framebuffer.attachTexture(destination);
+		}
+	};
+
+	/// Blur targets keyed by image size, most recently used first
+	using BlurTargetCache = std::list<std::pair<std::pair<int, int>, std::unique_ptr<BlurTarget>>>;
+
+	BlurTarget &AcquireBlurTarget(BlurTargetCache &targets, const filesystem::path &resourceRoot, int width, int height) {
+		auto key = std::make_pair(width, height);
+		auto targetIt = std::find_if(targets.begin(), targets.end(), [&](const BlurTargetCache::value_type &entry) { return entry.first == key; });
+
+		if (targetIt != targets.end()) {
+			targets.splice(targets.begin(), targets, targetIt);
+			return *targets.front().second;
+		}
+
+		// Only the least recently used size is evicted, so a batch alternating between a few sizes keeps all of them.
+		// Readbacks already in flight copied the destination into their own buffers and don't need the target anymore.
+		if (targets.size() >= MaxCachedBlurTargets) {
+			targets.pop_back();
+		}
+
+		targets.emplace_front(key, std::make_unique<BlurTarget>(resourceRoot, Engine::Size2D(width, height)));
+		return *targets.front().second;
+	}
+
+	bool HasPNGExtension(const std::string &name) {
+		if (name.size() < 4) return false;
+
+		std::string extension = name.substr(name.size() - 4);
+		std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+		return extension == ".png";
+	}
+
+	/// Non-recursive listing of PNG files in the directory
+	std::vector<std::string> ListPNGFiles(const filesystem::path &directory) {
+		std::vector<std::string> files;
+
+#ifdef _WIN32
+		WIN32_FIND_DATAA data;
+		HANDLE handle = FindFirstFileA((directory / filesystem::path("*.png")).str().c_str(), &data);
+		if (handle == INVALID_HANDLE_VALUE) return files;
+
+		do {
+			if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+				files.push_back((directory / filesystem::path(data.cFileName)).str());
+			}
+		} while (FindNextFileA(handle, &data));
+		FindClose(handle);
+#else
+		DIR *handle = opendir(directory.str().c_str());
+		if (!handle) return files;
+
+		while (dirent *entry = readdir(handle)) {
+			filesystem::path file = directory / filesystem::path(entry->d_name);
+			if (HasPNGExtension(entry->d_name) && file.is_file()) {
+				files.push_back(file.str());
+			}
+		}
+		closedir(handle);
+#endif
+
+		std::sort(files.begin(), files.end());
+		return files;
+	}
+
+	/// Reduces RGBA pixels to the channel count of the source file, packed may alias rgba
+	void PackChannels(const uint8_t *rgba, uint8_t *packed, size_t pixelCount, int channels) {
+		for (size_t i = 0; i < pixelCount; i++, rgba += 4, packed += channels) {
+			switch (channels) {
+			case 1: packed[0] = rgba[0]; break;
+			case 2: packed[0] = rgba[0]; packed[1] = rgba[3]; break;
+			case 3: packed[0] = rgba[0]; packed[1] = rgba[1]; packed[2] = rgba[2]; break;
+			default: std::memmove(packed, rgba, 4); break;
+			}
+		}
+	}
+
+	/// Reduces RGBA pixels to the channel count of the source file in place
+	void PackChannels(std::vector<uint8_t> &pixels, int channels) {
+		if (channels == 4) return;
+
+		size_t pixelCount = pixels.size() / 4;
+		PackChannels(pixels.data(), pixels.data(), pixelCount, channels);
+		pixels.resize(pixelCount * channels);
+	}
+
+	void RunDecoders(const Options &options, size_t maximumTextureSize, std::vector<std::thread> &threads, Engine::BlockingQueue<DecodedImage> &output, std::atomic<size_t> &failures) {
+		auto nextInput = std::make_shared<std::atomic<size_t>>(0);
+		auto activeDecoders = std::make_shared<std::atomic<size_t>>(options.decoderCount);
+
+		for (size_t i = 0; i < options.decoderCount; i++) {
+			threads.emplace_back([&options, maximumTextureSize, &output, &failures, nextInput, activeDecoders]() {
+				for (size_t index = (*nextInput)++; index < options.inputs.size(); index = (*nextInput)++) {
+					const std::string &inputPath = options.inputs[index];
+
+					DecodedImage image;
+					image.outputPath = (filesystem::path(options.outputDirectory) / filesystem::path(filesystem::path(inputPath).filename())).str();
+
+					// Images too large for a texture are blurred in bands and shouldn't be resident in memory either.
+					// Only non-interlaced PNG files can be decoded row by row, anything else falls back to stb_image.
+					int width = 0, height = 0, channels = 0;
+					if (stbi_info(inputPath.c_str(), &width, &height, &channels) &&
+						(size_t(width) > maximumTextureSize || size_t(height) > maximumTextureSize)) {
+						try {
+							image.rows = std::make_unique<Engine::PNGDecoder>(inputPath);
+							image.width = int(image.rows->width());
+							image.height = int(image.rows->height());
+							image.channels = int(image.rows->channels());
+						}
+						catch (const std::exception &) {
+							image.rows.reset();
+						}
+					}
+
+					// Rows stay top-down: blur doesn't care about orientation and readback returns them in the same order
+					if (!image.rows) {
+						image.pixels.reset(stbi_load(inputPath.c_str(), &image.width, &image.height, &image.channels, STBI_rgb_alpha));
+					}
+
+					if (!image.pixels && !image.rows) {
+						fprintf(stderr, "Failed to decode %s: %s\n", inputPath.c_str(), stbi_failure_reason());
+						failures++;
+						continue;
+					}
+
+					if (!output.push(std::move(image))) {
+						break;
+					}
+				}
+
+				// Last decoder to finish signals end of the stream
+				if (--(*activeDecoders) == 0) {
+					output.close();
+				}
+			});
+		}
+	}
+
+	void RunEncoders(const Options &options, std::vector<std::thread> &threads, Engine::BlockingQueue<EncodeJob> &input, std::atomic<size_t> &failures, std::atomic<size_t> &completed) {
+		for (size_t i = 0; i < options.encoderCount; i++) {
+			threads.emplace_back([&input, &failures, &completed]() {
+				EncodeJob job;
+				while (input.pop(job)) {
+					try {
+						PackChannels(job.pixels, job.channels);
+						Engine::PNGEncoder::Write(job.outputPath, job.pixels.data(), job.width, job.height, job.channels);
+						completed++;
+					}
+					catch (const std::exception &e) {
+						fprintf(stderr, "Failed to encode %s: %s\n", job.outputPath.c_str(), e.what());
+						failures++;
+					}
+				}
+			});
+		}
+	}
+
+	/// Moves finished readbacks to the encoding stage in submission order
+	void DispatchFinishedReadbacks(std::deque<PendingReadback> &readbacks, Engine::BlockingQueue<EncodeJob> &output) {
+		while (!readbacks.empty() && readbacks.front().result.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+			PendingReadback &readback = readbacks.front();
+			Engine::GLReadbackRing::Result result = readback.result.get();
+
+			EncodeJob job;
+			job.outputPath = std::move(readback.outputPath);
+			job.width = int(result.width);
+			job.height = int(result.height);
+			job.channels = readback.channels;
+			job.pixels = std::move(result.pixels);
+
+			readbacks.pop_front();
+			output.push(std::move(job));
+		}
+	}
+
+	/// Streams an image that doesn't fit into a texture from its decoder through the tiled blur into the output file.
+	/// Only a band of tiles is resident at a time, so neither the source nor the result is ever fully decoded.
+	void BlurInBands(Engine::TiledGaussianBlur &tiledBlur, DecodedImage &image, const Engine::GaussianBlurSettings &settings) {
+		Engine::PNGRowEncoder encoder(image.outputPath, image.width, image.height, image.channels);
+		std::vector<uint8_t> packedRow(size_t(image.width) * image.channels);
+
+		auto reader = [&](size_t, uint8_t *pixels) {
+			image.rows->readRow(pixels);
+		};
+
+		auto writer = [&](size_t, const uint8_t *pixels) {
+			PackChannels(pixels, packedRow.data(), image.width, image.channels);
+			encoder.writeRow(packedRow.data());
+		};
+
+		tiledBlur.blur(image.width, image.height, settings, reader, writer);
+		encoder.finish();
+	}
+
+	/// GL thread part of the pipeline: upload, blur and asynchronous readback
+	void RunBlurStage(const filesystem::path &resourceRoot, const Options &options, size_t maximumTextureSize, Engine::BlockingQueue<DecodedImage> &input, Engine::BlockingQueue<EncodeJob> &output, std::atomic<size_t> &failures, std::atomic<size_t> &completed) {
+		BlurTargetCache targets;
+		std::deque<PendingReadback> pendingReadbacks;
+		Engine::GLReadbackRing readbackRing(ReadbackRingSize);
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		std::unique_ptr<Engine::TiledGaussianBlur> tiledBlur;
+
+		DecodedImage image;
+		while (input.pop(image)) {
+			// Images that don't fit into a texture are blurred in tiles synchronously,
+			// decoding and encoding happen on this thread while the bands are processed
+			if (image.rows) {
+				if (!tiledBlur) tiledBlur = std::make_unique<Engine::TiledGaussianBlur>(resourceRoot);
+
+				try {
+					BlurInBands(*tiledBlur, image, options.settings);
+					completed++;
+				}
+				catch (const std::exception &e) {
+					fprintf(stderr, "Failed to blur %s: %s\n", image.outputPath.c_str(), e.what());
+					failures++;
+				}
+
+				image.rows.reset();
+				continue;
+			}
+
+			// Formats that can't be decoded row by row arrive fully decoded and are blurred in tiles from memory
+			if (size_t(image.width) > maximumTextureSize || size_t(image.height) > maximumTextureSize) {
+				if (!tiledBlur) tiledBlur = std::make_unique<Engine::TiledGaussianBlur>(resourceRoot);
+
+				EncodeJob job;
+				job.outputPath = std::move(image.outputPath);
+				job.width = image.width;
+				job.height = image.height;
+				job.channels = image.channels;
+				job.pixels.resize(size_t(image.width) * image.height * 4);
+
+				tiledBlur->blur(image.pixels.get(), job.pixels.data(), image.width, image.height, options.settings);
+				image.pixels.reset();
+
+				output.push(std::move(job));
+				continue;
+			}
+
+			BlurTarget &target = AcquireBlurTarget(targets, resourceRoot, image.width, image.height);
+
+			target.source.upload(image.pixels.get());
+			image.pixels.reset();
+
+			target.effect.blurWithoutMask(target.source, target.framebuffer, options.settings);
+
+			// Ring blocks on the oldest readback when all of its buffers are busy
+			PendingReadback readback;
+			readback.outputPath = std::move(image.outputPath);
+			readback.channels = image.channels;
+			readback.result = readbackRing.readAsync(target.framebuffer, target.destination);
+			pendingReadbacks.push_back(std::move(readback));
+
+			// Hand over whatever is already finished without stalling
+			readbackRing.poll();
+			DispatchFinishedReadbacks(pendingReadbacks, output);
+		}
+
+		readbackRing.finish();
+		DispatchFinishedReadbacks(pendingReadbacks, output);
+	}
+
+	void PrintUsage() {
+		fprintf(stderr,
+			"Usage: UbiBlurBatch --output <directory> [options] <image.png | directory>...\n"
+			"Options:\n"
+			"  --radius <pixels>        blur radius (default 15)\n"
+			"  --sigma <pixels>         Gaussian standard deviation (default radius / 2)\n"
+			"  --error-budget <value>   allowed per-channel error of approximate algorithms (default 0)\n"
+			"  --decoders <count>       number of decoding threads\n"
+			"  --encoders <count>       number of encoding threads\n");
+	}
+
+	bool ParseOptions(int argc, char *argv[], Options &options) {
+		bool sigmaSpecified = false;
+
+		for (int i = 1; i < argc; i++) {
+			bool hasValue = i + 1 < argc;
+
+			if (strcmp(argv[i], "--output") == 0 && hasValue) {
+				options.outputDirectory = argv[++i];
+			} else if (strcmp(argv[i], "--radius") == 0 && hasValue) {
+				options.settings.radius = std::max(atoi(argv[++i]), 1);
+			} else if (strcmp(argv[i], "--sigma") == 0 && hasValue) {
+				options.settings.sigma = float(atof(argv[++i]));
+				sigmaSpecified = true;
+			} else if (strcmp(argv[i], "--error-budget") == 0 && hasValue) {
+				options.settings.errorBudget = float(atof(argv[++i]));
+			} else if (strcmp(argv[i], "--decoders") == 0 && hasValue) {
+				options.decoderCount = std::max(atoi(argv[++i]), 1);
+			} else if (strcmp(argv[i], "--encoders") == 0 && hasValue) {
+				options.encoderCount = std::max(atoi(argv[++i]), 1);
+			} else if (argv[i][0] == '-') {
+				return false;
+			} else {
+				filesystem::path input(argv[i]);
+				if (input.is_directory()) {
+					auto files = ListPNGFiles(input);
+					options.inputs.insert(options.inputs.end(), files.begin(), files.end());
+				} else {
+					options.inputs.push_back(input.str());
+				}
+			}
+		}
+
+		if (!sigmaSpecified) {
+			options.settings.sigma = options.settings.radius / 2.f;
+		}
+
+		return !options.outputDirectory.empty() && !options.inputs.empty();
+	}
+
+}
+
+int main(int argc, char* argv[]) {
+	filesystem::path path(argv[0]);
+
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		exit(EXIT_FAILURE);
+	}
+
+	if (!filesystem::path(options.outputDirectory).is_directory()) {
+		fprintf(stderr, "Output directory %s doesn't exist\n", options.outputDirectory.c_str());
+		exit(EXIT_FAILURE);
+	}
+
+	// Decoded images are consumed in any order, queue depth bounds the memory footprint
+	Engine::BlockingQueue<DecodedImage> decodedImages(options.decoderCount * 2);
+	Engine::BlockingQueue<EncodeJob> encodeJobs(options.encoderCount * 2);
+
+	std::vector<std::thread> decoders;
+	std::vector<std::thread> encoders;
+	std::atomic<size_t> failures(0);
+	std::atomic<size_t> completed(0);
+	int status = EXIT_SUCCESS;
+
+	auto start = std::chrono::steady_clock::now();
+
+	try {
+		Engine::GLHeadlessContext context;
+		gladLoadGLLoader((GLADloadproc)Engine::GLHeadlessContext::ProcAddress);
+
+		size_t maximumTextureSize = Engine::TiledGaussianBlur::MaximumTileSize();
+
+		RunDecoders(options, maximumTextureSize, decoders, decodedImages, failures);
+		RunEncoders(options, encoders, encodeJobs, failures, completed);
+		RunBlurStage(path.parent_path(), options, maximumTextureSize, decodedImages, encodeJobs, failures, completed);
+	}
+	catch (const std::exception &e) {
+		fprintf(stderr, "Error: %s\n", e.what());
+		status = EXIT_FAILURE;
+	}
+
+	// Unblocks decoders in case the GL thread bailed out early
+	decodedImages.close();
+	encodeJobs.close();
+	for (auto &thread : decoders) thread.join();
+	for (auto &thread : encoders) thread.join();
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	printf("Blurred %zu of %zu images in %.2f s (%.2f images/sec)\n",
+		size_t(completed), options.inputs.size(), elapsed.count(), completed / elapsed.count());
+
+	if (failures > 0) {
+		fprintf(stderr, "%zu images failed\n", size_t(failures));
+		status = EXIT_FAILURE;
+	}
+
+	exit(status);
+}
@@ -0,0 +1,286 @@
+//
+//  CPUConvolutionEngine.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "CPUConvolutionEngine.hpp"
+#include "ParallelUtils.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <cmath>
+
+namespace Engine {
+
+#pragma mark - Lifecycle
+
+    CPUConvolutionEngine::CPUConvolutionEngine(const ConvolutionKernel2D &kernel)
+            : mKernel(kernel) {
+
+        mLayout.fftWidth = FFTLength(kernel.width());
+        mLayout.fftHeight = FFTLength(kernel.height());
+        mLayout.tileWidth = mLayout.fftWidth - kernel.width() + 1;
+        mLayout.tileHeight = mLayout.fftHeight - kernel.height() + 1;
+    }
+
+#pragma mark - Private helpers
+
+    size_t CPUConvolutionEngine::FFTLength(size_t kernelExtent) {
+        size_t minimumLength = std::max({2 * kernelExtent - 1, kernelExtent + 1, size_t(2)});
+        size_t length = FFT::NextPowerOfTwo(minimumLength);
+
+        size_t bestLength = length;
+        double bestCost = std::numeric_limits<double>::max();
+
+        for (size_t candidate = length; candidate <= length * 4; candidate *= 2) {
+            size_t tile = candidate - kernelExtent + 1;
+            double costPerPixel = candidate * std::log2(double(candidate)) / double(tile);
+            if (costPerPixel < bestCost) {
+                bestCost = costPerPixel;
+                bestLength = candidate;
+            }
+        }
+
+        return bestLength;
+    }
+
+    double CPUConvolutionEngine::TransformCost(size_t fftWidth, size_t fftHeight) {
+        // Real-input transform is half of a complex 2D one: w * h / 4 * log2(w * h) butterflies
+        double sampleCount = double(fftWidth) * double(fftHeight);
+        return sampleCount / 4.0 * std::log2(sampleCount) * FFTCostPerButterfly;
+    }
+
+    void CPUConvolutionEngine::prepareFFTIfNeeded() {
+        if (mFFT) {
+            return;
+        }
+
+        mFFT = std::make_unique<RealFFT2D>(mLayout.fftWidth, mLayout.fftHeight);
+
+        std::vector<float> paddedKernel(mLayout.fftWidth * mLayout.fftHeight, 0.f);
+        for (size_t y = 0; y < mKernel.height(); y++) {
+            for (size_t x = 0; x < mKernel.width(); x++) {
+                paddedKernel[y * mLayout.fftWidth + x] = mKernel.weight(x, y);
+            }
+        }
+
+        std::vector<FFT::Complex> scratch;
+        mKernelSpectrum.resize(mFFT->spectrumLength());
+        mFFT->forward(paddedKernel.data(), mKernelSpectrum.data(), scratch);
+    }
+
+#pragma mark Direct convolution
+
+    CPUImage CPUConvolutionEngine::convolveDirect(const CPUImage &image) const {
+        CPUImage result(image.width, image.height, image.channels);
+
+        const int64_t w = image.width;
+        const int64_t h = image.height;
+        const int64_t rx = mKernel.radiusX();
+        const int64_t ry = mKernel.radiusY();
+
+        Utils::Parallel::For(image.height, 8, [&](size_t begin, size_t end) {
+            for (int64_t y = begin; y < int64_t(end); y++) {
+                for (int64_t x = 0; x < w; x++) {
+                    for (size_t c = 0; c < image.channels; c++) {
+                        float sum = 0.f;
+                        for (int64_t j = 0; j < int64_t(mKernel.height()); j++) {
+                            int64_t sy = std::min(std::max(y + ry - j, int64_t(0)), h - 1);
+                            for (int64_t i = 0; i < int64_t(mKernel.width()); i++) {
+                                int64_t sx = std::min(std::max(x + rx - i, int64_t(0)), w - 1);
+                                sum += mKernel.weight(i, j) * image.at(sx, sy, c);
+                            }
+                        }
+                        result.at(x, y, c) = sum;
+                    }
+                }
+            }
+        });
+
+        return result;
+    }
+
+    CPUImage CPUConvolutionEngine::convolveDirectSeparable(const CPUImage &image) const {
+        CPUImage intermediate(image.width, image.height, image.channels);
+        CPUImage result(image.width, image.height, image.channels);
+
+        const int64_t w = image.width;
+        const int64_t h = image.height;
+        const int64_t rx = mKernel.radiusX();
+        const int64_t ry = mKernel.radiusY();
+        const auto &horizontal = mKernel.horizontalFactors();
+        const auto &vertical = mKernel.verticalFactors();
+
+        Utils::Parallel::For(image.height, 8, [&](size_t begin, size_t end) {
+            for (int64_t y = begin; y < int64_t(end); y++) {
+                for (int64_t x = 0; x < w; x++) {
+                    for (size_t c = 0; c < image.channels; c++) {
+                        float sum = 0.f;
+                        for (int64_t i = 0; i < int64_t(horizontal.size()); i++) {
+                            int64_t sx = std::min(std::max(x + rx - i, int64_t(0)), w - 1);
+                            sum += horizontal[i] * image.at(sx, y, c);
+                        }
+                        intermediate.at(x, y, c) = sum;
+                    }
+                }
+            }
+        });
+
+        Utils::Parallel::For(image.height, 8, [&](size_t begin, size_t end) {
+            for (int64_t y = begin; y < int64_t(end); y++) {
+                for (int64_t x = 0; x < w; x++) {
+                    for (size_t c = 0; c < image.channels; c++) {
+                        float sum = 0.f;
+                        for (int64_t j = 0; j < int64_t(vertical.size()); j++) {
+                            int64_t sy = std::min(std::max(y + ry - j, int64_t(0)), h - 1);
+                            sum += vertical[j] * intermediate.at(x, sy, c);
+                        }
+                        result.at(x, y, c) = sum;
+                    }
+                }
+            }
+        });
+
+        return result;
+    }
+
+#pragma mark FFT convolution
+
+    CPUImage CPUConvolutionEngine::convolveFFT(const CPUImage &image) {
+        prepareFFTIfNeeded();
+
+        CPUImage result(image.width, image.height, image.channels);
+
+        const int64_t w = image.width;
+        const int64_t h = image.height;
+        const int64_t rx = mKernel.radiusX();
+        const int64_t ry = mKernel.radiusY();
+        const int64_t tileWidth = mLayout.tileWidth;
+        const int64_t tileHeight = mLayout.tileHeight;
+        const int64_t convolvedWidth = tileWidth + mKernel.width() - 1;
+        const int64_t convolvedHeight = tileHeight + mKernel.height() - 1;
+        const size_t fftWidth = mLayout.fftWidth;
+
+        // Input domain is extended by kernel radius with edge clamping,
+        // so that output near the borders matches direct convolution
+        const int64_t domainWidth = w + 2 * rx;
+        const int64_t domainHeight = h + 2 * ry;
+        const int64_t tilesX = (domainWidth + tileWidth - 1) / tileWidth;
+        const int64_t tilesY = (domainHeight + tileHeight - 1) / tileHeight;
+
+        // Tiles two steps apart never overlap after convolution, so tiles of the same
+        // parity are accumulated concurrently without synchronization in 4 phases
+        for (int64_t phase = 0; phase < 4; phase++) {
+            std::vector<std::pair<int64_t, int64_t>> tiles;
+            for (int64_t ty = phase / 2; ty < tilesY; ty += 2) {
+                for (int64_t tx = phase % 2; tx < tilesX; tx += 2) {
+                    tiles.emplace_back(tx, ty);
+                }
+            }
+
+            Utils::Parallel::For(tiles.size(), 1, [&](size_t begin, size_t end) {
+                std::vector<float> spatial(mFFT->width() * mFFT->height());
+                std::vector<FFT::Complex> spectrum(mFFT->spectrumLength());
+                std::vector<FFT::Complex> scratch;
+
+                for (size_t t = begin; t < end; t++) {
+                    int64_t originX = tiles[t].first * tileWidth - rx;
+                    int64_t originY = tiles[t].second * tileHeight - ry;
+
+                    for (size_t c = 0; c < image.channels; c++) {
+                        std::fill(spatial.begin(), spatial.end(), 0.f);
+
+                        for (int64_t v = 0; v < tileHeight; v++) {
+                            int64_t sy = originY + v;
+                            if (sy >= h + ry) break;
+                            sy = std::min(std::max(sy, int64_t(0)), h - 1);
+
+                            for (int64_t u = 0; u < tileWidth; u++) {
+                                int64_t sx = originX + u;
+                                if (sx >= w + rx) break;
+                                sx = std::min(std::max(sx, int64_t(0)), w - 1);
+                                spatial[v * fftWidth + u] = image.at(sx, sy, c);
+                            }
+                        }
+
+                        mFFT->forward(spatial.data(), spectrum.data(), scratch);
+
+                        for (size_t i = 0; i < spectrum.size(); i++) {
+                            spectrum[i] *= mKernelSpectrum[i];
+                        }
+
+                        mFFT->inverse(spectrum.data(), spatial.data(), scratch);
+
+                        for (int64_t v = 0; v < convolvedHeight; v++) {
+                            int64_t y = originY + v - ry;
+                            if (y < 0 || y >= h) continue;
+
+                            for (int64_t u = 0; u < convolvedWidth; u++) {
+                                int64_t x = originX + u - rx;
+                                if (x < 0 || x >= w) continue;
+                                result.at(x, y, c) += spatial[v * fftWidth + u];
+                            }
+                        }
+                    }
+                }
+            });
+        }
+
+        return result;
+    }
+
+#pragma mark - Public interface
+
+    const ConvolutionKernel2D &CPUConvolutionEngine::kernel() const {
+        return mKernel;
+    }
+
+    CPUConvolutionEngine::CostEstimate CPUConvolutionEngine::estimateCost(size_t width, size_t height, size_t channels) const {
+        CostEstimate estimate;
+
+        double pixelCount = double(width) * double(height) * double(channels);
+        double taps = mKernel.isSeparable() ?
+                double(mKernel.width() + mKernel.height()) :
+                double(mKernel.width() * mKernel.height());
+        estimate.direct = pixelCount * taps * DirectCostPerTap;
+
+        double tilesX = std::ceil(double(width + 2 * mKernel.radiusX()) / double(mLayout.tileWidth));
+        double tilesY = std::ceil(double(height + 2 * mKernel.radiusY()) / double(mLayout.tileHeight));
+        double sampleCount = double(mLayout.fftWidth) * double(mLayout.fftHeight);
+
+        // Forward and inverse transforms, spectrum multiplication, tile gather and accumulation
+        double perTile = 2.0 * TransformCost(mLayout.fftWidth, mLayout.fftHeight) +
+                3.0 * double(mLayout.fftWidth / 2 + 1) * double(mLayout.fftHeight) +
+                2.0 * sampleCount;
+        estimate.fft = tilesX * tilesY * double(channels) * perTile;
+
+        return estimate;
+    }
+
+    CPUConvolutionEngine::Method CPUConvolutionEngine::preferredMethod(size_t width, size_t height, size_t channels) const {
+        CostEstimate estimate = estimateCost(width, height, channels);
+        return estimate.fft < estimate.direct ? Method::FFT : Method::Direct;
+    }
+
+    CPUImage CPUConvolutionEngine::convolve(const CPUImage &image, Method method) {
+        if (image.empty()) {
+            throw std::invalid_argument("Cannot convolve an empty image");
+        }
+
+        if (method == Method::Automatic) {
+            method = preferredMethod(image.width, image.height, image.channels);
+        }
+
+        switch (method) {
+            case Method::FFT:
+                return convolveFFT(image);
+            default:
+                return mKernel.isSeparable() ? convolveDirectSeparable(image) : convolveDirect(image);
+        }
+    }
+
+}
@@ -0,0 +1,89 @@
+//
+//  CPUConvolutionEngine.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef CPUConvolutionEngine_hpp
+#define CPUConvolutionEngine_hpp
+
+#include "ConvolutionKernel2D.hpp"
+#include "CPUImage.hpp"
+#include "FFT.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace Engine {
+
+    /**
+     Offline convolution of CPU images with arbitrary 2D kernels.
+     Small kernels are applied directly (in two 1D passes when the kernel is separable),
+     large ones are applied in frequency domain: the image is split into tiles which are
+     transformed with a real-input FFT, multiplied by the kernel's spectrum and
+     overlap-added into the output. Image borders are extended by clamping to edge.
+     */
+    class CPUConvolutionEngine {
+    public:
+        enum class Method {
+            Automatic, Direct, FFT
+        };
+
+        /// Estimated amount of work in abstract multiply-add units
+        struct CostEstimate {
+            double direct = 0.0;
+            double fft = 0.0;
+        };
+
+        /// Cost of a single kernel tap in direct convolution
+        static constexpr double DirectCostPerTap = 1.0;
+
+        /// Cost of a single radix-2 butterfly, including strided memory access of column transforms
+        static constexpr double FFTCostPerButterfly = 8.0;
+
+    private:
+        struct FFTLayout {
+            size_t fftWidth = 0;
+            size_t fftHeight = 0;
+            size_t tileWidth = 0;
+            size_t tileHeight = 0;
+        };
+
+        ConvolutionKernel2D mKernel;
+        FFTLayout mLayout;
+        std::unique_ptr<RealFFT2D> mFFT;
+        std::vector<FFT::Complex> mKernelSpectrum;
+
+        /// Picks FFT length for the kernel extent minimizing transform work per output pixel.
+        /// Tile (FFT length minus kernel extent plus one) is never smaller than kernel extent minus one,
+        /// which guarantees that tiles two steps apart never write to the same output pixels.
+        static size_t FFTLength(size_t kernelExtent);
+
+        static double TransformCost(size_t fftWidth, size_t fftHeight);
+
+        void prepareFFTIfNeeded();
+
+        CPUImage convolveDirect(const CPUImage &image) const;
+
+        CPUImage convolveDirectSeparable(const CPUImage &image) const;
+
+        CPUImage convolveFFT(const CPUImage &image);
+
+    public:
+        CPUConvolutionEngine(const ConvolutionKernel2D &kernel);
+
+        const ConvolutionKernel2D &kernel() const;
+
+        CostEstimate estimateCost(size_t width, size_t height, size_t channels) const;
+
+        /// @return method with the lowest estimated cost for the image of given dimensions
+        Method preferredMethod(size_t width, size_t height, size_t channels) const;
+
+        CPUImage convolve(const CPUImage &image, Method method = Method::Automatic);
+    };
+
+}
+
+#endif /* CPUConvolutionEngine_hpp */
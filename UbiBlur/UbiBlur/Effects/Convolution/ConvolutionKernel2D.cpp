@@ -0,0 +1,122 @@
+//
+//  ConvolutionKernel2D.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "ConvolutionKernel2D.hpp"
+#include "CPUImage.hpp"
+
+#include <stdexcept>
+#include <numeric>
+
+namespace Engine {
+
+#pragma mark - Lifecycle
+
+    ConvolutionKernel2D::ConvolutionKernel2D(size_t width, size_t height, const std::vector<float> &weights) {
+        if (width == 0 || height == 0 || weights.size() != width * height) {
+            throw std::invalid_argument("Kernel weights count must match non-zero kernel dimensions");
+        }
+
+        mWidth = width % 2 == 0 ? width + 1 : width;
+        mHeight = height % 2 == 0 ? height + 1 : height;
+        mWeights.resize(mWidth * mHeight, 0.f);
+
+        for (size_t y = 0; y < height; y++) {
+            for (size_t x = 0; x < width; x++) {
+                mWeights[y * mWidth + x] = weights[y * width + x];
+            }
+        }
+
+        float sum = std::accumulate(mWeights.begin(), mWeights.end(), 0.f);
+        if (sum == 0.f) {
+            throw std::invalid_argument("Kernel weights must not sum up to zero");
+        }
+
+        for (float &weight : mWeights) {
+            weight /= sum;
+        }
+    }
+
+    std::vector<float> ConvolutionKernel2D::MirroredKernel(const GaussianFunction::Kernel1D &halfKernel) {
+        size_t radius = halfKernel.size() - 1;
+        std::vector<float> kernel(2 * radius + 1);
+        for (size_t i = 0; i <= radius; i++) {
+            kernel[radius + i] = halfKernel[i];
+            kernel[radius - i] = halfKernel[i];
+        }
+        return kernel;
+    }
+
+    ConvolutionKernel2D ConvolutionKernel2D::FromKernel1D(const GaussianFunction::Kernel1D &halfKernel) {
+        if (halfKernel.empty()) {
+            throw std::invalid_argument("1D kernel must contain at least a center tap");
+        }
+
+        ConvolutionKernel2D kernel;
+        kernel.mHorizontalFactors = MirroredKernel(halfKernel);
+        kernel.mVerticalFactors = kernel.mHorizontalFactors;
+        kernel.mWidth = kernel.mHorizontalFactors.size();
+        kernel.mHeight = kernel.mVerticalFactors.size();
+        kernel.mWeights.resize(kernel.mWidth * kernel.mHeight);
+
+        for (size_t y = 0; y < kernel.mHeight; y++) {
+            for (size_t x = 0; x < kernel.mWidth; x++) {
+                kernel.mWeights[y * kernel.mWidth + x] = kernel.mHorizontalFactors[x] * kernel.mVerticalFactors[y];
+            }
+        }
+
+        return kernel;
+    }
+
+    ConvolutionKernel2D ConvolutionKernel2D::Gaussian(size_t radius, float sigma, float truncationEpsilon) {
+        return FromKernel1D(GaussianFunction::Produce1DKernel(radius, sigma, truncationEpsilon));
+    }
+
+    ConvolutionKernel2D ConvolutionKernel2D::FromImage(const std::string &imagePath) {
+        CPUImage image = CPUImage::LoadLDRImage(imagePath, 1);
+        return ConvolutionKernel2D(image.width, image.height, image.pixels);
+    }
+
+#pragma mark - Getters
+
+    size_t ConvolutionKernel2D::width() const {
+        return mWidth;
+    }
+
+    size_t ConvolutionKernel2D::height() const {
+        return mHeight;
+    }
+
+    size_t ConvolutionKernel2D::radiusX() const {
+        return mWidth / 2;
+    }
+
+    size_t ConvolutionKernel2D::radiusY() const {
+        return mHeight / 2;
+    }
+
+    float ConvolutionKernel2D::weight(size_t x, size_t y) const {
+        return mWeights[y * mWidth + x];
+    }
+
+    const std::vector<float> &ConvolutionKernel2D::weights() const {
+        return mWeights;
+    }
+
+    bool ConvolutionKernel2D::isSeparable() const {
+        return !mHorizontalFactors.empty();
+    }
+
+    const std::vector<float> &ConvolutionKernel2D::horizontalFactors() const {
+        return mHorizontalFactors;
+    }
+
+    const std::vector<float> &ConvolutionKernel2D::verticalFactors() const {
+        return mVerticalFactors;
+    }
+
+}
@@ -0,0 +1,76 @@
+//
+//  ConvolutionKernel2D.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef ConvolutionKernel2D_hpp
+#define ConvolutionKernel2D_hpp
+
+#include <cstdio>
+#include <vector>
+#include <string>
+
+#include "GaussianFunction.hpp"
+
+namespace Engine {
+
+    /// Normalized 2D convolution kernel with odd dimensions, centered at (width / 2, height / 2).
+    /// Kernels built from 1D Gaussians remember their separable factors
+    /// so that direct convolution can be performed in two 1D passes.
+    class ConvolutionKernel2D {
+    private:
+        size_t mWidth = 0;
+        size_t mHeight = 0;
+        std::vector<float> mWeights;
+        std::vector<float> mHorizontalFactors;
+        std::vector<float> mVerticalFactors;
+
+        ConvolutionKernel2D() = default;
+
+        static std::vector<float> MirroredKernel(const GaussianFunction::Kernel1D &halfKernel);
+
+    public:
+        /// Builds separable kernel from a half 1D kernel (center tap followed by one side)
+        /// as produced by GaussianFunction::Produce1DKernel
+        static ConvolutionKernel2D FromKernel1D(const GaussianFunction::Kernel1D &halfKernel);
+
+        static ConvolutionKernel2D Gaussian(size_t radius, float sigma, float truncationEpsilon = 0.0);
+
+        /// Loads arbitrary kernel shape (bokeh, for example) from luminance of an image file
+        static ConvolutionKernel2D FromImage(const std::string &imagePath);
+
+        /**
+         Constructs kernel from arbitrary weights. Weights are normalized to sum up to 1.
+         Even dimensions are padded with zeros to become odd.
+
+         @param width number of columns
+         @param height number of rows
+         @param weights row-major weights
+         */
+        ConvolutionKernel2D(size_t width, size_t height, const std::vector<float> &weights);
+
+        size_t width() const;
+
+        size_t height() const;
+
+        size_t radiusX() const;
+
+        size_t radiusY() const;
+
+        float weight(size_t x, size_t y) const;
+
+        const std::vector<float> &weights() const;
+
+        bool isSeparable() const;
+
+        const std::vector<float> &horizontalFactors() const;
+
+        const std::vector<float> &verticalFactors() const;
+    };
+
+}
+
+#endif /* ConvolutionKernel2D_hpp */
@@ -0,0 +1,224 @@
+//
+//  GaussianBlurCostModel.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "GaussianBlurCostModel.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <stdexcept>
+#include <cmath>
+#include <limits>
+
+namespace Engine {
+
+    constexpr std::array<size_t, 6> GaussianBlurCostModel::CalibrationRadii;
+
+#pragma mark - Static helpers
+
+    size_t GaussianBlurCostModel::AlgorithmIndex(GaussianBlurAlgorithm algorithm) {
+        return static_cast<std::underlying_type<GaussianBlurAlgorithm>::type>(algorithm);
+    }
+
+    const std::array<GaussianBlurAlgorithm, GaussianBlurCostModel::AlgorithmCount> &GaussianBlurCostModel::AllAlgorithms() {
+        static std::array<GaussianBlurAlgorithm, AlgorithmCount> algorithms{{
+                GaussianBlurAlgorithm::Separable,
+                GaussianBlurAlgorithm::DownsampledSeparable
+        }};
+        return algorithms;
+    }
+
+    const char *GaussianBlurCostModel::AlgorithmName(GaussianBlurAlgorithm algorithm) {
+        switch (algorithm) {
+            case GaussianBlurAlgorithm::Separable:
+                return "Separable";
+            case GaussianBlurAlgorithm::DownsampledSeparable:
+                return "DownsampledSeparable";
+        }
+        return "";
+    }
+
+    bool GaussianBlurCostModel::IsSupported(GaussianBlurAlgorithm algorithm, const GaussianBlurSettings &settings) {
+        switch (algorithm) {
+            case GaussianBlurAlgorithm::Separable:
+                return settings.radius <= MaximumSeparableRadius;
+            case GaussianBlurAlgorithm::DownsampledSeparable:
+                return settings.radius >= 2 && settings.radius / 2 <= MaximumSeparableRadius;
+        }
+        return false;
+    }
+
+    float GaussianBlurCostModel::EstimatedError(GaussianBlurAlgorithm algorithm, const GaussianBlurSettings &settings) {
+        switch (algorithm) {
+            case GaussianBlurAlgorithm::Separable:
+                return 0.0;
+            case GaussianBlurAlgorithm::DownsampledSeparable: {
+                // Gaussian's frequency response is exp(-2 * pi^2 * sigma^2 * f^2), evaluated at f = 1/4
+                double pi = glm::pi<double>();
+                double sigma = settings.sigma;
+                return float(std::exp(-2.0 * pi * pi * sigma * sigma / 16.0));
+            }
+        }
+        return std::numeric_limits<float>::max();
+    }
+
+#pragma mark - Lifecycle
+
+    GaussianBlurCostModel::GaussianBlurCostModel(const std::string &deviceIdentifier, const Size2D &resolution)
+            : mDeviceIdentifier(deviceIdentifier), mResolution(resolution) {}
+
+#pragma mark - Cost estimation
+
+    const std::string &GaussianBlurCostModel::deviceIdentifier() const {
+        return mDeviceIdentifier;
+    }
+
+    bool GaussianBlurCostModel::isCalibrated() const {
+        for (auto &measurements : mMilliseconds) {
+            if (measurements.empty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void GaussianBlurCostModel::setMeasurement(GaussianBlurAlgorithm algorithm, size_t radius, double milliseconds) {
+        mMilliseconds[AlgorithmIndex(algorithm)][radius] = milliseconds;
+    }
+
+    double GaussianBlurCostModel::fetchBasedCost(GaussianBlurAlgorithm algorithm, size_t radius) const {
+        double pixelCount = double(mResolution.width) * double(mResolution.height);
+
+        // Texture fetches per output pixel of a single 1D pass with bilinear tap pairing
+        auto passFetches = [](size_t r) {
+            return 2.0 * double((r + 1) / 2) + 1.0;
+        };
+
+        switch (algorithm) {
+            case GaussianBlurAlgorithm::Separable:
+                return pixelCount * 2.0 * passFetches(radius);
+            case GaussianBlurAlgorithm::DownsampledSeparable:
+                // Downsample and two blur passes at quarter pixel count, then full resolution upsample
+                return pixelCount * (0.25 * (1.0 + 2.0 * passFetches(radius / 2)) + 1.0);
+        }
+        return std::numeric_limits<double>::max();
+    }
+
+    double GaussianBlurCostModel::estimatedCost(GaussianBlurAlgorithm algorithm, size_t radius) const {
+        if (!isCalibrated()) {
+            return fetchBasedCost(algorithm, radius);
+        }
+
+        const auto &measurements = mMilliseconds[AlgorithmIndex(algorithm)];
+
+        auto upper = measurements.lower_bound(radius);
+        if (upper == measurements.end()) {
+            // Extrapolate linearly from the origin through the largest measured radius
+            auto last = std::prev(measurements.end());
+            return last->second * double(radius) / double(std::max(last->first, size_t(1)));
+        }
+
+        if (upper->first == radius || upper == measurements.begin()) {
+            return upper->second;
+        }
+
+        auto lower = std::prev(upper);
+        double t = double(radius - lower->first) / double(upper->first - lower->first);
+        return lower->second + (upper->second - lower->second) * t;
+    }
+
+    GaussianBlurAlgorithm GaussianBlurCostModel::cheapestAlgorithm(const GaussianBlurSettings &settings) const {
+        GaussianBlurAlgorithm cheapest = GaussianBlurAlgorithm::Separable;
+        double cheapestCost = std::numeric_limits<double>::max();
+        bool found = false;
+
+        for (GaussianBlurAlgorithm algorithm : AllAlgorithms()) {
+            if (!IsSupported(algorithm, settings) || EstimatedError(algorithm, settings) > settings.errorBudget) {
+                continue;
+            }
+
+            double cost = estimatedCost(algorithm, settings.radius);
+            if (cost < cheapestCost) {
+                cheapestCost = cost;
+                cheapest = algorithm;
+                found = true;
+            }
+        }
+
+        // Nothing meets the error budget, prefer a supported algorithm over failing
+        if (!found && !IsSupported(cheapest, settings)) {
+            cheapest = GaussianBlurAlgorithm::DownsampledSeparable;
+        }
+
+        return cheapest;
+    }
+
+#pragma mark - Persistence
+
+    bool GaussianBlurCostModel::load(const std::string &path) {
+        std::ifstream file(path);
+        if (!file) {
+            return false;
+        }
+
+        std::string line;
+        std::string deviceIdentifier;
+        Size2D resolution;
+        std::array<std::map<size_t, double>, AlgorithmCount> milliseconds;
+
+        while (std::getline(file, line)) {
+            std::istringstream stream(line);
+            std::string key;
+            stream >> key;
+
+            if (key == "device") {
+                std::getline(stream >> std::ws, deviceIdentifier);
+            } else if (key == "resolution") {
+                stream >> resolution.width >> resolution.height;
+            } else {
+                for (GaussianBlurAlgorithm algorithm : AllAlgorithms()) {
+                    if (key != AlgorithmName(algorithm)) {
+                        continue;
+                    }
+
+                    size_t radius = 0;
+                    double ms = 0.0;
+                    if (stream >> radius >> ms) {
+                        milliseconds[AlgorithmIndex(algorithm)][radius] = ms;
+                    }
+                }
+            }
+        }
+
+        if (deviceIdentifier != mDeviceIdentifier || resolution != mResolution) {
+            return false;
+        }
+
+        mMilliseconds = milliseconds;
+        return isCalibrated();
+    }
+
+    void GaussianBlurCostModel::save(const std::string &path) const {
+        std::ofstream file(path);
+        if (!file) {
+            throw std::runtime_error("Unable to write blur cost table to " + path);
+        }
+
+        file << "device " << mDeviceIdentifier << "\n";
+        file << "resolution " << mResolution.width << " " << mResolution.height << "\n";
+
+        for (GaussianBlurAlgorithm algorithm : AllAlgorithms()) {
+            for (auto &measurement : mMilliseconds[AlgorithmIndex(algorithm)]) {
+                file << AlgorithmName(algorithm) << " " << measurement.first << " " << measurement.second << "\n";
+            }
+        }
+    }
+
+}
@@ -0,0 +1,93 @@
+//
+//  GaussianBlurCostModel.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef GaussianBlurCostModel_hpp
+#define GaussianBlurCostModel_hpp
+
+#include "GaussianBlurSettings.hpp"
+
+#include <Size2D.hpp>
+
+#include <array>
+#include <map>
+#include <string>
+#include <cstdint>
+
+namespace Engine {
+
+    enum class GaussianBlurAlgorithm : uint8_t {
+        /// Two 1D passes at full resolution, bilinear fetches combine pairs of taps
+        Separable,
+        /// Image is downsampled by 2, blurred separably with halved kernel and upsampled back
+        DownsampledSeparable
+    };
+
+    /**
+     Estimates GPU time of blur algorithms for a given render target resolution.
+     Costs are either measured by calibration (see GaussianBlurEffect::beginCalibration) and persisted
+     per device and resolution, or, when not calibrated, approximated by texture fetch counts.
+     */
+    class GaussianBlurCostModel {
+    public:
+        static constexpr size_t AlgorithmCount = 2;
+
+        /// Kernel radii measured during calibration. Costs for other radii are interpolated.
+        static constexpr std::array<size_t, 6> CalibrationRadii{{2, 8, 16, 32, 64, 96}};
+
+        /// Blur shader holds up to 64 combined weights: center plus radius / 2 bilinear pairs
+        static constexpr size_t MaximumSeparableRadius = 126;
+
+    private:
+        std::string mDeviceIdentifier;
+        Size2D mResolution;
+        std::array<std::map<size_t, double>, AlgorithmCount> mMilliseconds;
+
+        static size_t AlgorithmIndex(GaussianBlurAlgorithm algorithm);
+
+        double fetchBasedCost(GaussianBlurAlgorithm algorithm, size_t radius) const;
+
+    public:
+        static const std::array<GaussianBlurAlgorithm, AlgorithmCount> &AllAlgorithms();
+
+        static const char *AlgorithmName(GaussianBlurAlgorithm algorithm);
+
+        static bool IsSupported(GaussianBlurAlgorithm algorithm, const GaussianBlurSettings &settings);
+
+        /**
+         Approximation error of an algorithm relative to the exact separable Gaussian.
+         Downsampling misrepresents frequencies above half of the Nyquist limit,
+         so the error is bounded by the Gaussian's frequency response at 1/4 cycles per pixel.
+
+         @return maximum expected per-channel error in normalized [0; 1] color units
+         */
+        static float EstimatedError(GaussianBlurAlgorithm algorithm, const GaussianBlurSettings &settings);
+
+        GaussianBlurCostModel(const std::string &deviceIdentifier, const Size2D &resolution);
+
+        const std::string &deviceIdentifier() const;
+
+        bool isCalibrated() const;
+
+        void setMeasurement(GaussianBlurAlgorithm algorithm, size_t radius, double milliseconds);
+
+        /// @return measured (interpolated) milliseconds, or fetch-based relative cost when not calibrated
+        double estimatedCost(GaussianBlurAlgorithm algorithm, size_t radius) const;
+
+        /// @return cheapest supported algorithm whose estimated error fits into settings.errorBudget
+        GaussianBlurAlgorithm cheapestAlgorithm(const GaussianBlurSettings &settings) const;
+
+        /// Loads measurements from a cost table file
+        /// @return false if the file is missing or was produced on a different device or resolution
+        bool load(const std::string &path);
+
+        void save(const std::string &path) const;
+    };
+
+}
+
+#endif /* GaussianBlurCostModel_hpp */
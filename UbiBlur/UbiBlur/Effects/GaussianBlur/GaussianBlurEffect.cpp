@@ -10,21 +10,46 @@
 #include "GaussianFunction.hpp"
 #include "Drawable.hpp"
 #include "GLTexture2D.hpp"
+#include "StringUtils.hpp"
 
 #include <stdexcept>
+#include <algorithm>
+#include <cmath>
 
 namespace Engine {
 
+	static Size2D DownsampledSize(const Size2D &size) {
+		return Size2D(std::max(std::floor(size.width / 2.f), 1.f), std::max(std::floor(size.height / 2.f), 1.f));
+	}
+
+	static std::string DeviceIdentifier() {
+		const GLubyte *renderer = glGetString(GL_RENDERER);
+		const GLubyte *version = glGetString(GL_VERSION);
+		std::string identifier = renderer ? reinterpret_cast<const char *>(renderer) : "Unknown renderer";
+		identifier += " | ";
+		identifier += version ? reinterpret_cast<const char *>(version) : "Unknown version";
+		return identifier;
+	}
+
 	GaussianBlurEffect::GaussianBlurEffect(const filesystem::path &resourceRoot, const Size2D &rtSize)
-		: mHalfBlurShader(resourceRoot.str() + "\\Shaders\\HalfScreenQuad.vert", resourceRoot.str() + "\\Shaders\\GaussianBlur.frag", ""),
-		mFullBlurShader(resourceRoot.str() + "\\Shaders\\FullScreenQuad.vert", resourceRoot.str() + "\\Shaders\\GaussianBlur.frag", ""),
-		mHalfQuadShader(resourceRoot.str() + "\\Shaders\\HalfScreenQuad.vert", resourceRoot.str() + "\\Shaders\\Empty.frag", ""),
+		: mHalfBlurShader((resourceRoot / "Shaders/HalfScreenQuad.vert").str(), (resourceRoot / "Shaders/GaussianBlur.frag").str(), ""),
+		mFullBlurShader((resourceRoot / "Shaders/FullScreenQuad.vert").str(), (resourceRoot / "Shaders/GaussianBlur.frag").str(), ""),
+		mHalfQuadShader((resourceRoot / "Shaders/HalfScreenQuad.vert").str(), (resourceRoot / "Shaders/Empty.frag").str(), ""),
+		mFullResampleShader((resourceRoot / "Shaders/FullScreenQuad.vert").str(), (resourceRoot / "Shaders/Resample.frag").str(), ""),
+		mHalfResampleShader((resourceRoot / "Shaders/HalfScreenQuad.vert").str(), (resourceRoot / "Shaders/Resample.frag").str(), ""),
 		mFramebuffer(rtSize),
 		mDepthStencilRenderbuffer(rtSize),
-		mIntermediateImage(rtSize) {
+		mIntermediateImage(rtSize),
+		mDownsampledFramebuffer(DownsampledSize(rtSize)),
+		mDownsampledImage(DownsampledSize(rtSize)),
+		mDownsampledIntermediateFramebuffer(DownsampledSize(rtSize)),
+		mDownsampledIntermediateImage(DownsampledSize(rtSize)),
+		mCostModel(DeviceIdentifier(), rtSize) {
 	
 		mFramebuffer.attachRenderbuffer(mDepthStencilRenderbuffer);
 		mFramebuffer.attachTexture(mIntermediateImage);
+		mDownsampledFramebuffer.attachTexture(mDownsampledImage);
+		mDownsampledIntermediateFramebuffer.attachTexture(mDownsampledIntermediateImage);
 	}
 
     void GaussianBlurEffect::computeWeightsAndOffsetsIfNeeded(const GaussianBlurSettings& settings) {
@@ -32,11 +57,17 @@ namespace Engine {
             return;
         }
 
+        mSettings = settings;
+
         bool isOdd = settings.radius % 2 == 1;
-        mSettings.radius = isOdd ? settings.radius + 1 : settings.radius; 
-        mSettings.sigma = settings.sigma;
+        size_t radius = isOdd ? settings.radius + 1 : settings.radius;
+
+        auto weights = GaussianFunction::Produce1DKernel(radius, settings.sigma, settings.truncationEpsilon);
 
-        auto weights = GaussianFunction::Produce1DKernel(mSettings.radius, mSettings.sigma);
+        // Truncation may leave an odd amount of side taps, pad with zero weight to keep taps paired
+        if (weights.size() % 2 == 0) {
+            weights.push_back(0.0);
+        }
 
         mWeights.clear();
         mTextureOffsets.clear();
@@ -46,7 +77,7 @@ namespace Engine {
         mTextureOffsets.push_back(0.0);
 
         // Calculate texture offsets and combined weights to make advantage of hardware interpolation
-        for (size_t i = 1; i <= mSettings.radius; i += 2) {
+        for (size_t i = 1; i < weights.size(); i += 2) {
             float weight1 = weights[i];
             float weight2 = weights[i + 1];
             float totalWeight = weight1 + weight2;
@@ -69,42 +100,111 @@ namespace Engine {
 		Drawable::TriangleStripQuad::Draw();
 	}
 
-	void GaussianBlurEffect::blur(
-		GLNormalizedTexture2D<GLTexture::Normalized::RGBA> &image,
-		GLFramebuffer &framebuffer,
-		GLProgram &blurShader,
-		const GaussianBlurSettings &settings
-	)
-	{
-		if (settings.radius == 0) throw std::invalid_argument("Blur radius must be greater than 0");
+	void GaussianBlurEffect::produceStencilMaskIfNeeded(GLFramebuffer &fbo) {
+		if (fbo.stencilContents() == mStencilMaskID) {
+			return;
+		}
 
-		computeWeightsAndOffsetsIfNeeded(settings);
+		produceStencilMask(fbo);
+		fbo.setStencilContents(mStencilMaskID);
+	}
 
+	void GaussianBlurEffect::applyKernelUniforms(GLProgram &blurShader, const Size2D &imageSize) {
 		blurShader.bind();
-		blurShader.setUniformVector(ctcrc32("uRenderTargetSize"), glm::vec2(image.size().width, image.size().height));
+		blurShader.setUniformVector(ctcrc32("uRenderTargetSize"), glm::vec2(imageSize.width, imageSize.height));
 		blurShader.setUniformFloatArray(ctcrc32("uKernelWeights[0]"), mWeights.data(), mWeights.size());
 		blurShader.setUniformFloatArray(ctcrc32("uTextureOffsets[0]"), mTextureOffsets.data(), mTextureOffsets.size());
 		blurShader.setUniformInteger(ctcrc32("uKernelSize"), mTextureOffsets.size());
+	}
 
-		// Set horizontal direction
-		blurShader.setUniformVector(ctcrc32("uBlurDirection"), glm::vec2(1.0, 0.0));
+	void GaussianBlurEffect::drawBlurPass(GLProgram &blurShader, const GLTexture &source, GLFramebuffer &target, const glm::vec2 &direction) {
+		blurShader.setUniformVector(ctcrc32("uBlurDirection"), direction);
 		blurShader.ensureSamplerValidity([&]() {
-			blurShader.setUniformTexture(ctcrc32("uTexture"), image);
+			blurShader.setUniformTexture(ctcrc32("uTexture"), source);
 		});
 
-		mFramebuffer.bind();
+		target.bind();
 		Drawable::TriangleStripQuad::Draw();
+	}
 
-		// Set vertical direction
-		blurShader.setUniformVector(ctcrc32("uBlurDirection"), glm::vec2(0.0, 1.0));
-		blurShader.ensureSamplerValidity([&]() {
-			blurShader.setUniformTexture(ctcrc32("uTexture"), mIntermediateImage);
+	void GaussianBlurEffect::drawResamplePass(GLProgram &resampleShader, const GLTexture &source, GLFramebuffer &target) {
+		resampleShader.bind();
+		resampleShader.ensureSamplerValidity([&]() {
+			resampleShader.setUniformTexture(ctcrc32("uImage"), source);
 		});
 
-		framebuffer.bind();
+		target.bind();
 		Drawable::TriangleStripQuad::Draw();
 	}
 
+	void GaussianBlurEffect::blurSeparable(
+		GLNormalizedTexture2D<GLTexture::Normalized::RGBA> &image,
+		GLFramebuffer &framebuffer,
+		GLProgram &blurShader,
+		const GaussianBlurSettings &settings
+	)
+	{
+		computeWeightsAndOffsetsIfNeeded(settings);
+		applyKernelUniforms(blurShader, image.size());
+
+		drawBlurPass(blurShader, image, mFramebuffer, glm::vec2(1.0, 0.0));
+		drawBlurPass(blurShader, mIntermediateImage, framebuffer, glm::vec2(0.0, 1.0));
+	}
+
+	void GaussianBlurEffect::blurDownsampled(
+		GLNormalizedTexture2D<GLTexture::Normalized::RGBA> &image,
+		GLFramebuffer &framebuffer,
+		GLProgram &upsampleShader,
+		const GaussianBlurSettings &settings
+	)
+	{
+		// Kernel is halved along with the image
+		GaussianBlurSettings downsampledSettings = settings;
+		downsampledSettings.radius = std::max(settings.radius / 2, size_t(1));
+		downsampledSettings.sigma = settings.sigma / 2.f;
+
+		computeWeightsAndOffsetsIfNeeded(downsampledSettings);
+
+		// Whole image is blurred at low resolution, masking is applied by the upsampling pass only
+		mDownsampledFramebuffer.viewport().apply();
+		drawResamplePass(mFullResampleShader, image, mDownsampledFramebuffer);
+
+		applyKernelUniforms(mFullBlurShader, mDownsampledImage.size());
+		drawBlurPass(mFullBlurShader, mDownsampledImage, mDownsampledIntermediateFramebuffer, glm::vec2(1.0, 0.0));
+		drawBlurPass(mFullBlurShader, mDownsampledIntermediateImage, mDownsampledFramebuffer, glm::vec2(0.0, 1.0));
+
+		framebuffer.viewport().apply();
+		drawResamplePass(upsampleShader, mDownsampledImage, framebuffer);
+	}
+
+	void GaussianBlurEffect::blur(
+		GaussianBlurAlgorithm algorithm,
+		GLNormalizedTexture2D<GLTexture::Normalized::RGBA> &image,
+		GLFramebuffer &framebuffer,
+		GLProgram &blurShader,
+		GLProgram &upsampleShader,
+		const GaussianBlurSettings &settings
+	)
+	{
+		if (settings.radius == 0) throw std::invalid_argument("Blur radius must be greater than 0");
+
+		if (!GaussianBlurCostModel::IsSupported(algorithm, settings)) {
+			throw std::invalid_argument(string_format("Blur radius %zu is not supported by %s algorithm", settings.radius, GaussianBlurCostModel::AlgorithmName(algorithm)));
+		}
+
+		// Context's default viewport may not cover the target, e.g. when rendering without a window
+		framebuffer.viewport().apply();
+
+		switch (algorithm) {
+		case GaussianBlurAlgorithm::Separable:
+			blurSeparable(image, framebuffer, blurShader, settings);
+			break;
+		case GaussianBlurAlgorithm::DownsampledSeparable:
+			blurDownsampled(image, framebuffer, upsampleShader, settings);
+			break;
+		}
+	}
+
 	void GaussianBlurEffect::blurWithStencilMask(
 		GLNormalizedTexture2D<GLTexture::Normalized::RGBA> &image,
 		GLFramebuffer &framebuffer,
@@ -113,14 +213,14 @@ namespace Engine {
 	{
 		glDisable(GL_DEPTH_TEST);
 		glEnable(GL_STENCIL_TEST);
-		produceStencilMask(mFramebuffer);
-		produceStencilMask(framebuffer);
+		produceStencilMaskIfNeeded(mFramebuffer);
+		produceStencilMaskIfNeeded(framebuffer);
 
 		// Only render pixels with a stencil value of 1
 		glStencilFunc(GL_EQUAL, 1, 1);
 		glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 
-		blur(image, framebuffer, mFullBlurShader, settings);
+		blur(selectAlgorithm(settings), image, framebuffer, mFullBlurShader, mFullResampleShader, settings);
 
 		glDisable(GL_STENCIL_TEST);
 		glEnable(GL_DEPTH_TEST);
@@ -133,8 +233,113 @@ namespace Engine {
 	) 
 	{
 		glDisable(GL_DEPTH_TEST);
-		blur(image, framebuffer, mHalfBlurShader, settings);
+		blur(selectAlgorithm(settings), image, framebuffer, mHalfBlurShader, mHalfResampleShader, settings);
 		glEnable(GL_DEPTH_TEST);
 	}
 
+	void GaussianBlurEffect::blurWithoutMask(
+		GLNormalizedTexture2D<GLTexture::Normalized::RGBA> &image,
+		GLFramebuffer &framebuffer,
+		const GaussianBlurSettings &settings
+	)
+	{
+		glDisable(GL_DEPTH_TEST);
+		blur(selectAlgorithm(settings), image, framebuffer, mFullBlurShader, mFullResampleShader, settings);
+		glEnable(GL_DEPTH_TEST);
+	}
+
+	void GaussianBlurEffect::invalidateStencilMask(GLFramebuffer &framebuffer) {
+		framebuffer.setStencilContents(0);
+	}
+
+	void GaussianBlurEffect::invalidateAllStencilMasks() {
+		// Masks written under the previous identifier no longer match
+		mStencilMaskID = GLFramebuffer::MakeStencilContentsID();
+	}
+
+	GaussianBlurEffect::PendingCalibration::PendingCalibration(const std::string &costTablePath, const GaussianBlurCostModel &costModel, const Size2D &size)
+		: costTablePath(costTablePath),
+		costModel(costModel),
+		source(size),
+		destination(size),
+		destinationFramebuffer(size) {
+
+		destinationFramebuffer.attachTexture(destination);
+
+		for (GaussianBlurAlgorithm algorithm : GaussianBlurCostModel::AllAlgorithms()) {
+			for (size_t radius : GaussianBlurCostModel::CalibrationRadii) {
+				if (GaussianBlurCostModel::IsSupported(algorithm, { radius, radius / 2.f })) {
+					measurements.emplace_back(algorithm, radius);
+				}
+			}
+		}
+	}
+
+	void GaussianBlurEffect::beginCalibration(const std::string &costTablePath) {
+		mCalibration = nullptr;
+
+		if (!mCostModel.load(costTablePath)) {
+			mCalibration = std::make_unique<PendingCalibration>(costTablePath, mCostModel, mFramebuffer.size());
+		}
+	}
+
+	void GaussianBlurEffect::continueCalibration() {
+		if (!mCalibration) {
+			return;
+		}
+
+		constexpr size_t IterationCount = 8;
+
+		PendingCalibration &calibration = *mCalibration;
+
+		if (calibration.isQueryIssued) {
+			if (!calibration.query.isResultAvailable()) {
+				return;
+			}
+
+			auto &measurement = calibration.measurements[calibration.measurementIndex];
+			calibration.costModel.setMeasurement(measurement.first, measurement.second, calibration.query.elapsedMilliseconds() / IterationCount);
+			calibration.isQueryIssued = false;
+			calibration.measurementIndex++;
+		}
+
+		if (calibration.measurementIndex == calibration.measurements.size()) {
+			mCostModel = calibration.costModel;
+			mCostModel.save(calibration.costTablePath);
+			mCalibration = nullptr;
+			return;
+		}
+
+		auto &measurement = calibration.measurements[calibration.measurementIndex];
+		GaussianBlurSettings settings{ measurement.second, measurement.second / 2.f };
+
+		GLboolean depthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
+		glDisable(GL_DEPTH_TEST);
+		calibration.destinationFramebuffer.viewport().apply();
+
+		// Warm up to exclude kernel computation and driver's lazy state validation
+		blur(measurement.first, calibration.source, calibration.destinationFramebuffer, mFullBlurShader, mFullResampleShader, settings);
+
+		calibration.query.begin();
+		for (size_t i = 0; i < IterationCount; i++) {
+			blur(measurement.first, calibration.source, calibration.destinationFramebuffer, mFullBlurShader, mFullResampleShader, settings);
+		}
+		calibration.query.end();
+		calibration.isQueryIssued = true;
+
+		if (depthTestEnabled) glEnable(GL_DEPTH_TEST);
+	}
+
+	bool GaussianBlurEffect::isCalibrating() const {
+		return mCalibration != nullptr;
+	}
+
+	const GaussianBlurCostModel &GaussianBlurEffect::costModel() const {
+		return mCostModel;
+	}
+
+	GaussianBlurAlgorithm GaussianBlurEffect::selectAlgorithm(const GaussianBlurSettings &settings) const {
+		return mCostModel.cheapestAlgorithm(settings);
+	}
+
 }
@@ -15,11 +15,15 @@
 #include <filesystem/path.h>
 #include <GLFramebuffer.hpp>
 #include <GLDepthStencilRenderbuffer.hpp>
+#include <GLTimerQuery.hpp>
 
 #include "GaussianBlurSettings.hpp"
+#include "GaussianBlurCostModel.hpp"
 
 #include <memory>
 #include <vector>
+#include <string>
+#include <utility>
 
 namespace Engine {
 
@@ -28,21 +32,74 @@ namespace Engine {
 		GLProgram mHalfBlurShader;
 		GLProgram mFullBlurShader;
 		GLProgram mHalfQuadShader;
+		GLProgram mFullResampleShader;
+		GLProgram mHalfResampleShader;
 		GLFramebuffer mFramebuffer;
 		GLDepthStencilRenderbuffer mDepthStencilRenderbuffer;
 		GLNormalizedTexture2D<GLTexture::Normalized::RGBA> mIntermediateImage;
+		GLFramebuffer mDownsampledFramebuffer;
+		GLNormalizedTexture2D<GLTexture::Normalized::RGBA> mDownsampledImage;
+		GLFramebuffer mDownsampledIntermediateFramebuffer;
+		GLNormalizedTexture2D<GLTexture::Normalized::RGBA> mDownsampledIntermediateImage;
+		GaussianBlurCostModel mCostModel;
         std::vector<float> mWeights;
         std::vector<float> mTextureOffsets;
         GaussianBlurSettings mSettings;
 
+		/// Measurements left to take, spread over several calls to continueCalibration()
+		struct PendingCalibration {
+			std::string costTablePath;
+			/// Replaces the effect's model once complete, partial measurements aren't comparable
+			GaussianBlurCostModel costModel;
+			std::vector<std::pair<GaussianBlurAlgorithm, size_t>> measurements;
+			size_t measurementIndex = 0;
+			bool isQueryIssued = false;
+			GLTimerQuery query;
+			/// Texture contents don't affect timings, only resolution does
+			GLNormalizedTexture2D<GLTexture::Normalized::RGBA> source;
+			GLNormalizedTexture2D<GLTexture::Normalized::RGBA> destination;
+			GLFramebuffer destinationFramebuffer;
+
+			PendingCalibration(const std::string &costTablePath, const GaussianBlurCostModel &costModel, const Size2D &size);
+		};
+
+		std::unique_ptr<PendingCalibration> mCalibration;
+
+		/// Stencil contents identifier of framebuffers that already contain the blur mask
+		uint64_t mStencilMaskID = GLFramebuffer::MakeStencilContentsID();
+
         void computeWeightsAndOffsetsIfNeeded(const GaussianBlurSettings &settings);
 
 		void produceStencilMask(GLFramebuffer &fbo);
 
+		void produceStencilMaskIfNeeded(GLFramebuffer &fbo);
+
+		void applyKernelUniforms(GLProgram &blurShader, const Size2D &imageSize);
+
+		void drawBlurPass(GLProgram &blurShader, const GLTexture &source, GLFramebuffer &target, const glm::vec2 &direction);
+
+		void drawResamplePass(GLProgram &resampleShader, const GLTexture &source, GLFramebuffer &target);
+
+		void blurSeparable(
+			GLNormalizedTexture2D<GLTexture::Normalized::RGBA> &image,
+			GLFramebuffer &framebuffer,
+			GLProgram &blurShader,
+			const GaussianBlurSettings &settings
+		);
+
+		void blurDownsampled(
+			GLNormalizedTexture2D<GLTexture::Normalized::RGBA> &image,
+			GLFramebuffer &framebuffer,
+			GLProgram &upsampleShader,
+			const GaussianBlurSettings &settings
+		);
+
 		void blur(
+			GaussianBlurAlgorithm algorithm,
 			GLNormalizedTexture2D<GLTexture::Normalized::RGBA> &image,
 			GLFramebuffer &framebuffer,
 			GLProgram &blurShader,
+			GLProgram &upsampleShader,
 			const GaussianBlurSettings &settings
 		);
 
@@ -60,6 +117,48 @@ namespace Engine {
 			GLFramebuffer &framebuffer,
 			const GaussianBlurSettings &settings
 		);
+
+		/// Blurs the whole image without masking, image and framebuffer must match the effect's resolution
+		void blurWithoutMask(
+			GLNormalizedTexture2D<GLTexture::Normalized::RGBA> &image,
+			GLFramebuffer &framebuffer,
+			const GaussianBlurSettings &settings
+		);
+
+		/**
+		 Stencil masks are produced once per framebuffer and reused by subsequent blurWithStencilMask() calls.
+		 Clears and attachment changes made through GLFramebuffer are noticed automatically,
+		 call this when the stencil buffer was overwritten by raw GL calls.
+
+		 @param framebuffer framebuffer whose stencil mask should be regenerated on next use
+		 */
+		void invalidateStencilMask(GLFramebuffer &framebuffer);
+
+		void invalidateAllStencilMasks();
+
+		/**
+		 Loads measurements from the cost table file if it holds them for the current device and resolution,
+		 otherwise schedules calibration performed by continueCalibration().
+		 Until calibration completes algorithms are ranked by texture fetch counts.
+
+		 @param costTablePath location of the persisted cost table, its directory has to be writable
+		 */
+		void beginCalibration(const std::string &costTablePath);
+
+		/**
+		 Collects the previous GPU timer query if its result is ready and issues the next one,
+		 so calibration is spread over frames and never waits for the GPU.
+		 The cost table is saved once every algorithm has been measured.
+		 Changes framebuffer binding and viewport, call it outside of a render pass.
+		 */
+		void continueCalibration();
+
+		bool isCalibrating() const;
+
+		const GaussianBlurCostModel &costModel() const;
+
+		/// @return cheapest algorithm satisfying error budget of the settings
+		GaussianBlurAlgorithm selectAlgorithm(const GaussianBlurSettings &settings) const;
 	};
 
 }
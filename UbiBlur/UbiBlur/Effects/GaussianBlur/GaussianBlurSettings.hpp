@@ -10,6 +10,7 @@
 #define GaussianBlurSettings_hpp
 
 #include <stdio.h>
+#include <cmath>
 
 namespace Engine {
 
@@ -17,8 +18,19 @@ namespace Engine {
         size_t radius = 2;
         float sigma = 2;
 
+        /// Maximum kernel weight allowed to be trimmed from the tails, 0 disables truncation.
+        /// GaussianFunction::LDRTruncationEpsilon keeps both passes within half a step of an 8-bit target.
+        float truncationEpsilon = 0;
+
+        /// Maximum per-channel error in normalized color units that an approximate
+        /// blur algorithm may introduce. 0 allows only exact algorithms.
+        float errorBudget = 0;
+
         bool operator==(const GaussianBlurSettings &rhs) const {
-            return this->radius == rhs.radius && std::fabs(this->sigma - rhs.sigma) < 0.001;
+            return this->radius == rhs.radius &&
+                    std::fabs(this->sigma - rhs.sigma) < 0.001 &&
+                    this->truncationEpsilon == rhs.truncationEpsilon &&
+                    this->errorBudget == rhs.errorBudget;
         }
 
         bool operator!=(const GaussianBlurSettings &rhs) const {
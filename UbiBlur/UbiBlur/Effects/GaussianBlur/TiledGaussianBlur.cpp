@@ -0,0 +1,211 @@
+//
+//  TiledGaussianBlur.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "TiledGaussianBlur.hpp"
+#include "StringUtils.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <chrono>
+
+namespace Engine {
+
+    constexpr size_t TiledGaussianBlur::DefaultTileSize;
+
+    namespace {
+        constexpr size_t BytesPerPixel = 4;
+
+        /// Downsampled algorithm reaches a couple of pixels further than the kernel radius
+        /// because of bilinear down and upsampling
+        constexpr size_t ResamplingMargin = 2;
+    }
+
+#pragma mark - Lifecycle
+
+    TiledGaussianBlur::TiledGaussianBlur(const filesystem::path &resourceRoot, size_t tileSize)
+            :
+            mTileSize(ResolveTileSize(tileSize)),
+            mEffect(resourceRoot, Size2D(mTileSize)),
+            mSourceTile(Size2D(mTileSize)),
+            mDestinationTile(Size2D(mTileSize)),
+            mFramebuffer(Size2D(mTileSize)),
+            mReadbackRing(2),
+            mTilePixels(mTileSize * mTileSize * BytesPerPixel) {
+
+        mFramebuffer.attachTexture(mDestinationTile);
+    }
+
+#pragma mark - Static
+
+    size_t TiledGaussianBlur::MaximumTileSize() {
+        GLint maxTextureSize = 0;
+        GLint maxViewportDimensions[2] = { 0, 0 };
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+        glGetIntegerv(GL_MAX_VIEWPORT_DIMS, maxViewportDimensions);
+        return size_t(std::min({ maxTextureSize, maxViewportDimensions[0], maxViewportDimensions[1] }));
+    }
+
+    size_t TiledGaussianBlur::Overlap(const GaussianBlurSettings &settings) {
+        size_t overlap = settings.radius + ResamplingMargin;
+        // Keeps tile origins on even pixels so that downsampled grids of neighbouring tiles line up
+        return overlap + overlap % 2;
+    }
+
+    size_t TiledGaussianBlur::ResolveTileSize(size_t requestedTileSize) {
+        size_t maximumTileSize = MaximumTileSize();
+        size_t tileSize = requestedTileSize == 0 ? std::min(DefaultTileSize, maximumTileSize) : requestedTileSize;
+
+        if (tileSize > maximumTileSize) {
+            throw std::invalid_argument(string_format("Tile size %zu exceeds maximum texture size %zu", tileSize, maximumTileSize));
+        }
+
+        return tileSize - tileSize % 2;
+    }
+
+#pragma mark - Getters
+
+    size_t TiledGaussianBlur::tileSize() const {
+        return mTileSize;
+    }
+
+#pragma mark - Blur
+
+    void TiledGaussianBlur::advanceBand(InputBand &band, size_t firstRow, size_t lastRow, size_t width, const RowReader &reader) {
+        size_t rowBytes = width * BytesPerPixel;
+        size_t loadedEnd = band.firstRow + band.rowCount;
+
+        // Bands overlap by the kernel apron, shared rows move to the front instead of being read again
+        size_t keptRows = loadedEnd > firstRow ? loadedEnd - firstRow : 0;
+        if (keptRows > 0) {
+            std::memmove(band.pixels.data(), &band.pixels[(firstRow - band.firstRow) * rowBytes], keptRows * rowBytes);
+        }
+
+        band.firstRow = firstRow;
+        band.rowCount = lastRow - firstRow;
+
+        for (size_t y = firstRow + keptRows; y < lastRow; y++) {
+            reader(y, &band.pixels[(y - firstRow) * rowBytes]);
+        }
+    }
+
+    void TiledGaussianBlur::fillTile(int64_t originX, int64_t originY, size_t width, size_t height, const InputBand &band) {
+        // Area outside of the image replicates edge pixels, exactly like clamp-to-edge sampling
+        // does for an image that fits into a single texture
+        int64_t firstColumn = std::max(originX, int64_t(0));
+        int64_t lastColumn = std::min(originX + int64_t(mTileSize), int64_t(width));
+
+        size_t leftPadding = size_t(firstColumn - originX);
+        size_t spanLength = size_t(lastColumn - firstColumn);
+        size_t rightPadding = mTileSize - leftPadding - spanLength;
+        size_t tileRowBytes = mTileSize * BytesPerPixel;
+        size_t imageRowBytes = width * BytesPerPixel;
+
+        for (size_t y = 0; y < mTileSize; y++) {
+            int64_t imageRow = std::min(std::max(originY + int64_t(y), int64_t(0)), int64_t(height) - 1);
+            const uint8_t *source = &band.pixels[(size_t(imageRow) - band.firstRow) * imageRowBytes + size_t(firstColumn) * BytesPerPixel];
+
+            uint8_t *row = &mTilePixels[y * tileRowBytes];
+            uint8_t *span = row + leftPadding * BytesPerPixel;
+            std::memcpy(span, source, spanLength * BytesPerPixel);
+
+            for (size_t x = 0; x < leftPadding; x++) {
+                std::memcpy(row + x * BytesPerPixel, span, BytesPerPixel);
+            }
+
+            const uint8_t *lastPixel = span + (spanLength - 1) * BytesPerPixel;
+            for (size_t x = mTileSize - rightPadding; x < mTileSize; x++) {
+                std::memcpy(row + x * BytesPerPixel, lastPixel, BytesPerPixel);
+            }
+        }
+    }
+
+    void TiledGaussianBlur::blur(size_t width, size_t height, const GaussianBlurSettings &settings, const RowReader &reader, const RowWriter &writer) {
+        if (width == 0 || height == 0) {
+            throw std::invalid_argument("Image size must not be zero");
+        }
+
+        size_t overlap = Overlap(settings);
+        if (overlap * 2 >= mTileSize) {
+            throw std::invalid_argument(string_format("Blur radius %zu is too large for %zu pixel tiles", settings.radius, mTileSize));
+        }
+
+        size_t step = mTileSize - overlap * 2;
+        size_t rowBytes = width * BytesPerPixel;
+
+        InputBand inputBand;
+        inputBand.pixels.resize(std::min(mTileSize, height) * rowBytes);
+        std::vector<uint8_t> outputBand(std::min(step, height) * rowBytes);
+        std::deque<PendingTile> pendingTiles;
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        for (size_t bandY = 0; bandY < height; bandY += step) {
+            size_t outputHeight = std::min(step, height - bandY);
+            size_t firstRow = bandY > overlap ? bandY - overlap : 0;
+            size_t lastRow = std::min(bandY + step + overlap, height);
+            advanceBand(inputBand, firstRow, lastRow, width, reader);
+
+            for (size_t tileX = 0; tileX < width; tileX += step) {
+                size_t outputWidth = std::min(step, width - tileX);
+
+                fillTile(int64_t(tileX) - int64_t(overlap), int64_t(bandY) - int64_t(overlap), width, height, inputBand);
+                mSourceTile.upload(mTilePixels.data());
+                mEffect.blurWithoutMask(mSourceTile, mFramebuffer, settings);
+
+                // Only the inner part of the tile has a complete neighbourhood
+                Rect2D innerRegion(glm::vec2(overlap), Size2D(outputWidth, outputHeight));
+
+                PendingTile tile;
+                tile.x = tileX;
+                tile.result = mReadbackRing.readAsync(mFramebuffer, mDestinationTile, innerRegion);
+                pendingTiles.push_back(std::move(tile));
+
+                mReadbackRing.poll();
+                writeFinishedTiles(pendingTiles, width, outputBand);
+            }
+
+            // Rows can only be handed out once every tile of the band has been read back
+            mReadbackRing.finish();
+            writeFinishedTiles(pendingTiles, width, outputBand);
+
+            for (size_t y = 0; y < outputHeight; y++) {
+                writer(bandY + y, &outputBand[y * rowBytes]);
+            }
+        }
+    }
+
+    void TiledGaussianBlur::writeFinishedTiles(std::deque<PendingTile> &pendingTiles, size_t width, std::vector<uint8_t> &outputBand) {
+        while (!pendingTiles.empty() && pendingTiles.front().result.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            PendingTile &tile = pendingTiles.front();
+            GLReadbackRing::Result result = tile.result.get();
+
+            size_t tileRowBytes = result.width * BytesPerPixel;
+            for (size_t y = 0; y < result.height; y++) {
+                std::memcpy(&outputBand[(y * width + tile.x) * BytesPerPixel], &result.pixels[y * tileRowBytes], tileRowBytes);
+            }
+
+            pendingTiles.pop_front();
+        }
+    }
+
+    void TiledGaussianBlur::blur(const uint8_t *pixels, uint8_t *output, size_t width, size_t height, const GaussianBlurSettings &settings) {
+        size_t rowBytes = width * BytesPerPixel;
+
+        auto reader = [&](size_t y, uint8_t *destination) {
+            std::memcpy(destination, pixels + y * rowBytes, rowBytes);
+        };
+
+        auto writer = [&](size_t y, const uint8_t *source) {
+            std::memcpy(output + y * rowBytes, source, rowBytes);
+        };
+
+        blur(width, height, settings, reader, writer);
+    }
+
+}
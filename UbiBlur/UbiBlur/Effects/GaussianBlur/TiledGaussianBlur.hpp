@@ -0,0 +1,102 @@
+//
+//  TiledGaussianBlur.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef TiledGaussianBlur_hpp
+#define TiledGaussianBlur_hpp
+
+#include "GaussianBlurEffect.hpp"
+#include "GaussianBlurSettings.hpp"
+
+#include <GLTexture2D.hpp>
+#include <GLFramebuffer.hpp>
+#include <GLReadbackRing.hpp>
+#include <filesystem/path.h>
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <future>
+#include <cstdint>
+
+namespace Engine {
+
+    /**
+     Blurs RGBA8 images of arbitrary size, including ones exceeding GL_MAX_TEXTURE_SIZE.
+     The image is processed in square tiles that overlap by the kernel footprint, so that each output
+     pixel sees exactly the same neighbourhood as in a single pass blur and tiles stitch seamlessly.
+     GPU memory is limited to a couple of tile sized textures and the image itself is never
+     fully resident on the GPU. Readback of a finished tile overlaps with blurring of the next one.
+     Tiles are processed in horizontal bands. Rows are pulled and pushed strictly top to bottom
+     through callbacks and only the current band with its kernel apron and one band of output
+     are kept in CPU memory, so the caller may decode and encode the image while it is blurred.
+     */
+    class TiledGaussianBlur {
+    public:
+        /// Copies all RGBA pixels of row y into pixels. Rows are requested once each, in increasing order.
+        using RowReader = std::function<void(size_t y, uint8_t *pixels)>;
+
+        /// Receives all blurred RGBA pixels of row y. Rows arrive once each, in increasing order.
+        using RowWriter = std::function<void(size_t y, const uint8_t *pixels)>;
+
+        /// Tile size used when none is requested explicitly, unless the device limits are lower
+        static constexpr size_t DefaultTileSize = 2048;
+
+    private:
+        struct PendingTile {
+            size_t x = 0;
+            std::future<GLReadbackRing::Result> result;
+        };
+
+        /// Image rows needed by one band of tiles, rows beyond image edges are not stored
+        struct InputBand {
+            std::vector<uint8_t> pixels;
+            size_t firstRow = 0;
+            size_t rowCount = 0;
+        };
+
+        size_t mTileSize;
+        GaussianBlurEffect mEffect;
+        GLNormalizedTexture2D<GLTexture::Normalized::RGBA> mSourceTile;
+        GLNormalizedTexture2D<GLTexture::Normalized::RGBA> mDestinationTile;
+        GLFramebuffer mFramebuffer;
+        GLReadbackRing mReadbackRing;
+        std::vector<uint8_t> mTilePixels;
+
+        static size_t ResolveTileSize(size_t requestedTileSize);
+
+        /// Moves the band down to start at firstRow, keeping rows shared with the previous band
+        void advanceBand(InputBand &band, size_t firstRow, size_t lastRow, size_t width, const RowReader &reader);
+
+        void fillTile(int64_t originX, int64_t originY, size_t width, size_t height, const InputBand &band);
+
+        void writeFinishedTiles(std::deque<PendingTile> &pendingTiles, size_t width, std::vector<uint8_t> &outputBand);
+
+    public:
+        /// Largest square texture the device can both sample and render into
+        static size_t MaximumTileSize();
+
+        /// Number of pixels each tile has to extend beyond its output area
+        static size_t Overlap(const GaussianBlurSettings &settings);
+
+        /**
+         @param resourceRoot directory containing blur shaders
+         @param tileSize edge length of tiles in pixels, 0 picks DefaultTileSize clamped to device limits
+         */
+        TiledGaussianBlur(const filesystem::path &resourceRoot, size_t tileSize = 0);
+
+        size_t tileSize() const;
+
+        void blur(size_t width, size_t height, const GaussianBlurSettings &settings, const RowReader &reader, const RowWriter &writer);
+
+        /// Blurs tightly packed top-down RGBA pixels, input and output must not overlap
+        void blur(const uint8_t *pixels, uint8_t *output, size_t width, size_t height, const GaussianBlurSettings &settings);
+    };
+
+}
+
+#endif /* TiledGaussianBlur_hpp */
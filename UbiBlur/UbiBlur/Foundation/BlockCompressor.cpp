@@ -0,0 +1,526 @@
+//
+//  BlockCompressor.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "BlockCompressor.hpp"
+#include "ParallelUtils.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <cstring>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BLOCK_COMPRESSOR_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Engine {
+
+    namespace {
+
+        constexpr size_t BlockTexelCount = 16;
+
+        /// Texels of a 4x4 block in structure of arrays layout, so palette search can process 4 texels at once
+        struct BlockTexels {
+            alignas(16) float channels[4][BlockTexelCount];
+        };
+
+        /// Blocks crossing the right or bottom edge of the image replicate the edge texels
+        void LoadBlock(const uint8_t *pixels, size_t width, size_t height, size_t blockX, size_t blockY, BlockTexels &texels) {
+            for (size_t y = 0; y < 4; ++y) {
+                size_t sourceY = std::min(blockY * 4 + y, height - 1);
+                for (size_t x = 0; x < 4; ++x) {
+                    size_t sourceX = std::min(blockX * 4 + x, width - 1);
+                    const uint8_t *pixel = pixels + (sourceY * width + sourceX) * 4;
+                    for (size_t c = 0; c < 4; ++c) {
+                        texels.channels[c][y * 4 + x] = pixel[c];
+                    }
+                }
+            }
+        }
+
+#pragma mark - Endpoint search
+
+        /// Picks the closest palette entry for every texel of the block
+        /// @return sum of squared errors over the first channelCount channels
+        float SelectIndices(const BlockTexels &texels, const float (*palette)[4], size_t paletteSize, size_t channelCount, uint8_t indices[BlockTexelCount]) {
+#ifdef BLOCK_COMPRESSOR_SSE2
+            __m128 total = _mm_setzero_ps();
+
+            for (size_t i = 0; i < BlockTexelCount; i += 4) {
+                __m128 best = _mm_set1_ps(std::numeric_limits<float>::max());
+                __m128 bestIndex = _mm_setzero_ps();
+
+                for (size_t p = 0; p < paletteSize; ++p) {
+                    __m128 distance = _mm_setzero_ps();
+                    for (size_t c = 0; c < channelCount; ++c) {
+                        __m128 difference = _mm_sub_ps(_mm_load_ps(&texels.channels[c][i]), _mm_set1_ps(palette[p][c]));
+                        distance = _mm_add_ps(distance, _mm_mul_ps(difference, difference));
+                    }
+
+                    __m128 closer = _mm_cmplt_ps(distance, best);
+                    best = _mm_min_ps(distance, best);
+                    bestIndex = _mm_or_ps(_mm_and_ps(closer, _mm_set1_ps(float(p))), _mm_andnot_ps(closer, bestIndex));
+                }
+
+                total = _mm_add_ps(total, best);
+
+                alignas(16) int32_t lanes[4];
+                _mm_store_si128(reinterpret_cast<__m128i *>(lanes), _mm_cvttps_epi32(bestIndex));
+                for (size_t k = 0; k < 4; ++k) {
+                    indices[i + k] = uint8_t(lanes[k]);
+                }
+            }
+
+            alignas(16) float sums[4];
+            _mm_store_ps(sums, total);
+            return sums[0] + sums[1] + sums[2] + sums[3];
+#else
+            float total = 0.f;
+
+            for (size_t i = 0; i < BlockTexelCount; ++i) {
+                float best = std::numeric_limits<float>::max();
+                for (size_t p = 0; p < paletteSize; ++p) {
+                    float distance = 0.f;
+                    for (size_t c = 0; c < channelCount; ++c) {
+                        float difference = texels.channels[c][i] - palette[p][c];
+                        distance += difference * difference;
+                    }
+                    if (distance < best) {
+                        best = distance;
+                        indices[i] = uint8_t(p);
+                    }
+                }
+                total += best;
+            }
+
+            return total;
+#endif
+        }
+
+        /// Mean color of the block and dominant direction of its spread, found by power iteration on the covariance matrix
+        void PrincipalAxis(const BlockTexels &texels, size_t channelCount, float mean[4], float axis[4]) {
+            for (size_t c = 0; c < 4; ++c) {
+                mean[c] = 0.f;
+                axis[c] = 0.f;
+            }
+
+            for (size_t c = 0; c < channelCount; ++c) {
+                for (size_t i = 0; i < BlockTexelCount; ++i) {
+                    mean[c] += texels.channels[c][i];
+                }
+                mean[c] /= BlockTexelCount;
+            }
+
+            float covariance[4][4] = {};
+            for (size_t i = 0; i < BlockTexelCount; ++i) {
+                for (size_t a = 0; a < channelCount; ++a) {
+                    for (size_t b = a; b < channelCount; ++b) {
+                        covariance[a][b] += (texels.channels[a][i] - mean[a]) * (texels.channels[b][i] - mean[b]);
+                    }
+                }
+            }
+
+            // Start from the row of the most varying channel, it can't be orthogonal to the dominant axis
+            size_t start = 0;
+            for (size_t a = 0; a < channelCount; ++a) {
+                for (size_t b = 0; b < a; ++b) {
+                    covariance[a][b] = covariance[b][a];
+                }
+                if (covariance[a][a] > covariance[start][start]) {
+                    start = a;
+                }
+            }
+
+            if (covariance[start][start] < 1e-3f) {
+                return;
+            }
+
+            float vector[4] = {};
+            for (size_t c = 0; c < channelCount; ++c) {
+                vector[c] = covariance[start][c];
+            }
+
+            for (size_t iteration = 0; iteration < 8; ++iteration) {
+                float next[4] = {};
+                float length = 0.f;
+                for (size_t a = 0; a < channelCount; ++a) {
+                    for (size_t b = 0; b < channelCount; ++b) {
+                        next[a] += covariance[a][b] * vector[b];
+                    }
+                    length += next[a] * next[a];
+                }
+
+                length = std::sqrt(length);
+                if (length < 1e-6f) {
+                    return;
+                }
+
+                for (size_t c = 0; c < channelCount; ++c) {
+                    vector[c] = next[c] / length;
+                }
+            }
+
+            for (size_t c = 0; c < channelCount; ++c) {
+                axis[c] = vector[c];
+            }
+        }
+
+        /// Endpoints spanning projections of all texels onto the axis
+        void AxisEndpoints(const BlockTexels &texels, size_t channelCount, const float mean[4], const float axis[4], float e0[4], float e1[4]) {
+            float minimum = 0.f;
+            float maximum = 0.f;
+
+            for (size_t i = 0; i < BlockTexelCount; ++i) {
+                float t = 0.f;
+                for (size_t c = 0; c < channelCount; ++c) {
+                    t += (texels.channels[c][i] - mean[c]) * axis[c];
+                }
+                minimum = std::min(minimum, t);
+                maximum = std::max(maximum, t);
+            }
+
+            for (size_t c = 0; c < 4; ++c) {
+                e0[c] = std::min(std::max(mean[c] + axis[c] * minimum, 0.f), 255.f);
+                e1[c] = std::min(std::max(mean[c] + axis[c] * maximum, 0.f), 255.f);
+            }
+        }
+
+        /// Least squares endpoints for texels interpolated with given weights, where weight 0 selects e0 and 1 selects e1
+        /// @return false if weights are degenerate, e.g. all texels use the same one
+        bool FitEndpoints(const BlockTexels &texels, size_t channelCount, const float weights[BlockTexelCount], float e0[4], float e1[4]) {
+            float a = 0.f;
+            float b = 0.f;
+            float c = 0.f;
+            for (size_t i = 0; i < BlockTexelCount; ++i) {
+                float w = weights[i];
+                a += (1.f - w) * (1.f - w);
+                b += w * (1.f - w);
+                c += w * w;
+            }
+
+            float determinant = a * c - b * b;
+            if (std::fabs(determinant) < 1e-4f) {
+                return false;
+            }
+
+            for (size_t channel = 0; channel < channelCount; ++channel) {
+                float x0 = 0.f;
+                float x1 = 0.f;
+                for (size_t i = 0; i < BlockTexelCount; ++i) {
+                    x0 += (1.f - weights[i]) * texels.channels[channel][i];
+                    x1 += weights[i] * texels.channels[channel][i];
+                }
+
+                e0[channel] = std::min(std::max((c * x0 - b * x1) / determinant, 0.f), 255.f);
+                e1[channel] = std::min(std::max((a * x1 - b * x0) / determinant, 0.f), 255.f);
+            }
+
+            return true;
+        }
+
+#pragma mark - BC1
+
+        uint16_t PackRGB565(const float color[4]) {
+            auto quantize = [](float value, int maximum) {
+                return std::min(std::max(int(value * maximum / 255.f + 0.5f), 0), maximum);
+            };
+            return uint16_t((quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) | quantize(color[2], 31));
+        }
+
+        void UnpackRGB565(uint16_t packed, float color[4]) {
+            int r = packed >> 11;
+            int g = (packed >> 5) & 63;
+            int b = packed & 31;
+            color[0] = float((r << 3) | (r >> 2));
+            color[1] = float((g << 2) | (g >> 4));
+            color[2] = float((b << 3) | (b >> 2));
+            color[3] = 255.f;
+        }
+
+        /// Orders endpoints for the 4-color mode and selects indices
+        float EvaluateBC1(const BlockTexels &texels, uint16_t &c0, uint16_t &c1, uint8_t indices[BlockTexelCount]) {
+            if (c0 < c1) {
+                std::swap(c0, c1);
+            }
+
+            float palette[4][4];
+            UnpackRGB565(c0, palette[0]);
+            UnpackRGB565(c1, palette[1]);
+
+            // Equal endpoints switch decoders to the 3-color mode, where index 0 still yields c0
+            if (c0 == c1) {
+                return SelectIndices(texels, palette, 1, 3, indices);
+            }
+
+            for (size_t c = 0; c < 4; ++c) {
+                palette[2][c] = (2.f * palette[0][c] + palette[1][c]) / 3.f;
+                palette[3][c] = (palette[0][c] + 2.f * palette[1][c]) / 3.f;
+            }
+
+            return SelectIndices(texels, palette, 4, 3, indices);
+        }
+
+        void EncodeBC1(const BlockTexels &texels, uint8_t *block) {
+            static const float Weights[4] = {0.f, 1.f, 1.f / 3.f, 2.f / 3.f};
+
+            float mean[4], axis[4], e0[4], e1[4];
+            PrincipalAxis(texels, 3, mean, axis);
+            AxisEndpoints(texels, 3, mean, axis, e0, e1);
+
+            uint16_t c0 = PackRGB565(e0);
+            uint16_t c1 = PackRGB565(e1);
+            uint8_t indices[BlockTexelCount];
+            float error = EvaluateBC1(texels, c0, c1, indices);
+
+            float weights[BlockTexelCount];
+            for (size_t i = 0; i < BlockTexelCount; ++i) {
+                weights[i] = Weights[indices[i]];
+            }
+
+            if (c0 != c1 && FitEndpoints(texels, 3, weights, e0, e1)) {
+                uint16_t refined0 = PackRGB565(e0);
+                uint16_t refined1 = PackRGB565(e1);
+                uint8_t refinedIndices[BlockTexelCount];
+                float refinedError = EvaluateBC1(texels, refined0, refined1, refinedIndices);
+
+                if (refinedError < error) {
+                    c0 = refined0;
+                    c1 = refined1;
+                    std::copy(refinedIndices, refinedIndices + BlockTexelCount, indices);
+                }
+            }
+
+            uint32_t bits = 0;
+            for (size_t i = 0; i < BlockTexelCount; ++i) {
+                bits |= uint32_t(indices[i]) << (2 * i);
+            }
+
+            block[0] = uint8_t(c0);
+            block[1] = uint8_t(c0 >> 8);
+            block[2] = uint8_t(c1);
+            block[3] = uint8_t(c1 >> 8);
+            for (size_t i = 0; i < 4; ++i) {
+                block[4 + i] = uint8_t(bits >> (8 * i));
+            }
+        }
+
+#pragma mark - BC4
+
+        void EncodeBC4(const BlockTexels &texels, size_t channel, uint8_t *block) {
+            const float *values = texels.channels[channel];
+            float minimum = *std::min_element(values, values + BlockTexelCount);
+            float maximum = *std::max_element(values, values + BlockTexelCount);
+
+            // r0 > r1 selects the 8-value mode with 6 interpolated values
+            uint8_t r0 = uint8_t(maximum);
+            uint8_t r1 = uint8_t(minimum);
+            uint64_t bits = 0;
+
+            if (r0 > r1) {
+                float palette[8] = {float(r0), float(r1)};
+                for (size_t i = 2; i < 8; ++i) {
+                    palette[i] = ((8 - i) * r0 + (i - 1) * r1) / 7.f;
+                }
+
+                for (size_t i = 0; i < BlockTexelCount; ++i) {
+                    uint64_t best = 0;
+                    for (size_t p = 1; p < 8; ++p) {
+                        if (std::fabs(values[i] - palette[p]) < std::fabs(values[i] - palette[best])) {
+                            best = p;
+                        }
+                    }
+                    bits |= best << (3 * i);
+                }
+            }
+
+            block[0] = r0;
+            block[1] = r1;
+            for (size_t i = 0; i < 6; ++i) {
+                block[2 + i] = uint8_t(bits >> (8 * i));
+            }
+        }
+
+#pragma mark - BC7
+
+        const int BC7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        /// Mode 6: single subset, RGBA endpoints with 7 bits per channel plus a shared bit per endpoint, 4-bit indices
+        struct BC7Mode6Endpoints {
+            uint8_t color[2][4];
+            uint8_t pBit[2];
+        };
+
+        float EvaluateBC7(const BlockTexels &texels, const BC7Mode6Endpoints &endpoints, uint8_t indices[BlockTexelCount]) {
+            float palette[16][4];
+            for (size_t c = 0; c < 4; ++c) {
+                int e0 = (endpoints.color[0][c] << 1) | endpoints.pBit[0];
+                int e1 = (endpoints.color[1][c] << 1) | endpoints.pBit[1];
+                for (size_t i = 0; i < 16; ++i) {
+                    palette[i][c] = float(((64 - BC7Weights[i]) * e0 + BC7Weights[i] * e1 + 32) >> 6);
+                }
+            }
+            return SelectIndices(texels, palette, 16, 4, indices);
+        }
+
+        /// Tries all shared bit combinations for the endpoints and keeps the best one
+        float QuantizeBC7(const BlockTexels &texels, const float e0[4], const float e1[4], BC7Mode6Endpoints &best, uint8_t indices[BlockTexelCount]) {
+            float bestError = std::numeric_limits<float>::max();
+
+            for (uint8_t p0 = 0; p0 < 2; ++p0) {
+                for (uint8_t p1 = 0; p1 < 2; ++p1) {
+                    BC7Mode6Endpoints candidate;
+                    candidate.pBit[0] = p0;
+                    candidate.pBit[1] = p1;
+                    for (size_t c = 0; c < 4; ++c) {
+                        candidate.color[0][c] = uint8_t(std::min(std::max(int(std::round((e0[c] - p0) / 2.f)), 0), 127));
+                        candidate.color[1][c] = uint8_t(std::min(std::max(int(std::round((e1[c] - p1) / 2.f)), 0), 127));
+                    }
+
+                    uint8_t candidateIndices[BlockTexelCount];
+                    float error = EvaluateBC7(texels, candidate, candidateIndices);
+                    if (error < bestError) {
+                        bestError = error;
+                        best = candidate;
+                        std::copy(candidateIndices, candidateIndices + BlockTexelCount, indices);
+                    }
+                }
+            }
+
+            return bestError;
+        }
+
+        class BitWriter {
+        private:
+            uint8_t *mBytes;
+            size_t mPosition = 0;
+
+        public:
+            explicit BitWriter(uint8_t *bytes) : mBytes(bytes) {}
+
+            void write(uint32_t value, size_t bitCount) {
+                for (size_t i = 0; i < bitCount; ++i, ++mPosition) {
+                    mBytes[mPosition / 8] |= uint8_t(((value >> i) & 1) << (mPosition % 8));
+                }
+            }
+        };
+
+        void EncodeBC7(const BlockTexels &texels, uint8_t *block) {
+            float mean[4], axis[4], e0[4], e1[4];
+            PrincipalAxis(texels, 4, mean, axis);
+            AxisEndpoints(texels, 4, mean, axis, e0, e1);
+
+            BC7Mode6Endpoints endpoints;
+            uint8_t indices[BlockTexelCount];
+            float error = QuantizeBC7(texels, e0, e1, endpoints, indices);
+
+            float weights[BlockTexelCount];
+            for (size_t i = 0; i < BlockTexelCount; ++i) {
+                weights[i] = BC7Weights[indices[i]] / 64.f;
+            }
+
+            if (FitEndpoints(texels, 4, weights, e0, e1)) {
+                BC7Mode6Endpoints refined;
+                uint8_t refinedIndices[BlockTexelCount];
+                if (QuantizeBC7(texels, e0, e1, refined, refinedIndices) < error) {
+                    endpoints = refined;
+                    std::copy(refinedIndices, refinedIndices + BlockTexelCount, indices);
+                }
+            }
+
+            // The most significant index bit of the first texel is implicit zero
+            if (indices[0] & 8) {
+                std::swap(endpoints.pBit[0], endpoints.pBit[1]);
+                for (size_t c = 0; c < 4; ++c) {
+                    std::swap(endpoints.color[0][c], endpoints.color[1][c]);
+                }
+                for (size_t i = 0; i < BlockTexelCount; ++i) {
+                    indices[i] = uint8_t(15 - indices[i]);
+                }
+            }
+
+            std::memset(block, 0, 16);
+            BitWriter writer(block);
+            writer.write(1 << 6, 7);
+            for (size_t c = 0; c < 4; ++c) {
+                writer.write(endpoints.color[0][c], 7);
+                writer.write(endpoints.color[1][c], 7);
+            }
+            writer.write(endpoints.pBit[0], 1);
+            writer.write(endpoints.pBit[1], 1);
+            writer.write(indices[0], 3);
+            for (size_t i = 1; i < BlockTexelCount; ++i) {
+                writer.write(indices[i], 4);
+            }
+        }
+
+    }
+
+#pragma mark - Public
+
+    size_t BlockCompressor::BlockByteCount(Format format) {
+        switch (format) {
+            case Format::BC1:
+            case Format::BC4:
+                return 8;
+            case Format::BC5:
+            case Format::BC7:
+                return 16;
+        }
+        return 0;
+    }
+
+    size_t BlockCompressor::CompressedByteCount(Format format, size_t width, size_t height) {
+        return ((width + 3) / 4) * ((height + 3) / 4) * BlockByteCount(format);
+    }
+
+    void BlockCompressor::Compress(Format format, const uint8_t *pixels, size_t width, size_t height, uint8_t *destination) {
+        if (!pixels || !destination || width == 0 || height == 0) {
+            throw std::invalid_argument("Block compression requires non-empty source and destination images");
+        }
+
+        size_t blocksPerRow = (width + 3) / 4;
+        size_t blockRows = (height + 3) / 4;
+        size_t blockByteCount = BlockByteCount(format);
+
+        Utils::Parallel::For(blockRows, 4, [&](size_t begin, size_t end) {
+            BlockTexels texels;
+
+            for (size_t blockY = begin; blockY < end; ++blockY) {
+                for (size_t blockX = 0; blockX < blocksPerRow; ++blockX) {
+                    LoadBlock(pixels, width, height, blockX, blockY, texels);
+                    uint8_t *block = destination + (blockY * blocksPerRow + blockX) * blockByteCount;
+
+                    switch (format) {
+                        case Format::BC1:
+                            EncodeBC1(texels, block);
+                            break;
+                        case Format::BC4:
+                            EncodeBC4(texels, 0, block);
+                            break;
+                        case Format::BC5:
+                            EncodeBC4(texels, 0, block);
+                            EncodeBC4(texels, 1, block + 8);
+                            break;
+                        case Format::BC7:
+                            EncodeBC7(texels, block);
+                            break;
+                    }
+                }
+            }
+        });
+    }
+
+    std::vector<uint8_t> BlockCompressor::Compress(Format format, const uint8_t *pixels, size_t width, size_t height) {
+        std::vector<uint8_t> compressed(CompressedByteCount(format, width, height));
+        Compress(format, pixels, width, height, compressed.data());
+        return compressed;
+    }
+
+}
@@ -0,0 +1,50 @@
+//
+//  BlockCompressor.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef BlockCompressor_hpp
+#define BlockCompressor_hpp
+
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+
+namespace Engine {
+
+    /// CPU encoder for BCn block compressed texture formats.
+    /// Output is deterministic and does not depend on the driver, blocks are encoded in parallel.
+    class BlockCompressor {
+    public:
+        enum class Format {
+            /// RGB, 4 bits per texel, alpha is ignored
+            BC1,
+            /// Red channel, 4 bits per texel
+            BC4,
+            /// Red and green channels, 8 bits per texel
+            BC5,
+            /// RGBA, 8 bits per texel, encoded using mode 6 only
+            BC7
+        };
+
+        /// Size of a single 4x4 block in bytes
+        static size_t BlockByteCount(Format format);
+
+        /// Size of an image of given dimensions, partial blocks at the edges are padded
+        static size_t CompressedByteCount(Format format, size_t width, size_t height);
+
+        /**
+         @param pixels tightly packed RGBA8 pixels
+         @param destination buffer of at least CompressedByteCount() bytes, blocks are written in row-major order
+         */
+        static void Compress(Format format, const uint8_t *pixels, size_t width, size_t height, uint8_t *destination);
+
+        static std::vector<uint8_t> Compress(Format format, const uint8_t *pixels, size_t width, size_t height);
+    };
+
+}
+
+#endif /* BlockCompressor_hpp */
@@ -0,0 +1,99 @@
+//
+//  BlockingQueue.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef BlockingQueue_hpp
+#define BlockingQueue_hpp
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+namespace Engine {
+
+    /// Bounded multi-producer multi-consumer FIFO queue.
+    /// Producers block while the queue is full, which keeps memory of pipelined stages bounded.
+    /// After close() is called pushes are rejected and pops drain the remaining items.
+    template<typename T>
+    class BlockingQueue {
+    private:
+        std::deque<T> mItems;
+        size_t mCapacity;
+        bool mClosed = false;
+        mutable std::mutex mMutex;
+        std::condition_variable mNotEmpty;
+        std::condition_variable mNotFull;
+
+    public:
+        explicit BlockingQueue(size_t capacity) : mCapacity(capacity > 0 ? capacity : 1) {}
+
+        BlockingQueue(const BlockingQueue &that) = delete;
+
+        BlockingQueue &operator=(const BlockingQueue &rhs) = delete;
+
+        /// Blocks until there is free space or the queue is closed
+        /// @return false if the queue was closed and item was not enqueued
+        bool push(T item) {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mNotFull.wait(lock, [this] { return mClosed || mItems.size() < mCapacity; });
+
+            if (mClosed) return false;
+
+            mItems.push_back(std::move(item));
+            lock.unlock();
+            mNotEmpty.notify_one();
+            return true;
+        }
+
+        /// Blocks until an item is available or the queue is closed and drained
+        /// @return false if there are no more items to come
+        bool pop(T &item) {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mNotEmpty.wait(lock, [this] { return mClosed || !mItems.empty(); });
+
+            if (mItems.empty()) return false;
+
+            item = std::move(mItems.front());
+            mItems.pop_front();
+            lock.unlock();
+            mNotFull.notify_one();
+            return true;
+        }
+
+        /// Non-blocking version of pop()
+        /// @return false if the queue is currently empty
+        bool tryPop(T &item) {
+            std::unique_lock<std::mutex> lock(mMutex);
+
+            if (mItems.empty()) return false;
+
+            item = std::move(mItems.front());
+            mItems.pop_front();
+            lock.unlock();
+            mNotFull.notify_one();
+            return true;
+        }
+
+        /// Wakes up all waiting threads, subsequent pushes fail
+        void close() {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mClosed = true;
+            }
+            mNotEmpty.notify_all();
+            mNotFull.notify_all();
+        }
+
+        bool isClosed() const {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mClosed;
+        }
+    };
+
+}
+
+#endif /* BlockingQueue_hpp */
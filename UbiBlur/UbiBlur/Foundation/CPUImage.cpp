@@ -0,0 +1,63 @@
+//
+//  CPUImage.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "CPUImage.hpp"
+#include "StringUtils.hpp"
+#include "MemoryUtils.hpp"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+
+namespace Engine {
+
+    CPUImage::CPUImage(size_t width, size_t height, size_t channels)
+            : width(width), height(height), channels(channels), pixels(width * height * channels, 0.f) {}
+
+    CPUImage CPUImage::FromLDRPixels(const uint8_t *data, size_t width, size_t height, size_t channels) {
+        CPUImage image(width, height, channels);
+        for (size_t i = 0; i < image.pixels.size(); i++) {
+            image.pixels[i] = data[i] / 255.f;
+        }
+        return image;
+    }
+
+    CPUImage CPUImage::LoadLDRImage(const std::string &imagePath, size_t channels) {
+        int32_t width = 0;
+        int32_t height = 0;
+        int32_t components = 0;
+        stbi_uc *pixelData = stbi_load(imagePath.c_str(), &width, &height, &components, int(channels));
+
+        if (!pixelData) {
+            throw std::invalid_argument(string_format("Failed to load image file (%s)", imagePath.c_str()));
+        }
+
+        // Bottom row first, like OpenGL expects
+        Utils::Memory::FlipRows(pixelData, size_t(width) * channels, height);
+
+        CPUImage image = FromLDRPixels(pixelData, width, height, channels);
+        stbi_image_free(pixelData);
+
+        return image;
+    }
+
+    bool CPUImage::empty() const {
+        return pixels.empty();
+    }
+
+    std::vector<uint8_t> CPUImage::toLDRPixels() const {
+        std::vector<uint8_t> result(pixels.size());
+        for (size_t i = 0; i < pixels.size(); i++) {
+            result[i] = uint8_t(std::round(std::min(std::max(pixels[i], 0.f), 1.f) * 255.f));
+        }
+        return result;
+    }
+
+}
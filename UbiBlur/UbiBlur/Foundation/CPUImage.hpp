@@ -0,0 +1,53 @@
+//
+//  CPUImage.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef CPUImage_hpp
+#define CPUImage_hpp
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdio>
+
+namespace Engine {
+
+    /// Floating point image with interleaved channels living in system memory.
+    /// Rows are stored bottom-up, matching OpenGL texture layout.
+    struct CPUImage {
+        size_t width = 0;
+        size_t height = 0;
+        size_t channels = 0;
+        std::vector<float> pixels;
+
+        CPUImage() = default;
+
+        CPUImage(size_t width, size_t height, size_t channels);
+
+        /// Converts 8-bit normalized pixels to floating point in [0; 1] range
+        static CPUImage FromLDRPixels(const uint8_t *data, size_t width, size_t height, size_t channels);
+
+        /// Loads an image from disk using stb_image
+        static CPUImage LoadLDRImage(const std::string &imagePath, size_t channels);
+
+        bool empty() const;
+
+        float &at(size_t x, size_t y, size_t channel) {
+            return pixels[(y * width + x) * channels + channel];
+        }
+
+        float at(size_t x, size_t y, size_t channel) const {
+            return pixels[(y * width + x) * channels + channel];
+        }
+
+        /// Converts pixels back to 8-bit normalized values, clamping to [0; 1] range
+        std::vector<uint8_t> toLDRPixels() const;
+    };
+
+}
+
+#endif /* CPUImage_hpp */
@@ -12,3 +12,12 @@ uint32_t ctcrc32(std::string const &str) {
 	uint64_t len = str.size() + 1;
     return detail::crc32(len - 2, str.c_str()) ^ 0xFFFFFFFF;
 }
+
+uint32_t rtcrc32(const void *data, size_t byteCount, uint32_t crc) {
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data);
+    crc ^= 0xFFFFFFFF;
+    for (size_t i = 0; i < byteCount; ++i) {
+        crc = (crc >> 8) ^ detail::crc_table[(crc ^ bytes[i]) & 0x000000FF];
+    }
+    return crc ^ 0xFFFFFFFF;
+}
@@ -79,4 +79,8 @@ constexpr uint32_t ctcrc32(const char (&str)[len]) {
 
 uint32_t ctcrc32(std::string const& str);
 
+/// Runtime CRC32 of arbitrary binary data.
+/// Pass the result of a previous call as crc to continue the checksum over several chunks.
+uint32_t rtcrc32(const void *data, size_t byteCount, uint32_t crc = 0);
+
 #endif /* PrecomputedStringHash_hpp */
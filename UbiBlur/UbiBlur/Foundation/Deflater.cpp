@@ -0,0 +1,224 @@
+//
+//  Deflater.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "Deflater.hpp"
+
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+
+namespace Engine {
+
+    namespace {
+
+        constexpr size_t WindowSize = 1 << 15;
+        constexpr size_t HashSize = 1 << 15;
+        constexpr size_t MinMatchLength = 3;
+        constexpr size_t MaxMatchLength = 258;
+        constexpr size_t MaxChainLength = 32;
+
+        constexpr std::array<uint16_t, 29> LengthBases{{
+            3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+        }};
+
+        constexpr std::array<uint8_t, 29> LengthExtraBits{{
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+        }};
+
+        constexpr std::array<uint16_t, 30> DistanceBases{{
+            1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769,
+            1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+        }};
+
+        constexpr std::array<uint8_t, 30> DistanceExtraBits{{
+            0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+        }};
+
+        uint32_t Hash(const uint8_t *bytes) {
+            return ((uint32_t(bytes[0]) << 10) ^ (uint32_t(bytes[1]) << 5) ^ uint32_t(bytes[2])) & (HashSize - 1);
+        }
+
+    }
+
+#pragma mark - Lifecycle
+
+    Deflater::Deflater()
+            :
+            mHead(HashSize, -1),
+            mPrevious(WindowSize, -1) {
+
+        // CMF: deflate with 32K window, FLG: fastest compression level, check bits
+        mOutput.push_back(0x78);
+        mOutput.push_back(0x01);
+
+        // Final block, fixed Huffman codes
+        writeBits(1, 1);
+        writeBits(1, 2);
+    }
+
+#pragma mark - Bits
+
+    void Deflater::writeBits(uint32_t bits, uint32_t count) {
+        mBitBuffer |= bits << mBitCount;
+        mBitCount += count;
+        while (mBitCount >= 8) {
+            mOutput.push_back(uint8_t(mBitBuffer));
+            mBitBuffer >>= 8;
+            mBitCount -= 8;
+        }
+    }
+
+    void Deflater::writeReversedBits(uint32_t code, uint32_t length) {
+        uint32_t reversed = 0;
+        for (uint32_t i = 0; i < length; i++) {
+            reversed |= ((code >> i) & 1) << (length - 1 - i);
+        }
+        writeBits(reversed, length);
+    }
+
+    void Deflater::writeLiteralLength(uint32_t symbol) {
+        if (symbol < 144) writeReversedBits(0x30 + symbol, 8);
+        else if (symbol < 256) writeReversedBits(0x190 + symbol - 144, 9);
+        else if (symbol < 280) writeReversedBits(symbol - 256, 7);
+        else writeReversedBits(0xC0 + symbol - 280, 8);
+    }
+
+    void Deflater::writeMatch(size_t length, size_t distance) {
+        size_t lengthCode = std::upper_bound(LengthBases.begin(), LengthBases.end(), length) - LengthBases.begin() - 1;
+        writeLiteralLength(uint32_t(257 + lengthCode));
+        writeBits(uint32_t(length - LengthBases[lengthCode]), LengthExtraBits[lengthCode]);
+
+        size_t distanceCode = std::upper_bound(DistanceBases.begin(), DistanceBases.end(), distance) - DistanceBases.begin() - 1;
+        writeReversedBits(uint32_t(distanceCode), 5);
+        writeBits(uint32_t(distance - DistanceBases[distanceCode]), DistanceExtraBits[distanceCode]);
+    }
+
+#pragma mark - Compression
+
+    void Deflater::insert(size_t position) {
+        uint32_t hash = Hash(&mWindow[position - mWindowStart]);
+        mPrevious[position & (WindowSize - 1)] = mHead[hash];
+        mHead[hash] = int64_t(position);
+    }
+
+    void Deflater::updateChecksum(const uint8_t *data, size_t size) {
+        constexpr uint32_t Modulo = 65521;
+        // Largest block for which sums don't overflow 32 bits
+        constexpr size_t BlockSize = 5552;
+
+        for (size_t offset = 0; offset < size; offset += BlockSize) {
+            size_t end = std::min(offset + BlockSize, size);
+            for (size_t i = offset; i < end; i++) {
+                mAdlerA += data[i];
+                mAdlerB += mAdlerA;
+            }
+            mAdlerA %= Modulo;
+            mAdlerB %= Modulo;
+        }
+    }
+
+    void Deflater::compress(bool isFlushing) {
+        size_t end = mWindowStart + mWindow.size();
+        auto byteAt = [&](size_t position) { return mWindow[position - mWindowStart]; };
+
+        // Without flushing a position is only compressed once a maximum match could fit behind it,
+        // so that splitting the input into pieces doesn't shorten matches
+        while (mPosition < end && (isFlushing || end - mPosition >= MaxMatchLength)) {
+            size_t bestLength = 0;
+            size_t bestDistance = 0;
+
+            if (mPosition + MinMatchLength <= end) {
+                size_t maxLength = std::min(MaxMatchLength, end - mPosition);
+                int64_t candidate = mHead[Hash(&mWindow[mPosition - mWindowStart])];
+
+                for (size_t chain = 0; candidate >= 0 && chain < MaxChainLength; chain++) {
+                    size_t distance = mPosition - size_t(candidate);
+                    if (distance > WindowSize - 1) break;
+
+                    size_t length = 0;
+                    while (length < maxLength && byteAt(size_t(candidate) + length) == byteAt(mPosition + length)) {
+                        length++;
+                    }
+
+                    if (length > bestLength) {
+                        bestLength = length;
+                        bestDistance = distance;
+                        if (length == maxLength) break;
+                    }
+
+                    candidate = mPrevious[size_t(candidate) & (WindowSize - 1)];
+                }
+            }
+
+            if (bestLength >= MinMatchLength) {
+                writeMatch(bestLength, bestDistance);
+                for (size_t matchEnd = mPosition + bestLength; mPosition < matchEnd; mPosition++) {
+                    if (mPosition + MinMatchLength <= end) {
+                        insert(mPosition);
+                    }
+                }
+            } else {
+                writeLiteralLength(byteAt(mPosition));
+                if (mPosition + MinMatchLength <= end) {
+                    insert(mPosition);
+                }
+                mPosition++;
+            }
+        }
+
+        // Matches never reach further back than the window, older history can go
+        if (mPosition - mWindowStart > WindowSize * 2) {
+            size_t discarded = mPosition - WindowSize - mWindowStart;
+            mWindow.erase(mWindow.begin(), mWindow.begin() + discarded);
+            mWindowStart += discarded;
+        }
+    }
+
+#pragma mark - Public
+
+    void Deflater::write(const uint8_t *data, size_t size) {
+        if (mIsFinished) {
+            throw std::logic_error("Can't write into a finished deflate stream");
+        }
+
+        updateChecksum(data, size);
+        mWindow.insert(mWindow.end(), data, data + size);
+        compress(false);
+    }
+
+    void Deflater::finish() {
+        if (mIsFinished) {
+            return;
+        }
+
+        compress(true);
+
+        // End of block
+        writeLiteralLength(256);
+        if (mBitCount > 0) {
+            mOutput.push_back(uint8_t(mBitBuffer));
+        }
+        mBitBuffer = 0;
+        mBitCount = 0;
+
+        uint32_t adler = (mAdlerB << 16) | mAdlerA;
+        mOutput.push_back(uint8_t(adler >> 24));
+        mOutput.push_back(uint8_t(adler >> 16));
+        mOutput.push_back(uint8_t(adler >> 8));
+        mOutput.push_back(uint8_t(adler));
+
+        mWindow.clear();
+        mWindow.shrink_to_fit();
+        mIsFinished = true;
+    }
+
+    std::vector<uint8_t> &Deflater::output() {
+        return mOutput;
+    }
+
+}
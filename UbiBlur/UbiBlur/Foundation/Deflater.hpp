@@ -0,0 +1,76 @@
+//
+//  Deflater.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef Deflater_hpp
+#define Deflater_hpp
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Engine {
+
+    /**
+     Incremental zlib compressor.
+     Input is compressed with LZ77 and fixed Huffman codes into a single deflate block, which trades a few percent
+     of size for not depending on zlib. Input may arrive in pieces of any size, only the 32K window and
+     the lookahead of one maximum match are kept, so memory doesn't grow with the stream length.
+     */
+    class Deflater {
+    private:
+        std::vector<uint8_t> mOutput;
+        uint32_t mBitBuffer = 0;
+        uint32_t mBitCount = 0;
+
+        /// Already compressed history followed by input waiting for compression
+        std::vector<uint8_t> mWindow;
+        /// Stream position of the first byte of mWindow
+        size_t mWindowStart = 0;
+        /// Stream position of the next byte to compress
+        size_t mPosition = 0;
+
+        std::vector<int64_t> mHead;
+        std::vector<int64_t> mPrevious;
+
+        uint32_t mAdlerA = 1;
+        uint32_t mAdlerB = 0;
+        bool mIsFinished = false;
+
+        /// Writes bits starting from the least significant one
+        void writeBits(uint32_t bits, uint32_t count);
+
+        /// Huffman codes are defined starting from the most significant bit
+        void writeReversedBits(uint32_t code, uint32_t length);
+
+        void writeLiteralLength(uint32_t symbol);
+
+        void writeMatch(size_t length, size_t distance);
+
+        void insert(size_t position);
+
+        void updateChecksum(const uint8_t *data, size_t size);
+
+        /// @param isFlushing compress all of the input, even if longer matches could follow
+        void compress(bool isFlushing);
+
+    public:
+        Deflater();
+
+        /// @throws std::logic_error if the stream has been finished
+        void write(const uint8_t *data, size_t size);
+
+        /// Compresses the remaining input and terminates the stream
+        void finish();
+
+        /// Compressed bytes produced so far, caller is free to take them out
+        std::vector<uint8_t> &output();
+    };
+
+}
+
+#endif /* Deflater_hpp */
@@ -7,6 +7,7 @@
 //
 
 #include "Drawable.hpp"
+#include "GLElementArrayBuffer.hpp"
 #include <glad/glad.h>
 
 namespace Engine {
@@ -15,7 +16,21 @@ namespace Engine {
 
         namespace TriangleStripQuad {
 
+            /// Quad vertices are generated from gl_VertexID, but core profile still
+            /// rejects draw calls issued without any vertex array bound.
+            /// Binding unconditionally is cheaper than querying the current binding, which may stall the pipeline.
+            static void BindEmptyVertexArray() {
+                static GLuint emptyVertexArray = 0;
+
+                if (emptyVertexArray == 0) {
+                    glGenVertexArrays(1, &emptyVertexArray);
+                }
+                glBindVertexArray(emptyVertexArray);
+            }
+
             void Draw(size_t instanceCount) {
+                BindEmptyVertexArray();
+
                 if (instanceCount > 1) {
                     glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei) instanceCount);
                 } else {
@@ -43,6 +58,12 @@ namespace Engine {
                 glDrawArraysInstanced(GL_TRIANGLES, VBOOffset, static_cast<GLsizei>(vertexCount), static_cast<GLsizei>(instanceCount));
             }
 
+            void DrawIndexed(const GLElementArrayBuffer &indexBuffer, size_t indexCount, size_t firstIndex) {
+                size_t indexSize = indexBuffer.indexType() == GL_UNSIGNED_INT ? sizeof(GLuint) : sizeof(GLushort);
+                size_t count = indexCount > 0 ? indexCount : indexBuffer.count() - firstIndex;
+                glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(count), indexBuffer.indexType(), reinterpret_cast<void *>(firstIndex * indexSize));
+            }
+
         }
     }
 
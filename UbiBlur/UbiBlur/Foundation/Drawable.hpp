@@ -13,6 +13,8 @@
 
 namespace Engine {
 
+    class GLElementArrayBuffer;
+
     namespace Drawable {
 
         namespace TriangleStripQuad {
@@ -27,6 +29,11 @@ namespace Engine {
             void Draw(size_t vertexCount = 1, size_t VBOOffset = 0);
 
             void DrawInstanced(size_t instanceCount, size_t vertexCount = 1, size_t VBOOffset = 0);
+
+            /// Draws triangles from the index buffer attached to the currently bound vertex array
+            /// @param indexCount number of indices to draw, whole buffer is drawn if 0
+            /// @param firstIndex offset in indices, not in bytes
+            void DrawIndexed(const GLElementArrayBuffer &indexBuffer, size_t indexCount = 0, size_t firstIndex = 0);
         }
 
     }
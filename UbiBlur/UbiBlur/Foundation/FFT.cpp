@@ -0,0 +1,207 @@
+//
+//  FFT.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "FFT.hpp"
+#include "StringUtils.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Engine {
+
+#pragma mark - FFT
+
+    bool FFT::IsPowerOfTwo(size_t value) {
+        return value > 0 && (value & (value - 1)) == 0;
+    }
+
+    size_t FFT::NextPowerOfTwo(size_t value) {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    FFT::FFT(size_t size) : mSize(size) {
+        if (!IsPowerOfTwo(size)) {
+            throw std::invalid_argument(string_format("FFT size must be a power of two. Requested size: %zu", size));
+        }
+
+        size_t log2Size = 0;
+        while ((size_t(1) << log2Size) < size) {
+            log2Size++;
+        }
+
+        mBitReversal.resize(size);
+        for (size_t i = 0; i < size; i++) {
+            uint32_t reversed = 0;
+            for (size_t bit = 0; bit < log2Size; bit++) {
+                if (i & (size_t(1) << bit)) {
+                    reversed |= uint32_t(1) << (log2Size - 1 - bit);
+                }
+            }
+            mBitReversal[i] = reversed;
+        }
+
+        mTwiddles.resize(std::max(size / 2, size_t(1)));
+        for (size_t i = 0; i < mTwiddles.size(); i++) {
+            double angle = -2.0 * glm::pi<double>() * double(i) / double(size);
+            mTwiddles[i] = Complex(float(std::cos(angle)), float(std::sin(angle)));
+        }
+    }
+
+    size_t FFT::size() const {
+        return mSize;
+    }
+
+    void FFT::transform(Complex *data, size_t stride, bool inverse) const {
+        for (size_t i = 0; i < mSize; i++) {
+            size_t j = mBitReversal[i];
+            if (i < j) {
+                std::swap(data[i * stride], data[j * stride]);
+            }
+        }
+
+        for (size_t length = 2; length <= mSize; length <<= 1) {
+            size_t halfLength = length / 2;
+            size_t twiddleStep = mSize / length;
+
+            for (size_t block = 0; block < mSize; block += length) {
+                for (size_t k = 0; k < halfLength; k++) {
+                    Complex w = mTwiddles[k * twiddleStep];
+                    if (inverse) {
+                        w = std::conj(w);
+                    }
+
+                    Complex &a = data[(block + k) * stride];
+                    Complex &b = data[(block + k + halfLength) * stride];
+                    Complex t = b * w;
+                    b = a - t;
+                    a += t;
+                }
+            }
+        }
+    }
+
+    void FFT::forward(Complex *data, size_t stride) const {
+        transform(data, stride, false);
+    }
+
+    void FFT::inverse(Complex *data, size_t stride) const {
+        transform(data, stride, true);
+    }
+
+#pragma mark - RealFFT2D
+
+    RealFFT2D::RealFFT2D(size_t width, size_t height)
+            : mRowFFT(width), mColumnFFT(height) {
+
+        if (width < 2) {
+            throw std::invalid_argument("Real FFT width must be at least 2");
+        }
+    }
+
+    size_t RealFFT2D::width() const {
+        return mRowFFT.size();
+    }
+
+    size_t RealFFT2D::height() const {
+        return mColumnFFT.size();
+    }
+
+    size_t RealFFT2D::spectrumWidth() const {
+        return width() / 2 + 1;
+    }
+
+    size_t RealFFT2D::spectrumLength() const {
+        return spectrumWidth() * height();
+    }
+
+    void RealFFT2D::forward(const float *input, Complex *spectrum, std::vector<Complex> &scratch) const {
+        size_t w = width();
+        size_t h = height();
+        size_t sw = spectrumWidth();
+
+        scratch.resize(std::max(w, h));
+
+        // Rows: transform two real rows at once, a + ib, then separate their spectra
+        for (size_t y = 0; y < h; y += 2) {
+            const float *rowA = input + y * w;
+            const float *rowB = y + 1 < h ? input + (y + 1) * w : nullptr;
+
+            for (size_t x = 0; x < w; x++) {
+                scratch[x] = Complex(rowA[x], rowB ? rowB[x] : 0.f);
+            }
+
+            mRowFFT.forward(scratch.data());
+
+            Complex *spectrumA = spectrum + y * sw;
+            Complex *spectrumB = rowB ? spectrum + (y + 1) * sw : nullptr;
+
+            for (size_t k = 0; k < sw; k++) {
+                Complex z = scratch[k];
+                Complex zMirrored = std::conj(scratch[(w - k) % w]);
+                spectrumA[k] = (z + zMirrored) * 0.5f;
+                if (spectrumB) {
+                    spectrumB[k] = (z - zMirrored) * Complex(0.f, -0.5f);
+                }
+            }
+        }
+
+        // Columns: regular complex transforms over the stored half of the spectrum
+        for (size_t k = 0; k < sw; k++) {
+            mColumnFFT.forward(spectrum + k, sw);
+        }
+    }
+
+    void RealFFT2D::inverse(Complex *spectrum, float *output, std::vector<Complex> &scratch) const {
+        size_t w = width();
+        size_t h = height();
+        size_t sw = spectrumWidth();
+        float normalization = 1.f / float(w * h);
+
+        scratch.resize(std::max(w, h));
+
+        for (size_t k = 0; k < sw; k++) {
+            mColumnFFT.inverse(spectrum + k, sw);
+        }
+
+        // Rows: restore full Hermitian spectra of two rows and pack them as A + iB,
+        // so that real and imaginary parts of the inverse transform are the two real rows
+        for (size_t y = 0; y < h; y += 2) {
+            const Complex *spectrumA = spectrum + y * sw;
+            const Complex *spectrumB = y + 1 < h ? spectrum + (y + 1) * sw : nullptr;
+            const Complex i(0.f, 1.f);
+
+            for (size_t k = 0; k < w; k++) {
+                bool isMirrored = k >= sw;
+                size_t index = isMirrored ? w - k : k;
+                Complex a = isMirrored ? std::conj(spectrumA[index]) : spectrumA[index];
+                Complex b = spectrumB ? (isMirrored ? std::conj(spectrumB[index]) : spectrumB[index]) : Complex(0.f);
+                scratch[k] = a + i * b;
+            }
+
+            mRowFFT.inverse(scratch.data());
+
+            float *rowA = output + y * w;
+            float *rowB = spectrumB ? output + (y + 1) * w : nullptr;
+
+            for (size_t x = 0; x < w; x++) {
+                rowA[x] = scratch[x].real() * normalization;
+                if (rowB) {
+                    rowB[x] = scratch[x].imag() * normalization;
+                }
+            }
+        }
+    }
+
+}
@@ -0,0 +1,87 @@
+//
+//  FFT.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef FFT_hpp
+#define FFT_hpp
+
+#include <complex>
+#include <vector>
+#include <cstdint>
+
+namespace Engine {
+
+    /// Iterative radix-2 complex FFT of a fixed power-of-two length.
+    /// Twiddle factors and bit-reversal permutation are precomputed once,
+    /// transforms themselves are const and can be run from several threads simultaneously.
+    class FFT {
+    public:
+        using Complex = std::complex<float>;
+
+    private:
+        size_t mSize;
+        std::vector<uint32_t> mBitReversal;
+        std::vector<Complex> mTwiddles;
+
+        void transform(Complex *data, size_t stride, bool inverse) const;
+
+    public:
+        static bool IsPowerOfTwo(size_t value);
+
+        static size_t NextPowerOfTwo(size_t value);
+
+        FFT(size_t size);
+
+        size_t size() const;
+
+        /// In-place forward transform of size() elements separated by stride
+        void forward(Complex *data, size_t stride = 1) const;
+
+        /// In-place inverse transform. Result is NOT normalized by 1/size()
+        void inverse(Complex *data, size_t stride = 1) const;
+    };
+
+    /**
+     2D FFT of real-valued data. Exploits Hermitian symmetry of real signals' spectra:
+     two real rows are packed into a single complex transform and only width / 2 + 1
+     spectrum columns are stored and transformed.
+
+     Spatial data is row-major width x height, spectrum is row-major (width / 2 + 1) x height.
+     */
+    class RealFFT2D {
+    private:
+        FFT mRowFFT;
+        FFT mColumnFFT;
+
+    public:
+        using Complex = FFT::Complex;
+
+        RealFFT2D(size_t width, size_t height);
+
+        size_t width() const;
+
+        size_t height() const;
+
+        size_t spectrumWidth() const;
+
+        size_t spectrumLength() const;
+
+        /// @param input width x height real values
+        /// @param spectrum output of spectrumLength() complex values
+        /// @param scratch reusable temporary storage, resized as needed
+        void forward(const float *input, Complex *spectrum, std::vector<Complex> &scratch) const;
+
+        /// Normalized inverse transform. Spectrum is used as temporary storage and is destroyed.
+        /// @param spectrum spectrumLength() complex values
+        /// @param output width x height real values
+        /// @param scratch reusable temporary storage, resized as needed
+        void inverse(Complex *spectrum, float *output, std::vector<Complex> &scratch) const;
+    };
+
+}
+
+#endif /* FFT_hpp */
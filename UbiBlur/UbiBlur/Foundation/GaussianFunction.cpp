@@ -46,4 +46,40 @@ namespace Engine {
         return Produce1DKernel(radius, radius / 2.0);
     }
 
+    GaussianFunction::Kernel1D GaussianFunction::Produce1DKernel(size_t radius, float sigma, float truncationEpsilon) {
+        return Truncate1DKernel(Produce1DKernel(radius, sigma), truncationEpsilon);
+    }
+
+    GaussianFunction::Kernel1D GaussianFunction::Truncate1DKernel(const Kernel1D &kernel, float truncationEpsilon) {
+        if (kernel.empty() || truncationEpsilon <= 0.0) {
+            return kernel;
+        }
+
+        // Walk inwards from the outermost tap while both tails together stay below epsilon
+        size_t radius = kernel.size() - 1;
+        double discardedWeight = 0.0;
+
+        while (radius > 0) {
+            double tailWeight = 2.0 * kernel[radius];
+            if (discardedWeight + tailWeight > truncationEpsilon) {
+                break;
+            }
+            discardedWeight += tailWeight;
+            radius--;
+        }
+
+        Kernel1D truncated(kernel.begin(), kernel.begin() + radius + 1);
+
+        float sum = 0;
+        for (size_t i = 0; i < truncated.size(); i++) {
+            sum += i == 0 ? truncated[i] : 2.0 * truncated[i];
+        }
+
+        for (float &weight : truncated) {
+            weight /= sum;
+        }
+
+        return truncated;
+    }
+
 }
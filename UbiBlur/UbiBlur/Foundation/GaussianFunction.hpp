@@ -9,6 +9,7 @@
 #ifndef GaussianFunction_hpp
 #define GaussianFunction_hpp
 
+#include <cstdio>
 #include <vector>
 
 namespace Engine {
@@ -20,9 +21,35 @@ namespace Engine {
     public:
         using Kernel1D = std::vector<float>;
 
+        /// Largest mass a 1D kernel may lose during truncation in each pass of a separable blur.
+        /// Renormalized truncation shifts a pass result by at most epsilon, so both passes together stay
+        /// within half an 8-bit quantization step and a stored value changes by at most one step,
+        /// only where the exact result lies next to a rounding boundary
+        static constexpr float LDRTruncationEpsilon = 0.25f / 255.f;
+
         static Kernel1D Produce1DKernel(size_t radius, float sigma);
 
         static Kernel1D Produce1DKernel(size_t radius);
+
+        /**
+         Produces kernel and trims its tails if they carry negligible weight
+
+         @param radius maximum radius of the kernel
+         @param sigma standard deviation
+         @param truncationEpsilon maximum total weight (both tails) allowed to be discarded. 0 disables truncation
+         @return normalized kernel with radius less or equal to the requested one
+         */
+        static Kernel1D Produce1DKernel(size_t radius, float sigma, float truncationEpsilon);
+
+        /**
+         Trims kernel to the smallest radius whose discarded weight (both tails) does not exceed epsilon
+         and renormalizes remaining weights
+
+         @param kernel normalized half kernel: center weight followed by one side
+         @param truncationEpsilon maximum total weight allowed to be discarded
+         @return truncated and renormalized half kernel
+         */
+        static Kernel1D Truncate1DKernel(const Kernel1D &kernel, float truncationEpsilon);
     };
 
 }
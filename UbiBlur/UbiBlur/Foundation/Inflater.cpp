@@ -0,0 +1,387 @@
+//
+//  Inflater.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "Inflater.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace Engine {
+
+    namespace {
+
+        constexpr size_t WindowSize = 1 << 15;
+        constexpr size_t InputBufferSize = 1 << 16;
+        /// Output produced by one decompress() call before control returns to the reader
+        constexpr size_t OutputBatchSize = 1 << 15;
+
+        constexpr std::array<uint16_t, 29> LengthBases{{
+            3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+        }};
+
+        constexpr std::array<uint8_t, 29> LengthExtraBits{{
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+        }};
+
+        constexpr std::array<uint16_t, 30> DistanceBases{{
+            1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769,
+            1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+        }};
+
+        constexpr std::array<uint8_t, 30> DistanceExtraBits{{
+            0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+        }};
+
+        constexpr std::array<uint8_t, 19> CodeLengthOrder{{
+            16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+        }};
+
+        [[noreturn]] void ThrowCorrupted(const char *reason) {
+            throw std::runtime_error(std::string("Corrupted deflate stream: ") + reason);
+        }
+
+    }
+
+#pragma mark - Huffman Table
+
+    void Inflater::HuffmanTable::build(const uint8_t *codeLengths, size_t symbolCount) {
+        std::array<uint32_t, MaxCodeLength + 1> lengthCounts{};
+        for (size_t symbol = 0; symbol < symbolCount; symbol++) {
+            lengthCounts[codeLengths[symbol]]++;
+        }
+        lengthCounts[0] = 0;
+
+        // First canonical code of every length, incomplete codes are allowed but oversubscribed ones aren't
+        std::array<uint32_t, MaxCodeLength + 1> nextCodes{};
+        uint32_t code = 0;
+        for (uint32_t length = 1; length <= MaxCodeLength; length++) {
+            code = (code + lengthCounts[length - 1]) << 1;
+            nextCodes[length] = code;
+            if (code + lengthCounts[length] > (1u << length)) {
+                ThrowCorrupted("oversubscribed Huffman code");
+            }
+        }
+
+        entries.assign(size_t(1) << MaxCodeLength, 0);
+
+        for (size_t symbol = 0; symbol < symbolCount; symbol++) {
+            uint32_t length = codeLengths[symbol];
+            if (length == 0) continue;
+
+            // Codes are stored starting from the most significant bit, while the table is indexed by input order
+            uint32_t symbolCode = nextCodes[length]++;
+            uint32_t reversed = 0;
+            for (uint32_t i = 0; i < length; i++) {
+                reversed |= ((symbolCode >> i) & 1) << (length - 1 - i);
+            }
+
+            uint16_t entry = uint16_t((length << 12) | symbol);
+            for (size_t index = reversed; index < entries.size(); index += size_t(1) << length) {
+                entries[index] = entry;
+            }
+        }
+    }
+
+#pragma mark - Lifecycle
+
+    Inflater::Inflater(const Source &source)
+            :
+            mSource(source) {
+
+        readHeader();
+    }
+
+#pragma mark - Bits
+
+    void Inflater::refillInput() {
+        mInput.resize(InputBufferSize);
+        mInput.resize(mSource(mInput.data(), mInput.size()));
+        mInputPosition = 0;
+        mIsInputExhausted = mInput.empty();
+    }
+
+    bool Inflater::ensureBits(uint32_t count) {
+        while (mBitCount < count) {
+            if (mInputPosition == mInput.size()) {
+                if (mIsInputExhausted) return false;
+                refillInput();
+                if (mIsInputExhausted) return false;
+            }
+            mBitBuffer |= uint64_t(mInput[mInputPosition++]) << mBitCount;
+            mBitCount += 8;
+        }
+        return true;
+    }
+
+    uint32_t Inflater::readBits(uint32_t count) {
+        if (!ensureBits(count)) {
+            ThrowCorrupted("unexpected end of data");
+        }
+        uint32_t bits = uint32_t(mBitBuffer & ((uint64_t(1) << count) - 1));
+        mBitBuffer >>= count;
+        mBitCount -= count;
+        return bits;
+    }
+
+    uint32_t Inflater::readSymbol(const HuffmanTable &table) {
+        // Last code of the stream may be shorter than the lookup width, missing bits then read as zeros
+        ensureBits(HuffmanTable::MaxCodeLength);
+
+        uint32_t index = uint32_t(mBitBuffer & ((uint64_t(1) << HuffmanTable::MaxCodeLength) - 1));
+        uint16_t entry = table.entries[index];
+        uint32_t length = entry >> 12;
+        if (length == 0 || length > mBitCount) {
+            ThrowCorrupted("invalid Huffman code");
+        }
+
+        mBitBuffer >>= length;
+        mBitCount -= length;
+        return entry & 0x0FFF;
+    }
+
+#pragma mark - Headers
+
+    void Inflater::readHeader() {
+        uint32_t method = readBits(8);
+        uint32_t flags = readBits(8);
+
+        if ((method & 0x0F) != 8 || (method >> 4) > 7) {
+            throw std::runtime_error("Unsupported zlib compression method");
+        }
+        if ((method * 256 + flags) % 31 != 0) {
+            throw std::runtime_error("Invalid zlib header checksum");
+        }
+        if (flags & 0x20) {
+            throw std::runtime_error("Preset zlib dictionaries are not supported");
+        }
+    }
+
+    void Inflater::readBlockHeader() {
+        mIsFinalBlock = readBits(1);
+        uint32_t type = readBits(2);
+
+        switch (type) {
+            case 0: {
+                // Stored blocks start at a byte boundary
+                readBits(mBitCount % 8);
+                uint32_t length = readBits(16);
+                uint32_t complement = readBits(16);
+                if ((length ^ 0xFFFF) != complement) {
+                    ThrowCorrupted("stored block length mismatch");
+                }
+                mStoredRemaining = length;
+                mState = State::Stored;
+                break;
+            }
+
+            case 1: {
+                std::array<uint8_t, 288> literalLengths{};
+                std::fill(literalLengths.begin(), literalLengths.begin() + 144, 8);
+                std::fill(literalLengths.begin() + 144, literalLengths.begin() + 256, 9);
+                std::fill(literalLengths.begin() + 256, literalLengths.begin() + 280, 7);
+                std::fill(literalLengths.begin() + 280, literalLengths.end(), 8);
+                mLiteralLengths.build(literalLengths.data(), literalLengths.size());
+
+                std::array<uint8_t, 30> distances;
+                distances.fill(5);
+                mDistances.build(distances.data(), distances.size());
+
+                mState = State::Compressed;
+                break;
+            }
+
+            case 2:
+                readDynamicTables();
+                mState = State::Compressed;
+                break;
+
+            default:
+                ThrowCorrupted("invalid block type");
+        }
+    }
+
+    void Inflater::readDynamicTables() {
+        uint32_t literalCount = readBits(5) + 257;
+        uint32_t distanceCount = readBits(5) + 1;
+        uint32_t codeLengthCount = readBits(4) + 4;
+
+        std::array<uint8_t, 19> codeLengthLengths{};
+        for (uint32_t i = 0; i < codeLengthCount; i++) {
+            codeLengthLengths[CodeLengthOrder[i]] = uint8_t(readBits(3));
+        }
+
+        HuffmanTable codeLengths;
+        codeLengths.build(codeLengthLengths.data(), codeLengthLengths.size());
+
+        // Literal/length and distance code lengths form a single sequence, repeats may cross between them
+        std::array<uint8_t, 288 + 32> lengths{};
+        uint32_t count = 0;
+        while (count < literalCount + distanceCount) {
+            uint32_t symbol = readSymbol(codeLengths);
+
+            if (symbol < 16) {
+                lengths[count++] = uint8_t(symbol);
+                continue;
+            }
+
+            uint8_t repeated = 0;
+            uint32_t repeatCount = 0;
+            if (symbol == 16) {
+                if (count == 0) ThrowCorrupted("code length repeat without a previous length");
+                repeated = lengths[count - 1];
+                repeatCount = 3 + readBits(2);
+            } else if (symbol == 17) {
+                repeatCount = 3 + readBits(3);
+            } else {
+                repeatCount = 11 + readBits(7);
+            }
+
+            if (count + repeatCount > literalCount + distanceCount) {
+                ThrowCorrupted("too many code lengths");
+            }
+            std::fill_n(lengths.begin() + count, repeatCount, repeated);
+            count += repeatCount;
+        }
+
+        if (lengths[256] == 0) {
+            ThrowCorrupted("missing end of block code");
+        }
+
+        mLiteralLengths.build(lengths.data(), literalCount);
+        mDistances.build(lengths.data() + literalCount, distanceCount);
+    }
+
+    void Inflater::readTrailer() {
+        readBits(mBitCount % 8);
+        uint32_t adler = 0;
+        for (int i = 0; i < 4; i++) {
+            adler = (adler << 8) | readBits(8);
+        }
+
+        if (adler != ((mAdlerB << 16) | mAdlerA)) {
+            throw std::runtime_error("Deflate stream checksum mismatch");
+        }
+    }
+
+#pragma mark - Decompression
+
+    void Inflater::updateChecksum(const uint8_t *data, size_t size) {
+        constexpr uint32_t Modulo = 65521;
+        // Largest block for which sums don't overflow 32 bits
+        constexpr size_t BlockSize = 5552;
+
+        for (size_t offset = 0; offset < size; offset += BlockSize) {
+            size_t end = std::min(offset + BlockSize, size);
+            for (size_t i = offset; i < end; i++) {
+                mAdlerA += data[i];
+                mAdlerB += mAdlerA;
+            }
+            mAdlerA %= Modulo;
+            mAdlerB %= Modulo;
+        }
+    }
+
+    void Inflater::decompress() {
+        // Keep a full window of history behind output that was already handed out
+        if (mWindowReadPosition > WindowSize * 2) {
+            size_t discarded = mWindowReadPosition - WindowSize;
+            mWindow.erase(mWindow.begin(), mWindow.begin() + discarded);
+            mWindowReadPosition -= discarded;
+        }
+
+        size_t produceStart = mWindow.size();
+
+        while (mState != State::Finished && mWindow.size() - produceStart < OutputBatchSize) {
+            switch (mState) {
+                case State::BlockHeader:
+                    readBlockHeader();
+                    break;
+
+                case State::Stored:
+                    if (mStoredRemaining == 0) {
+                        mState = State::BlockHeader;
+                    } else {
+                        mWindow.push_back(uint8_t(readBits(8)));
+                        mStoredRemaining--;
+                    }
+                    break;
+
+                case State::Compressed: {
+                    uint32_t symbol = readSymbol(mLiteralLengths);
+
+                    if (symbol < 256) {
+                        mWindow.push_back(uint8_t(symbol));
+                        break;
+                    }
+
+                    if (symbol == 256) {
+                        mState = State::BlockHeader;
+                        break;
+                    }
+
+                    uint32_t lengthCode = symbol - 257;
+                    if (lengthCode >= LengthBases.size()) ThrowCorrupted("invalid length code");
+                    size_t length = LengthBases[lengthCode] + readBits(LengthExtraBits[lengthCode]);
+
+                    uint32_t distanceCode = readSymbol(mDistances);
+                    if (distanceCode >= DistanceBases.size()) ThrowCorrupted("invalid distance code");
+                    size_t distance = DistanceBases[distanceCode] + readBits(DistanceExtraBits[distanceCode]);
+
+                    if (distance > mWindow.size()) {
+                        ThrowCorrupted("distance points before the start of data");
+                    }
+
+                    // Byte by byte, since a match may overlap its own output
+                    size_t source = mWindow.size() - distance;
+                    for (size_t i = 0; i < length; i++) {
+                        mWindow.push_back(mWindow[source + i]);
+                    }
+                    break;
+                }
+
+                case State::Finished:
+                    break;
+            }
+
+            if (mState == State::BlockHeader && mIsFinalBlock) {
+                updateChecksum(mWindow.data() + produceStart, mWindow.size() - produceStart);
+                produceStart = mWindow.size();
+                readTrailer();
+                mState = State::Finished;
+            }
+        }
+
+        updateChecksum(mWindow.data() + produceStart, mWindow.size() - produceStart);
+    }
+
+#pragma mark - Public
+
+    void Inflater::read(uint8_t *output, size_t count) {
+        while (count > 0) {
+            if (mWindowReadPosition == mWindow.size()) {
+                if (mState == State::Finished) {
+                    throw std::runtime_error("Deflate stream ended before all expected data was read");
+                }
+                decompress();
+                continue;
+            }
+
+            size_t available = std::min(count, mWindow.size() - mWindowReadPosition);
+            std::copy_n(mWindow.begin() + mWindowReadPosition, available, output);
+            mWindowReadPosition += available;
+            output += available;
+            count -= available;
+        }
+    }
+
+    bool Inflater::isFinished() const {
+        return mState == State::Finished && mWindowReadPosition == mWindow.size();
+    }
+
+}
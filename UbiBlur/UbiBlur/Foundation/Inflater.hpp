@@ -0,0 +1,103 @@
+//
+//  Inflater.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef Inflater_hpp
+#define Inflater_hpp
+
+#include <vector>
+#include <array>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+namespace Engine {
+
+    /**
+     Incremental zlib decompressor, counterpart of Deflater.
+     Compressed bytes are pulled from the source on demand and decompressed output is handed out in pieces
+     of any size, only the 32K history window is kept, so memory doesn't grow with the stream length.
+     */
+    class Inflater {
+    public:
+        /// Fills the buffer with up to capacity compressed bytes and returns how many were written, 0 at the end of input
+        using Source = std::function<size_t(uint8_t *buffer, size_t capacity)>;
+
+    private:
+        /// Canonical Huffman code decoded through a table indexed by the next MaxCodeLength input bits
+        struct HuffmanTable {
+            static constexpr uint32_t MaxCodeLength = 15;
+
+            /// Symbol in the lower 12 bits, code length in the upper 4, zero for unused codes
+            std::vector<uint16_t> entries;
+
+            void build(const uint8_t *codeLengths, size_t symbolCount);
+        };
+
+        enum class State {
+            BlockHeader, Stored, Compressed, Finished
+        };
+
+        Source mSource;
+        std::vector<uint8_t> mInput;
+        size_t mInputPosition = 0;
+        bool mIsInputExhausted = false;
+
+        uint64_t mBitBuffer = 0;
+        uint32_t mBitCount = 0;
+
+        State mState = State::BlockHeader;
+        bool mIsFinalBlock = false;
+        size_t mStoredRemaining = 0;
+        HuffmanTable mLiteralLengths;
+        HuffmanTable mDistances;
+
+        /// Decompressed history followed by output not yet handed out
+        std::vector<uint8_t> mWindow;
+        size_t mWindowReadPosition = 0;
+
+        uint32_t mAdlerA = 1;
+        uint32_t mAdlerB = 0;
+
+        void refillInput();
+
+        bool ensureBits(uint32_t count);
+
+        uint32_t readBits(uint32_t count);
+
+        uint32_t readSymbol(const HuffmanTable &table);
+
+        void readHeader();
+
+        void readBlockHeader();
+
+        void readDynamicTables();
+
+        void readTrailer();
+
+        /// Decompresses at least some output into the window unless the stream is finished
+        void decompress();
+
+        void updateChecksum(const uint8_t *data, size_t size);
+
+    public:
+        /// @throws std::runtime_error if the zlib header is invalid
+        Inflater(const Source &source);
+
+        /**
+         @param output buffer for count decompressed bytes
+         @throws std::runtime_error if the stream is corrupted or ends before count bytes were produced
+         */
+        void read(uint8_t *output, size_t count);
+
+        /// @return true once the whole stream, including its checksum, was consumed
+        bool isFinished() const;
+    };
+
+}
+
+#endif /* Inflater_hpp */
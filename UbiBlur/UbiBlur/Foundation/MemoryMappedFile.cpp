@@ -0,0 +1,151 @@
+//
+//  MemoryMappedFile.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "MemoryMappedFile.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace Engine {
+
+#pragma mark - Lifecycle
+
+    MemoryMappedFile::MemoryMappedFile(const std::string &path) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize)) {
+            CloseHandle(file);
+            return;
+        }
+
+        mFileHandle = file;
+        mSize = size_t(fileSize.QuadPart);
+
+        // Zero-length files can't be mapped, but are valid nonetheless
+        if (mSize == 0) {
+            mIsOpen = true;
+            return;
+        }
+
+        mMappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mMappingHandle) {
+            close();
+            return;
+        }
+
+        mData = reinterpret_cast<const uint8_t *>(MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (!mData) {
+            close();
+            return;
+        }
+#else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            return;
+        }
+
+        struct stat info;
+        if (fstat(file, &info) != 0) {
+            ::close(file);
+            return;
+        }
+
+        mSize = size_t(info.st_size);
+
+        if (mSize > 0) {
+            void *mapping = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, file, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(file);
+                mSize = 0;
+                return;
+            }
+            mData = reinterpret_cast<const uint8_t *>(mapping);
+        }
+
+        // Mapping keeps its own reference to the file
+        ::close(file);
+#endif
+        mIsOpen = true;
+    }
+
+    MemoryMappedFile::~MemoryMappedFile() {
+        close();
+    }
+
+    MemoryMappedFile::MemoryMappedFile(MemoryMappedFile &&that) {
+        *this = std::move(that);
+    }
+
+    MemoryMappedFile &MemoryMappedFile::operator=(MemoryMappedFile &&rhs) {
+        if (this != &rhs) {
+            close();
+
+            std::swap(mData, rhs.mData);
+            std::swap(mSize, rhs.mSize);
+            std::swap(mIsOpen, rhs.mIsOpen);
+#ifdef _WIN32
+            std::swap(mFileHandle, rhs.mFileHandle);
+            std::swap(mMappingHandle, rhs.mMappingHandle);
+#endif
+        }
+        return *this;
+    }
+
+    void MemoryMappedFile::close() {
+#ifdef _WIN32
+        if (mData) {
+            UnmapViewOfFile(mData);
+        }
+        if (mMappingHandle) {
+            CloseHandle(mMappingHandle);
+        }
+        if (mFileHandle) {
+            CloseHandle(mFileHandle);
+        }
+        mFileHandle = nullptr;
+        mMappingHandle = nullptr;
+#else
+        if (mData) {
+            munmap(const_cast<uint8_t *>(mData), mSize);
+        }
+#endif
+        mData = nullptr;
+        mSize = 0;
+        mIsOpen = false;
+    }
+
+#pragma mark - Getters
+
+    bool MemoryMappedFile::isOpen() const {
+        return mIsOpen;
+    }
+
+    const uint8_t *MemoryMappedFile::data() const {
+        return mData;
+    }
+
+    size_t MemoryMappedFile::size() const {
+        return mSize;
+    }
+
+}
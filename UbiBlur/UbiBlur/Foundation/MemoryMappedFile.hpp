@@ -0,0 +1,61 @@
+//
+//  MemoryMappedFile.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef MemoryMappedFile_hpp
+#define MemoryMappedFile_hpp
+
+#include <string>
+#include <cstdint>
+#include <cstdio>
+
+namespace Engine {
+
+    /// Read-only view of a whole file mapped into the address space.
+    /// Pages are loaded by the OS on first access, nothing is copied into the process heap.
+    class MemoryMappedFile {
+    private:
+        const uint8_t *mData = nullptr;
+        size_t mSize = 0;
+        bool mIsOpen = false;
+
+#ifdef _WIN32
+        void *mFileHandle = nullptr;
+        void *mMappingHandle = nullptr;
+#endif
+
+        void close();
+
+    public:
+        MemoryMappedFile() = default;
+
+        /// Maps the file, check isOpen() to find out whether it succeeded
+        explicit MemoryMappedFile(const std::string &path);
+
+        ~MemoryMappedFile();
+
+        MemoryMappedFile(const MemoryMappedFile &that) = delete;
+
+        MemoryMappedFile &operator=(const MemoryMappedFile &rhs) = delete;
+
+        MemoryMappedFile(MemoryMappedFile &&that);
+
+        MemoryMappedFile &operator=(MemoryMappedFile &&rhs);
+
+        /// False if the file does not exist or could not be mapped
+        bool isOpen() const;
+
+        /// Start of the mapping, aligned to the page size. Null for empty files.
+        const uint8_t *data() const;
+
+        /// Size in bytes
+        size_t size() const;
+    };
+
+}
+
+#endif /* MemoryMappedFile_hpp */
@@ -5,6 +5,8 @@
 
 #include "MemoryUtils.hpp"
 
+#include <algorithm>
+
 namespace Engine {
     namespace Utils {
         namespace Memory {
@@ -16,6 +18,13 @@ namespace Engine {
                 return padding;
             }
 
+            void FlipRows(void *data, size_t rowByteCount, size_t rowCount) {
+                uint8_t *bytes = static_cast<uint8_t *>(data);
+                for (size_t top = 0, bottom = rowCount; top + 1 < bottom; top++, bottom--) {
+                    std::swap_ranges(bytes + top * rowByteCount, bytes + (top + 1) * rowByteCount, bytes + (bottom - 1) * rowByteCount);
+                }
+            }
+
         }
     }
 }
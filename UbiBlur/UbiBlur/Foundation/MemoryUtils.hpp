@@ -28,6 +28,13 @@ namespace Engine {
                 return Padding(sizeof(T), alignment);
             }
 
+            /// Reverses the order of rows of a tightly packed image in place.
+            /// Used instead of stb_image's global flip flag, which would race between concurrent decoders.
+            /// @param data first row of the image
+            /// @param rowByteCount size of a single row in bytes
+            /// @param rowCount number of rows
+            void FlipRows(void *data, size_t rowByteCount, size_t rowCount);
+
         }
     }
 }
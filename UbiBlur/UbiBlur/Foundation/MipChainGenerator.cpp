@@ -0,0 +1,265 @@
+//
+//  MipChainGenerator.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "MipChainGenerator.hpp"
+#include "ParallelUtils.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <array>
+#include <cmath>
+
+#include <glm/gtc/constants.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIP_CHAIN_GENERATOR_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Engine {
+
+    namespace {
+
+        /// Kaiser filter support in destination texels and its shape parameter
+        constexpr float KaiserRadius = 3.f;
+        constexpr float KaiserAlpha = 4.f;
+
+        constexpr size_t RowsPerRange = 16;
+
+        /// Source texels contributing to a single destination texel along one axis
+        struct FilterTaps {
+            size_t first = 0;
+            std::vector<float> weights;
+        };
+
+#pragma mark - Filter kernels
+
+        float Sinc(float x) {
+            if (std::fabs(x) < 1e-5f) {
+                return 1.f;
+            }
+            x *= glm::pi<float>();
+            return std::sin(x) / x;
+        }
+
+        /// Modified Bessel function of the first kind of order zero
+        float BesselI0(float x) {
+            float sum = 1.f;
+            float term = 1.f;
+            for (int k = 1; k < 32 && term > sum * 1e-8f; ++k) {
+                float factor = x / (2.f * k);
+                term *= factor * factor;
+                sum += term;
+            }
+            return sum;
+        }
+
+        float KaiserWindow(float x) {
+            if (std::fabs(x) >= 1.f) {
+                return 0.f;
+            }
+            return BesselI0(KaiserAlpha * std::sqrt(1.f - x * x)) / BesselI0(KaiserAlpha);
+        }
+
+        /// Taps for every destination texel, source texels beyond the edges are clamped to the edge
+        std::vector<FilterTaps> ComputeTaps(size_t sourceSize, size_t destinationSize, MipMapFilter filter) {
+            std::vector<FilterTaps> taps(destinationSize);
+            float scale = float(sourceSize) / float(destinationSize);
+
+            for (size_t i = 0; i < destinationSize; ++i) {
+                float begin = 0.f;
+                float end = 0.f;
+
+                if (filter == MipMapFilter::Box) {
+                    begin = i * scale;
+                    end = (i + 1) * scale;
+                } else {
+                    float center = (i + 0.5f) * scale;
+                    begin = center - KaiserRadius * scale;
+                    end = center + KaiserRadius * scale;
+                }
+
+                long firstSource = long(std::floor(begin));
+                long lastSource = long(std::ceil(end)) - 1;
+                size_t first = size_t(std::max(firstSource, 0L));
+                size_t last = size_t(std::min(lastSource, long(sourceSize) - 1));
+
+                FilterTaps &tap = taps[i];
+                tap.first = first;
+                tap.weights.assign(last - first + 1, 0.f);
+
+                float total = 0.f;
+                for (long j = firstSource; j <= lastSource; ++j) {
+                    float weight = 0.f;
+                    if (filter == MipMapFilter::Box) {
+                        weight = std::min(end, float(j + 1)) - std::max(begin, float(j));
+                    } else {
+                        float x = (j + 0.5f - (i + 0.5f) * scale) / scale;
+                        weight = Sinc(x) * KaiserWindow(x / KaiserRadius);
+                    }
+
+                    size_t clamped = size_t(std::min(std::max(j, 0L), long(sourceSize) - 1));
+                    tap.weights[clamped - first] += weight;
+                    total += weight;
+                }
+
+                for (float &weight : tap.weights) {
+                    weight /= total;
+                }
+            }
+
+            return taps;
+        }
+
+#pragma mark - Resampling
+
+        /// dst += weight * src for a single RGBA texel
+        inline void Accumulate(float *destination, const float *source, float weight) {
+#ifdef MIP_CHAIN_GENERATOR_SSE2
+            _mm_storeu_ps(destination, _mm_add_ps(_mm_loadu_ps(destination), _mm_mul_ps(_mm_set1_ps(weight), _mm_loadu_ps(source))));
+#else
+            for (size_t c = 0; c < 4; ++c) {
+                destination[c] += weight * source[c];
+            }
+#endif
+        }
+
+        void HorizontalPass(const std::vector<float> &source, size_t sourceWidth, size_t height,
+                            std::vector<float> &destination, size_t destinationWidth, MipMapFilter filter) {
+            std::vector<FilterTaps> taps = ComputeTaps(sourceWidth, destinationWidth, filter);
+            destination.assign(destinationWidth * height * 4, 0.f);
+
+            Utils::Parallel::For(height, RowsPerRange, [&](size_t begin, size_t end) {
+                for (size_t y = begin; y < end; ++y) {
+                    const float *sourceRow = source.data() + y * sourceWidth * 4;
+                    float *destinationRow = destination.data() + y * destinationWidth * 4;
+
+                    for (size_t x = 0; x < destinationWidth; ++x) {
+                        const FilterTaps &tap = taps[x];
+                        for (size_t k = 0; k < tap.weights.size(); ++k) {
+                            Accumulate(destinationRow + x * 4, sourceRow + (tap.first + k) * 4, tap.weights[k]);
+                        }
+                    }
+                }
+            });
+        }
+
+        void VerticalPass(const std::vector<float> &source, size_t width, size_t sourceHeight,
+                          std::vector<float> &destination, size_t destinationHeight, MipMapFilter filter) {
+            std::vector<FilterTaps> taps = ComputeTaps(sourceHeight, destinationHeight, filter);
+            destination.assign(width * destinationHeight * 4, 0.f);
+
+            Utils::Parallel::For(destinationHeight, RowsPerRange, [&](size_t begin, size_t end) {
+                for (size_t y = begin; y < end; ++y) {
+                    const FilterTaps &tap = taps[y];
+                    float *destinationRow = destination.data() + y * width * 4;
+
+                    // Whole source rows are accumulated at once, which keeps memory access sequential
+                    for (size_t k = 0; k < tap.weights.size(); ++k) {
+                        const float *sourceRow = source.data() + (tap.first + k) * width * 4;
+                        for (size_t x = 0; x < width; ++x) {
+                            Accumulate(destinationRow + x * 4, sourceRow + x * 4, tap.weights[k]);
+                        }
+                    }
+                }
+            });
+        }
+
+#pragma mark - Color conversion
+
+        float SRGBToLinear(float value) {
+            return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+
+        float LinearToSRGB(float value) {
+            return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+        }
+
+        std::vector<float> Decode(const uint8_t *pixels, size_t texelCount, bool gammaCorrect) {
+            std::array<float, 256> colorTable;
+            std::array<float, 256> alphaTable;
+            for (size_t i = 0; i < 256; ++i) {
+                alphaTable[i] = i / 255.f;
+                colorTable[i] = gammaCorrect ? SRGBToLinear(alphaTable[i]) : alphaTable[i];
+            }
+
+            std::vector<float> texels(texelCount * 4);
+            Utils::Parallel::For(texelCount, RowsPerRange * 1024, [&](size_t begin, size_t end) {
+                for (size_t i = begin * 4; i < end * 4; i += 4) {
+                    texels[i + 0] = colorTable[pixels[i + 0]];
+                    texels[i + 1] = colorTable[pixels[i + 1]];
+                    texels[i + 2] = colorTable[pixels[i + 2]];
+                    texels[i + 3] = alphaTable[pixels[i + 3]];
+                }
+            });
+            return texels;
+        }
+
+        void Encode(const std::vector<float> &texels, bool gammaCorrect, std::vector<uint8_t> &pixels) {
+            pixels.resize(texels.size());
+
+            Utils::Parallel::For(texels.size() / 4, RowsPerRange * 1024, [&](size_t begin, size_t end) {
+                for (size_t i = begin * 4; i < end * 4; ++i) {
+                    // Sinc lobes may overshoot the valid range
+                    float value = std::min(std::max(texels[i], 0.f), 1.f);
+                    if (gammaCorrect && i % 4 != 3) {
+                        value = LinearToSRGB(value);
+                    }
+                    pixels[i] = uint8_t(value * 255.f + 0.5f);
+                }
+            });
+        }
+
+    }
+
+#pragma mark - Public
+
+    size_t MipChainGenerator::LevelCount(size_t width, size_t height) {
+        size_t count = 1;
+        for (size_t size = std::max(width, height); size > 1; size /= 2) {
+            ++count;
+        }
+        return count;
+    }
+
+    void MipChainGenerator::LevelSize(size_t width, size_t height, size_t level, size_t &levelWidth, size_t &levelHeight) {
+        levelWidth = std::max(width >> level, size_t(1));
+        levelHeight = std::max(height >> level, size_t(1));
+    }
+
+    std::vector<MipChainGenerator::Level> MipChainGenerator::Generate(const uint8_t *pixels, size_t width, size_t height, const MipMapSettings &settings) {
+        if (!pixels || width == 0 || height == 0) {
+            throw std::invalid_argument("Mip chain generation requires a non-empty base level");
+        }
+
+        size_t levelCount = LevelCount(width, height);
+        std::vector<Level> levels(levelCount - 1);
+
+        std::vector<float> current = Decode(pixels, width * height, settings.gammaCorrect);
+        std::vector<float> intermediate;
+        std::vector<float> next;
+        size_t currentWidth = width;
+        size_t currentHeight = height;
+
+        for (size_t i = 1; i < levelCount; ++i) {
+            Level &level = levels[i - 1];
+            LevelSize(width, height, i, level.width, level.height);
+
+            HorizontalPass(current, currentWidth, currentHeight, intermediate, level.width, settings.filter);
+            VerticalPass(intermediate, level.width, currentHeight, next, level.height, settings.filter);
+            Encode(next, settings.gammaCorrect, level.pixels);
+
+            std::swap(current, next);
+            currentWidth = level.width;
+            currentHeight = level.height;
+        }
+
+        return levels;
+    }
+
+}
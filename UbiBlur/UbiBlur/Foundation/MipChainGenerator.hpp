@@ -0,0 +1,57 @@
+//
+//  MipChainGenerator.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef MipChainGenerator_hpp
+#define MipChainGenerator_hpp
+
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+
+namespace Engine {
+
+    enum class MipMapFilter {
+        /// Averages texels covered by the destination texel, cheapest but prone to aliasing
+        Box,
+        /// Kaiser-windowed sinc, keeps smaller levels sharper and suppresses aliasing better than the box filter
+        Kaiser
+    };
+
+    struct MipMapSettings {
+        MipMapFilter filter = MipMapFilter::Kaiser;
+        /// Treat RGB channels as sRGB encoded colors and filter them in linear space.
+        /// Should be disabled for non-color data such as normal or roughness maps. Alpha is always linear.
+        bool gammaCorrect = true;
+    };
+
+    /// Builds complete mip chains of RGBA8 images on the CPU.
+    /// Levels are filtered from the previous level kept in floating point, so rounding errors don't accumulate.
+    class MipChainGenerator {
+    public:
+        struct Level {
+            size_t width = 0;
+            size_t height = 0;
+            /// Tightly packed RGBA8 pixels
+            std::vector<uint8_t> pixels;
+        };
+
+        /// Number of levels including the base one, matches the chain glGenerateMipmap would produce
+        static size_t LevelCount(size_t width, size_t height);
+
+        static void LevelSize(size_t width, size_t height, size_t level, size_t &levelWidth, size_t &levelHeight);
+
+        /**
+         @param pixels tightly packed RGBA8 base level
+         @return levels from 1 down to 1x1, base level itself is not included
+         */
+        static std::vector<Level> Generate(const uint8_t *pixels, size_t width, size_t height, const MipMapSettings &settings = MipMapSettings());
+    };
+
+}
+
+#endif /* MipChainGenerator_hpp */
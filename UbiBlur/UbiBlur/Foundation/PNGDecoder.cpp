@@ -0,0 +1,401 @@
+//
+//  PNGDecoder.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "PNGDecoder.hpp"
+#include "StringUtils.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+
+namespace Engine {
+
+    namespace {
+
+        const std::array<uint8_t, 8> Signature{{ 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' }};
+
+        enum ColorType : uint8_t {
+            Gray = 0, RGB = 2, Palette = 3, GrayAlpha = 4, RGBA = 6
+        };
+
+        size_t SamplesPerPixel(uint8_t colorType) {
+            switch (colorType) {
+                case RGB: return 3;
+                case GrayAlpha: return 2;
+                case RGBA: return 4;
+                default: return 1;
+            }
+        }
+
+        bool IsValidBitDepth(uint8_t colorType, uint8_t bitDepth) {
+            switch (colorType) {
+                case Gray: return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8 || bitDepth == 16;
+                case Palette: return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8;
+                case RGB:
+                case GrayAlpha:
+                case RGBA: return bitDepth == 8 || bitDepth == 16;
+                default: return false;
+            }
+        }
+
+        bool HasType(const std::array<char, 4> &type, const char *name) {
+            return std::memcmp(type.data(), name, 4) == 0;
+        }
+
+        uint8_t Paeth(int a, int b, int c) {
+            int p = a + b - c;
+            int pa = std::abs(p - a);
+            int pb = std::abs(p - b);
+            int pc = std::abs(p - c);
+            if (pa <= pb && pa <= pc) return uint8_t(a);
+            if (pb <= pc) return uint8_t(b);
+            return uint8_t(c);
+        }
+
+    }
+
+#pragma mark - Lifecycle
+
+    PNGDecoder::PNGDecoder(const std::string &path)
+            :
+            mFile(path, std::ios::binary),
+            mPath(path) {
+
+        if (!mFile) {
+            throw std::runtime_error(string_format("Failed to open file for reading (%s)", path.c_str()));
+        }
+
+        std::array<uint8_t, 8> signature;
+        readBytes(signature.data(), signature.size());
+        if (signature != Signature) {
+            throw std::runtime_error(string_format("Not a PNG file (%s)", path.c_str()));
+        }
+
+        uint32_t length = 0;
+        std::array<char, 4> type;
+        readChunkHeader(length, type);
+        if (!HasType(type, "IHDR")) {
+            throw std::runtime_error(string_format("PNG file doesn't start with a header chunk (%s)", path.c_str()));
+        }
+        readImageHeader(length);
+
+        // Ancillary chunks other than transparency don't affect pixel values and are skipped
+        for (;;) {
+            readChunkHeader(length, type);
+
+            if (HasType(type, "IDAT")) {
+                mChunkRemaining = length;
+                break;
+            }
+
+            if (HasType(type, "PLTE")) {
+                readPalette(length);
+            } else if (HasType(type, "tRNS")) {
+                readTransparency(length);
+            } else if (HasType(type, "IEND")) {
+                throw std::runtime_error(string_format("PNG file has no image data (%s)", path.c_str()));
+            } else if (!(type[0] & 0x20)) {
+                throw std::runtime_error(string_format("PNG file contains unknown critical chunk %.4s (%s)", type.data(), path.c_str()));
+            } else {
+                mFile.seekg(length, std::ios::cur);
+            }
+
+            // Chunk checksum
+            mFile.seekg(4, std::ios::cur);
+        }
+
+        if (mColorType == Palette && mPalette.empty()) {
+            throw std::runtime_error(string_format("Palette PNG file has no palette (%s)", path.c_str()));
+        }
+
+        switch (mColorType) {
+            case Gray: mChannels = 1; break;
+            case RGB: mChannels = 3; break;
+            case Palette: mChannels = mHasColorKey ? 4 : 3; break;
+            case GrayAlpha: mChannels = 2; break;
+            default: mChannels = 4; break;
+        }
+
+        size_t rowBytes = (mWidth * SamplesPerPixel(mColorType) * mBitDepth + 7) / 8;
+        mRow.resize(rowBytes);
+        mPreviousRow.resize(rowBytes);
+
+        mInflater = std::make_unique<Inflater>([this](uint8_t *buffer, size_t capacity) {
+            return readImageData(buffer, capacity);
+        });
+    }
+
+#pragma mark - Chunks
+
+    void PNGDecoder::readBytes(uint8_t *bytes, size_t count) {
+        mFile.read(reinterpret_cast<char *>(bytes), count);
+        if (size_t(mFile.gcount()) != count) {
+            throw std::runtime_error(string_format("Unexpected end of PNG file (%s)", mPath.c_str()));
+        }
+    }
+
+    uint32_t PNGDecoder::readUInt32() {
+        std::array<uint8_t, 4> bytes;
+        readBytes(bytes.data(), bytes.size());
+        return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+    }
+
+    void PNGDecoder::readChunkHeader(uint32_t &length, std::array<char, 4> &type) {
+        length = readUInt32();
+        readBytes(reinterpret_cast<uint8_t *>(type.data()), type.size());
+    }
+
+    void PNGDecoder::readImageHeader(uint32_t length) {
+        if (length != 13) {
+            throw std::runtime_error(string_format("Invalid PNG header length (%s)", mPath.c_str()));
+        }
+
+        mWidth = readUInt32();
+        mHeight = readUInt32();
+
+        std::array<uint8_t, 5> fields;
+        readBytes(fields.data(), fields.size());
+        mBitDepth = fields[0];
+        mColorType = fields[1];
+
+        if (mWidth == 0 || mHeight == 0 || mWidth > 0x7FFFFFFF || mHeight > 0x7FFFFFFF) {
+            throw std::runtime_error(string_format("Invalid PNG image size %zux%zu (%s)", mWidth, mHeight, mPath.c_str()));
+        }
+
+        if (!IsValidBitDepth(mColorType, mBitDepth)) {
+            throw std::runtime_error(string_format("Invalid PNG color type %d with bit depth %d (%s)", mColorType, mBitDepth, mPath.c_str()));
+        }
+
+        if (fields[2] != 0 || fields[3] != 0) {
+            throw std::runtime_error(string_format("Unknown PNG compression or filter method (%s)", mPath.c_str()));
+        }
+
+        if (fields[4] != 0) {
+            throw std::runtime_error(string_format("Interlaced PNG images can't be decoded row by row (%s)", mPath.c_str()));
+        }
+
+        // Chunk checksum
+        mFile.seekg(4, std::ios::cur);
+    }
+
+    void PNGDecoder::readPalette(uint32_t length) {
+        if (length % 3 != 0 || length > 256 * 3) {
+            throw std::runtime_error(string_format("Invalid PNG palette length (%s)", mPath.c_str()));
+        }
+
+        mPalette.resize(length / 3);
+        for (auto &entry : mPalette) {
+            readBytes(entry.data(), 3);
+            entry[3] = 255;
+        }
+    }
+
+    void PNGDecoder::readTransparency(uint32_t length) {
+        std::vector<uint8_t> data(length);
+        readBytes(data.data(), data.size());
+
+        switch (mColorType) {
+            case Palette:
+                if (length > mPalette.size()) {
+                    throw std::runtime_error(string_format("PNG transparency doesn't match the palette (%s)", mPath.c_str()));
+                }
+                for (size_t i = 0; i < length; i++) {
+                    mPalette[i][3] = data[i];
+                }
+                mHasColorKey = true;
+                break;
+
+            case Gray:
+            case RGB: {
+                size_t samples = SamplesPerPixel(mColorType);
+                if (length != samples * 2) {
+                    throw std::runtime_error(string_format("Invalid PNG transparency length (%s)", mPath.c_str()));
+                }
+                for (size_t i = 0; i < samples; i++) {
+                    mColorKey[i] = uint16_t((data[i * 2] << 8) | data[i * 2 + 1]);
+                }
+                mHasColorKey = true;
+                break;
+            }
+
+            default:
+                // Images with an alpha channel can't have transparency chunks, ignore it like other decoders do
+                break;
+        }
+    }
+
+    size_t PNGDecoder::readImageData(uint8_t *buffer, size_t capacity) {
+        // Compressed stream may be split across any number of consecutive IDAT chunks
+        while (mChunkRemaining == 0) {
+            if (mIsDataExhausted) return 0;
+
+            mFile.seekg(4, std::ios::cur);
+
+            uint32_t length = 0;
+            std::array<char, 4> type;
+            readChunkHeader(length, type);
+            if (!HasType(type, "IDAT")) {
+                mIsDataExhausted = true;
+                return 0;
+            }
+            mChunkRemaining = length;
+        }
+
+        size_t count = std::min(capacity, mChunkRemaining);
+        readBytes(buffer, count);
+        mChunkRemaining -= count;
+        return count;
+    }
+
+#pragma mark - Rows
+
+    size_t PNGDecoder::bytesPerPixel() const {
+        return std::max(SamplesPerPixel(mColorType) * mBitDepth / 8, size_t(1));
+    }
+
+    void PNGDecoder::unfilterRow(uint8_t filter) {
+        size_t stride = bytesPerPixel();
+        size_t length = mRow.size();
+        uint8_t *row = mRow.data();
+        const uint8_t *previous = mPreviousRow.data();
+
+        switch (filter) {
+            case 0:
+                break;
+
+            case 1:
+                for (size_t i = stride; i < length; i++) row[i] += row[i - stride];
+                break;
+
+            case 2:
+                for (size_t i = 0; i < length; i++) row[i] += previous[i];
+                break;
+
+            case 3:
+                for (size_t i = 0; i < length; i++) {
+                    int left = i >= stride ? row[i - stride] : 0;
+                    row[i] += uint8_t((left + previous[i]) / 2);
+                }
+                break;
+
+            case 4:
+                for (size_t i = 0; i < length; i++) {
+                    int left = i >= stride ? row[i - stride] : 0;
+                    int upLeft = i >= stride ? previous[i - stride] : 0;
+                    row[i] += Paeth(left, previous[i], upLeft);
+                }
+                break;
+
+            default:
+                throw std::runtime_error(string_format("Invalid PNG filter type %d (%s)", filter, mPath.c_str()));
+        }
+    }
+
+    void PNGDecoder::convertRow(uint8_t *rgba) const {
+        const uint8_t *row = mRow.data();
+
+        if (mBitDepth == 8 && mColorType == RGBA) {
+            std::memcpy(rgba, row, mWidth * 4);
+            return;
+        }
+
+        // Samples narrower than a byte are packed starting from the most significant bit
+        auto sample = [&](size_t index) -> uint32_t {
+            switch (mBitDepth) {
+                case 16: return (uint32_t(row[index * 2]) << 8) | row[index * 2 + 1];
+                case 8: return row[index];
+                default: {
+                    size_t bit = index * mBitDepth;
+                    uint32_t shift = uint32_t(8 - mBitDepth - bit % 8);
+                    return (row[bit / 8] >> shift) & ((1u << mBitDepth) - 1);
+                }
+            }
+        };
+
+        // 16-bit samples keep their high byte, low bit depth gray is stretched to the full range
+        auto narrow = [&](uint32_t value) -> uint8_t {
+            if (mBitDepth == 16) return uint8_t(value >> 8);
+            if (mBitDepth == 8) return uint8_t(value);
+            return uint8_t(value * 255 / ((1u << mBitDepth) - 1));
+        };
+
+        for (size_t x = 0; x < mWidth; x++) {
+            uint8_t *pixel = rgba + x * 4;
+
+            switch (mColorType) {
+                case Gray: {
+                    uint32_t gray = sample(x);
+                    pixel[0] = pixel[1] = pixel[2] = narrow(gray);
+                    pixel[3] = mHasColorKey && gray == mColorKey[0] ? 0 : 255;
+                    break;
+                }
+
+                case RGB: {
+                    uint32_t r = sample(x * 3), g = sample(x * 3 + 1), b = sample(x * 3 + 2);
+                    pixel[0] = narrow(r);
+                    pixel[1] = narrow(g);
+                    pixel[2] = narrow(b);
+                    pixel[3] = mHasColorKey && r == mColorKey[0] && g == mColorKey[1] && b == mColorKey[2] ? 0 : 255;
+                    break;
+                }
+
+                case Palette: {
+                    uint32_t index = sample(x);
+                    if (index >= mPalette.size()) {
+                        throw std::runtime_error(string_format("PNG palette index out of range (%s)", mPath.c_str()));
+                    }
+                    std::memcpy(pixel, mPalette[index].data(), 4);
+                    break;
+                }
+
+                case GrayAlpha:
+                    pixel[0] = pixel[1] = pixel[2] = narrow(sample(x * 2));
+                    pixel[3] = narrow(sample(x * 2 + 1));
+                    break;
+
+                default:
+                    for (size_t c = 0; c < 4; c++) {
+                        pixel[c] = narrow(sample(x * 4 + c));
+                    }
+                    break;
+            }
+        }
+    }
+
+#pragma mark - Public
+
+    size_t PNGDecoder::width() const {
+        return mWidth;
+    }
+
+    size_t PNGDecoder::height() const {
+        return mHeight;
+    }
+
+    size_t PNGDecoder::channels() const {
+        return mChannels;
+    }
+
+    void PNGDecoder::readRow(uint8_t *rgba) {
+        if (mRowsRead == mHeight) {
+            throw std::runtime_error(string_format("All %zu rows of PNG image were already read (%s)", mHeight, mPath.c_str()));
+        }
+
+        std::swap(mRow, mPreviousRow);
+
+        uint8_t filter = 0;
+        mInflater->read(&filter, 1);
+        mInflater->read(mRow.data(), mRow.size());
+        unfilterRow(filter);
+        convertRow(rgba);
+
+        mRowsRead++;
+    }
+
+}
@@ -0,0 +1,95 @@
+//
+//  PNGDecoder.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef PNGDecoder_hpp
+#define PNGDecoder_hpp
+
+#include "Inflater.hpp"
+
+#include <vector>
+#include <array>
+#include <string>
+#include <fstream>
+#include <memory>
+#include <cstdint>
+
+namespace Engine {
+
+    /// Reads a PNG file row by row, top to bottom, converting every row to 8-bit RGBA.
+    /// Only the previous row and the decompression window are kept in memory, so images of any size
+    /// can be processed as long as the consumer doesn't need all rows at once.
+    /// All bit depths and color types are supported, interlaced images are not.
+    class PNGDecoder {
+    private:
+        std::ifstream mFile;
+        std::string mPath;
+        size_t mWidth = 0;
+        size_t mHeight = 0;
+        uint8_t mBitDepth = 0;
+        uint8_t mColorType = 0;
+        size_t mChannels = 0;
+        size_t mRowsRead = 0;
+
+        std::vector<std::array<uint8_t, 4>> mPalette;
+        bool mHasColorKey = false;
+        std::array<uint16_t, 3> mColorKey{};
+
+        /// Bytes of the current IDAT chunk not yet handed to the inflater
+        size_t mChunkRemaining = 0;
+        bool mIsDataExhausted = false;
+        std::unique_ptr<Inflater> mInflater;
+
+        std::vector<uint8_t> mRow;
+        std::vector<uint8_t> mPreviousRow;
+
+        void readBytes(uint8_t *bytes, size_t count);
+
+        uint32_t readUInt32();
+
+        void readChunkHeader(uint32_t &length, std::array<char, 4> &type);
+
+        void readImageHeader(uint32_t length);
+
+        void readPalette(uint32_t length);
+
+        void readTransparency(uint32_t length);
+
+        size_t readImageData(uint8_t *buffer, size_t capacity);
+
+        size_t bytesPerPixel() const;
+
+        void unfilterRow(uint8_t filter);
+
+        void convertRow(uint8_t *rgba) const;
+
+    public:
+        /// Reads everything up to the first image data chunk
+        /// @throws std::runtime_error if the file can't be opened, isn't a PNG or uses unsupported features
+        PNGDecoder(const std::string &path);
+
+        /// Inflater pulls data through a callback bound to this object, so it can't be copied or moved
+        PNGDecoder(const PNGDecoder &that) = delete;
+
+        PNGDecoder &operator=(const PNGDecoder &rhs) = delete;
+
+        size_t width() const;
+
+        size_t height() const;
+
+        /// Channel count of the source, 1 (gray), 2 (gray + alpha), 3 (RGB) or 4 (RGBA).
+        /// Palette transparency counts as an alpha channel, color keys only affect alpha of decoded rows.
+        size_t channels() const;
+
+        /// @param rgba buffer for width() RGBA pixels of the next row
+        /// @throws std::runtime_error if the image data is corrupted or all rows were already read
+        void readRow(uint8_t *rgba);
+    };
+
+}
+
+#endif /* PNGDecoder_hpp */
@@ -0,0 +1,246 @@
+//
+//  PNGEncoder.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "PNGEncoder.hpp"
+#include "CRC32.hpp"
+#include "Deflater.hpp"
+#include "StringUtils.hpp"
+
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+#include <fstream>
+#include <cstdlib>
+
+namespace Engine {
+
+    namespace {
+
+#pragma mark - Filtering
+
+        uint8_t Paeth(int a, int b, int c) {
+            int p = a + b - c;
+            int pa = std::abs(p - a);
+            int pb = std::abs(p - b);
+            int pc = std::abs(p - c);
+            if (pa <= pb && pa <= pc) return uint8_t(a);
+            if (pb <= pc) return uint8_t(b);
+            return uint8_t(c);
+        }
+
+        /// Applies all five PNG filters and keeps the one with the smallest sum of absolute residuals
+        void FilterRow(const uint8_t *row, const uint8_t *previousRow, size_t rowLength, size_t bytesPerPixel, uint8_t *output, std::vector<uint8_t> &scratch) {
+            constexpr size_t FilterCount = 5;
+            scratch.resize(rowLength * FilterCount);
+
+            size_t bestFilter = 0;
+            uint64_t bestScore = UINT64_MAX;
+
+            for (size_t filter = 0; filter < FilterCount; filter++) {
+                uint8_t *filtered = &scratch[filter * rowLength];
+                uint64_t score = 0;
+
+                for (size_t i = 0; i < rowLength; i++) {
+                    int left = i >= bytesPerPixel ? row[i - bytesPerPixel] : 0;
+                    int up = previousRow ? previousRow[i] : 0;
+                    int upLeft = previousRow && i >= bytesPerPixel ? previousRow[i - bytesPerPixel] : 0;
+
+                    uint8_t predictor = 0;
+                    switch (filter) {
+                        case 1: predictor = uint8_t(left); break;
+                        case 2: predictor = uint8_t(up); break;
+                        case 3: predictor = uint8_t((left + up) / 2); break;
+                        case 4: predictor = Paeth(left, up, upLeft); break;
+                        default: break;
+                    }
+
+                    filtered[i] = uint8_t(row[i] - predictor);
+                    score += uint64_t(std::abs(int(int8_t(filtered[i]))));
+                }
+
+                if (score < bestScore) {
+                    bestScore = score;
+                    bestFilter = filter;
+                }
+            }
+
+            output[0] = uint8_t(bestFilter);
+            std::copy_n(&scratch[bestFilter * rowLength], rowLength, output + 1);
+        }
+
+#pragma mark - Chunks
+
+        void WriteUInt32(std::vector<uint8_t> &output, uint32_t value) {
+            output.push_back(uint8_t(value >> 24));
+            output.push_back(uint8_t(value >> 16));
+            output.push_back(uint8_t(value >> 8));
+            output.push_back(uint8_t(value));
+        }
+
+        void WriteChunk(std::vector<uint8_t> &output, const char *type, const uint8_t *data, size_t size) {
+            WriteUInt32(output, uint32_t(size));
+
+            size_t crcBegin = output.size();
+            output.insert(output.end(), type, type + 4);
+            output.insert(output.end(), data, data + size);
+
+            // Checksum covers the chunk type and data, but not the length
+            WriteUInt32(output, rtcrc32(output.data() + crcBegin, output.size() - crcBegin));
+        }
+
+        void WriteChunk(std::vector<uint8_t> &output, const char *type, const std::vector<uint8_t> &data) {
+            WriteChunk(output, type, data.data(), data.size());
+        }
+
+        void ValidateImageLayout(size_t width, size_t height, size_t channels) {
+            if (width == 0 || height == 0) {
+                throw std::invalid_argument("PNG image size must not be zero");
+            }
+
+            if (channels < 1 || channels > 4) {
+                throw std::invalid_argument(string_format("PNG images can't have %zu channels", channels));
+            }
+        }
+
+        std::vector<uint8_t> ImageHeader(size_t width, size_t height, size_t channels) {
+            static const std::array<uint8_t, 5> ColorTypes{{ 0, 0, 4, 2, 6 }};
+
+            std::vector<uint8_t> header;
+            WriteUInt32(header, uint32_t(width));
+            WriteUInt32(header, uint32_t(height));
+            header.push_back(8);
+            header.push_back(ColorTypes[channels]);
+            // Deflate compression, adaptive filtering, no interlacing
+            header.push_back(0);
+            header.push_back(0);
+            header.push_back(0);
+            return header;
+        }
+
+        const std::vector<uint8_t> Signature{ 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+        /// Compressed data is split into chunks of this size while streaming
+        constexpr size_t StreamingChunkSize = 1 << 20;
+
+    }
+
+#pragma mark - Public
+
+    std::vector<uint8_t> PNGEncoder::Encode(const uint8_t *pixels, size_t width, size_t height, size_t channels, bool flipVertically) {
+        ValidateImageLayout(width, height, channels);
+
+        size_t rowLength = width * channels;
+        std::vector<uint8_t> filtered((rowLength + 1) * height);
+        std::vector<uint8_t> scratch;
+
+        const uint8_t *previousRow = nullptr;
+        for (size_t y = 0; y < height; y++) {
+            size_t sourceRow = flipVertically ? height - 1 - y : y;
+            const uint8_t *row = pixels + sourceRow * rowLength;
+            FilterRow(row, previousRow, rowLength, channels, &filtered[y * (rowLength + 1)], scratch);
+            previousRow = row;
+        }
+
+        Deflater deflater;
+        deflater.write(filtered.data(), filtered.size());
+        deflater.finish();
+
+        std::vector<uint8_t> png(Signature);
+        WriteChunk(png, "IHDR", ImageHeader(width, height, channels));
+        WriteChunk(png, "IDAT", deflater.output());
+        WriteChunk(png, "IEND", {});
+
+        return png;
+    }
+
+    void PNGEncoder::Write(const std::string &path, const uint8_t *pixels, size_t width, size_t height, size_t channels, bool flipVertically) {
+        std::vector<uint8_t> png = Encode(pixels, width, height, channels, flipVertically);
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error(string_format("Failed to open file for writing (%s)", path.c_str()));
+        }
+
+        file.write(reinterpret_cast<const char *>(png.data()), png.size());
+        if (!file) {
+            throw std::runtime_error(string_format("Failed to write PNG file (%s)", path.c_str()));
+        }
+    }
+
+#pragma mark - Row Encoder
+
+    PNGRowEncoder::PNGRowEncoder(const std::string &path, size_t width, size_t height, size_t channels)
+            :
+            mPath(path),
+            mWidth(width),
+            mHeight(height),
+            mChannels(channels) {
+
+        ValidateImageLayout(width, height, channels);
+
+        mFile.open(path, std::ios::binary);
+        if (!mFile) {
+            throw std::runtime_error(string_format("Failed to open file for writing (%s)", path.c_str()));
+        }
+
+        std::vector<uint8_t> prologue(Signature);
+        WriteChunk(prologue, "IHDR", ImageHeader(width, height, channels));
+        writeBytes(prologue);
+
+        mFilteredRow.resize(width * channels + 1);
+    }
+
+    void PNGRowEncoder::writeBytes(const std::vector<uint8_t> &bytes) {
+        mFile.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+        if (!mFile) {
+            throw std::runtime_error(string_format("Failed to write PNG file (%s)", mPath.c_str()));
+        }
+    }
+
+    void PNGRowEncoder::writeCompressedData(bool isFinal) {
+        std::vector<uint8_t> &compressed = mDeflater.output();
+        if (compressed.empty() || (!isFinal && compressed.size() < StreamingChunkSize)) {
+            return;
+        }
+
+        std::vector<uint8_t> chunk;
+        chunk.reserve(compressed.size() + 12);
+        WriteChunk(chunk, "IDAT", compressed);
+        compressed.clear();
+        writeBytes(chunk);
+    }
+
+    void PNGRowEncoder::writeRow(const uint8_t *row) {
+        if (mRowsWritten == mHeight) {
+            throw std::logic_error(string_format("PNG image only has %zu rows (%s)", mHeight, mPath.c_str()));
+        }
+
+        size_t rowLength = mWidth * mChannels;
+        FilterRow(row, mRowsWritten > 0 ? mPreviousRow.data() : nullptr, rowLength, mChannels, mFilteredRow.data(), mScratch);
+        mPreviousRow.assign(row, row + rowLength);
+        mRowsWritten++;
+
+        mDeflater.write(mFilteredRow.data(), mFilteredRow.size());
+        writeCompressedData(false);
+    }
+
+    void PNGRowEncoder::finish() {
+        if (mRowsWritten != mHeight) {
+            throw std::logic_error(string_format("Only %zu of %zu rows were written (%s)", mRowsWritten, mHeight, mPath.c_str()));
+        }
+
+        mDeflater.finish();
+        writeCompressedData(true);
+
+        std::vector<uint8_t> epilogue;
+        WriteChunk(epilogue, "IEND", {});
+        writeBytes(epilogue);
+        mFile.close();
+    }
+
+}
@@ -0,0 +1,72 @@
+//
+//  PNGEncoder.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef PNGEncoder_hpp
+#define PNGEncoder_hpp
+
+#include "Deflater.hpp"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <cstdio>
+
+namespace Engine {
+
+    /// Self-contained 8-bit PNG writer.
+    /// Rows are filtered adaptively and compressed with Deflater, which doesn't depend on zlib.
+    class PNGEncoder {
+    public:
+        /**
+         @param pixels interleaved 8-bit pixels, first row is the top one unless flipVertically is set
+         @param channels 1 (gray), 2 (gray + alpha), 3 (RGB) or 4 (RGBA)
+         @param flipVertically treat pixels as bottom-up rows, as returned by glReadPixels
+         @return contents of a PNG file
+         */
+        static std::vector<uint8_t> Encode(const uint8_t *pixels, size_t width, size_t height, size_t channels, bool flipVertically = false);
+
+        /// Encodes pixels and writes the result to the file at the given path
+        static void Write(const std::string &path, const uint8_t *pixels, size_t width, size_t height, size_t channels, bool flipVertically = false);
+    };
+
+    /// Writes a PNG file row by row, top to bottom. Only the previous row and the compression window
+    /// are kept in memory, compressed data goes to the file as it is produced.
+    class PNGRowEncoder {
+    private:
+        std::ofstream mFile;
+        std::string mPath;
+        size_t mWidth;
+        size_t mHeight;
+        size_t mChannels;
+        size_t mRowsWritten = 0;
+        std::vector<uint8_t> mPreviousRow;
+        std::vector<uint8_t> mFilteredRow;
+        std::vector<uint8_t> mScratch;
+        Deflater mDeflater;
+
+        void writeBytes(const std::vector<uint8_t> &bytes);
+
+        void writeCompressedData(bool isFinal);
+
+    public:
+        /// @param channels 1 (gray), 2 (gray + alpha), 3 (RGB) or 4 (RGBA)
+        /// @throws std::runtime_error if the file can't be created
+        PNGRowEncoder(const std::string &path, size_t width, size_t height, size_t channels);
+
+        /// @param row width * channels interleaved 8-bit samples
+        void writeRow(const uint8_t *row);
+
+        /// Completes the file, all rows have to be written by then
+        /// @throws std::logic_error if rows are missing
+        void finish();
+    };
+
+}
+
+#endif /* PNGEncoder_hpp */
@@ -0,0 +1,93 @@
+//
+//  ParallelUtils.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "ParallelUtils.hpp"
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <exception>
+
+namespace Engine {
+    namespace Utils {
+        namespace Parallel {
+
+            namespace {
+                thread_local bool IsWorkerThread = false;
+            }
+
+            WorkerScope::WorkerScope() : mWasWorker(IsWorkerThread) {
+                IsWorkerThread = true;
+            }
+
+            WorkerScope::~WorkerScope() {
+                IsWorkerThread = mWasWorker;
+            }
+
+            size_t ConcurrencyLevel() {
+                return std::max(std::thread::hardware_concurrency(), 1u);
+            }
+
+            void For(size_t count, size_t minItemsPerRange, const RangeClosure &closure) {
+                if (count == 0) {
+                    return;
+                }
+
+                minItemsPerRange = std::max(minItemsPerRange, size_t(1));
+                size_t rangeCount = std::min(ConcurrencyLevel(), (count + minItemsPerRange - 1) / minItemsPerRange);
+
+                // All cores are already busy with the enclosing computation
+                if (rangeCount <= 1 || IsWorkerThread) {
+                    closure(0, count);
+                    return;
+                }
+
+                size_t itemsPerRange = count / rangeCount;
+                size_t remainder = count % rangeCount;
+
+                std::vector<std::exception_ptr> exceptions(rangeCount);
+                std::vector<std::thread> workers;
+                workers.reserve(rangeCount - 1);
+
+                auto execute = [&](size_t rangeIndex, size_t begin, size_t end) {
+                    try {
+                        WorkerScope scope;
+                        closure(begin, end);
+                    } catch (...) {
+                        exceptions[rangeIndex] = std::current_exception();
+                    }
+                };
+
+                size_t begin = 0;
+                for (size_t i = 0; i < rangeCount; i++) {
+                    size_t end = begin + itemsPerRange + (i < remainder ? 1 : 0);
+
+                    // Last range is processed by the calling thread
+                    if (i == rangeCount - 1) {
+                        execute(i, begin, end);
+                    } else {
+                        workers.emplace_back(execute, i, begin, end);
+                    }
+
+                    begin = end;
+                }
+
+                for (auto &worker : workers) {
+                    worker.join();
+                }
+
+                for (auto &exception : exceptions) {
+                    if (exception) {
+                        std::rethrow_exception(exception);
+                    }
+                }
+            }
+
+        }
+    }
+}
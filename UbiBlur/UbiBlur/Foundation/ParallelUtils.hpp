@@ -0,0 +1,55 @@
+//
+//  ParallelUtils.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef ParallelUtils_hpp
+#define ParallelUtils_hpp
+
+#include <cstdio>
+#include <cstdint>
+#include <functional>
+
+namespace Engine {
+    namespace Utils {
+        namespace Parallel {
+
+            using RangeClosure = std::function<void(size_t begin, size_t end)>;
+
+            /// Number of worker threads parallel algorithms are allowed to occupy
+            /// @return hardware concurrency, at least 1
+            size_t ConcurrencyLevel();
+
+            /// Marks the calling thread as a worker of an enclosing parallel computation while the object lives.
+            /// ThreadPool workers and ranges of For() are marked, so nested For() calls don't multiply the thread count.
+            class WorkerScope {
+            private:
+                bool mWasWorker;
+
+            public:
+                WorkerScope();
+
+                ~WorkerScope();
+
+                WorkerScope(const WorkerScope &that) = delete;
+
+                WorkerScope &operator=(const WorkerScope &rhs) = delete;
+            };
+
+            /// Splits [0; count) into contiguous ranges and executes closure for each of them concurrently.
+            /// The calling thread participates in the work. Exceptions thrown by the closure are rethrown
+            /// on the calling thread after all ranges are finished.
+            /// Called from a worker thread the closure receives the whole range serially.
+            /// @param count number of items to process
+            /// @param minItemsPerRange lower bound for range length, prevents spawning threads for tiny workloads
+            /// @param closure function object receiving half-open [begin; end) ranges
+            void For(size_t count, size_t minItemsPerRange, const RangeClosure &closure);
+
+        }
+    }
+}
+
+#endif /* ParallelUtils_hpp */
@@ -0,0 +1,47 @@
+//
+//  ThreadPool.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace Engine {
+
+#pragma mark - Lifecycle
+
+    ThreadPool::ThreadPool(size_t threadCount) : mTasks(std::numeric_limits<size_t>::max()) {
+        threadCount = std::max(threadCount, size_t(1));
+        mWorkers.reserve(threadCount);
+
+        for (size_t i = 0; i < threadCount; ++i) {
+            mWorkers.emplace_back([this] {
+                Utils::Parallel::WorkerScope scope;
+                std::function<void()> task;
+                while (mTasks.pop(task)) {
+                    task();
+                }
+            });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        mTasks.close();
+
+        for (std::thread &worker : mWorkers) {
+            worker.join();
+        }
+    }
+
+#pragma mark - Getters
+
+    size_t ThreadPool::threadCount() const {
+        return mWorkers.size();
+    }
+
+}
@@ -0,0 +1,61 @@
+//
+//  ThreadPool.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include "BlockingQueue.hpp"
+#include "ParallelUtils.hpp"
+
+#include <thread>
+#include <vector>
+#include <future>
+#include <memory>
+#include <functional>
+#include <stdexcept>
+
+namespace Engine {
+
+    /// Fixed set of worker threads executing enqueued tasks in FIFO order.
+    /// Destruction waits until every task enqueued so far has been executed.
+    class ThreadPool {
+    private:
+        BlockingQueue<std::function<void()>> mTasks;
+        std::vector<std::thread> mWorkers;
+
+    public:
+        explicit ThreadPool(size_t threadCount = Utils::Parallel::ConcurrencyLevel());
+
+        ThreadPool(const ThreadPool &that) = delete;
+
+        ThreadPool &operator=(const ThreadPool &rhs) = delete;
+
+        ~ThreadPool();
+
+        /// Schedules function for execution on one of the workers
+        /// @return future receiving function's result or the exception it has thrown
+        template<typename Function>
+        auto enqueue(Function &&function) -> std::future<decltype(function())> {
+            using Result = decltype(function());
+
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+            std::future<Result> future = task->get_future();
+
+            if (!mTasks.push([task] { (*task)(); })) {
+                throw std::logic_error("Enqueueing a task into a thread pool which is shutting down");
+            }
+
+            return future;
+        }
+
+        size_t threadCount() const;
+    };
+
+}
+
+#endif /* ThreadPool_hpp */
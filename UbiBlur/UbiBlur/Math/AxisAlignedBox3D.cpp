@@ -10,9 +10,11 @@
 #include "AxisAlignedBox3D.hpp"
 
 #include <limits>
+#include <cmath>
 #include <glm/detail/func_geometric.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/vec4.hpp>
+#include <glm/common.hpp>
 #include <glm/gtx/transform.hpp>
 
 namespace Engine {
@@ -75,13 +77,13 @@ namespace Engine {
     }
 
     float AxisAlignedBox3D::smallestDimensionLength() const {
-        float minXY = std::min(fabs(max.x - min.x), fabs(max.y - min.y));
-        return std::min(fabs(max.z - min.z), minXY);
+        float minXY = std::min(std::fabs(max.x - min.x), std::fabs(max.y - min.y));
+        return std::min(std::fabs(max.z - min.z), minXY);
     }
 
     float AxisAlignedBox3D::largestDimensionLength() const {
-        float maxXY = std::max(fabs(max.x - min.x), fabs(max.y - min.y));
-        return std::max(fabs(max.z - min.z), maxXY);
+        float maxXY = std::max(std::fabs(max.x - min.x), std::fabs(max.y - min.y));
+        return std::max(std::fabs(max.z - min.z), maxXY);
     }
 
     glm::vec3 AxisAlignedBox3D::center() const {
@@ -121,13 +123,15 @@ namespace Engine {
     }
 
     AxisAlignedBox3D AxisAlignedBox3D::transformedBy(const glm::mat4 &m) const {
-        glm::vec4 newMin = {min.x, min.y, min.z, 1.0};
-        glm::vec4 newMax = {max.x, max.y, max.z, 1.0};
-        newMin = m * newMin;
-        newMax = m * newMax;
-        newMin /= newMin.w;
-        newMax /= newMax.w;
-        return {glm::vec3(newMin), glm::vec3(newMax)};
+        // Rotated min and max corners aren't extremes anymore, so all 8 corners are bounded
+        AxisAlignedBox3D box = MaximumReversed();
+        for (const glm::vec4 &corner : cornerPoints()) {
+            glm::vec4 transformed = m * corner;
+            glm::vec3 point = glm::vec3(transformed) / transformed.w;
+            box.min = glm::min(box.min, point);
+            box.max = glm::max(box.max, point);
+        }
+        return box;
     }
 
 }
@@ -0,0 +1,67 @@
+//
+//  Frustum.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "Frustum.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_access.hpp>
+
+namespace Engine {
+
+    Frustum::Frustum(const glm::mat4 &viewProjection) {
+        glm::vec4 x = glm::row(viewProjection, 0);
+        glm::vec4 y = glm::row(viewProjection, 1);
+        glm::vec4 z = glm::row(viewProjection, 2);
+        glm::vec4 w = glm::row(viewProjection, 3);
+
+        // Clip space point is inside when -w <= x, y, z <= w
+        planes[Left] = w + x;
+        planes[Right] = w - x;
+        planes[Bottom] = w + y;
+        planes[Top] = w - y;
+        planes[Near] = w + z;
+        planes[Far] = w - z;
+
+        for (glm::vec4 &plane : planes) {
+            float length = glm::length(glm::vec3(plane));
+            if (length > 0.f) {
+                plane /= length;
+            }
+        }
+    }
+
+    bool Frustum::intersects(const AxisAlignedBox3D &box) const {
+        glm::vec3 center = box.center();
+        glm::vec3 extent = (box.max - box.min) * 0.5f;
+
+        for (const glm::vec4 &plane : planes) {
+            glm::vec3 normal(plane);
+            // Projected radius of the box onto the plane normal
+            float radius = glm::dot(glm::abs(normal), extent);
+            if (glm::dot(normal, center) + plane.w + radius < 0.f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Frustum::contains(const AxisAlignedBox3D &box) const {
+        glm::vec3 center = box.center();
+        glm::vec3 extent = (box.max - box.min) * 0.5f;
+
+        for (const glm::vec4 &plane : planes) {
+            glm::vec3 normal(plane);
+            float radius = glm::dot(glm::abs(normal), extent);
+            if (glm::dot(normal, center) + plane.w - radius < 0.f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
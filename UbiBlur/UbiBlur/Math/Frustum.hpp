@@ -0,0 +1,48 @@
+//
+//  Frustum.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef Frustum_hpp
+#define Frustum_hpp
+
+#include "AxisAlignedBox3D.hpp"
+
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <array>
+
+namespace Engine {
+
+    struct Frustum {
+        enum Plane {
+            Left, Right, Bottom, Top, Near, Far, PlaneCount
+        };
+
+        /// xyz is a unit normal pointing inside, w is the distance term, so that dot(xyz, p) + w >= 0 for points inside
+        std::array<glm::vec4, PlaneCount> planes;
+
+        Frustum() = default;
+
+        /// Extracts planes from the rows of a view-projection matrix (Gribb, Hartmann 2001), in world space
+        explicit Frustum(const glm::mat4 &viewProjection);
+
+        /**
+         Conservative test, boxes near frustum edges that lie outside of it but cross
+         none of its planes individually are reported as intersecting
+
+         @return false if the box is entirely behind at least one of the planes
+         */
+        bool intersects(const AxisAlignedBox3D &box) const;
+
+        /// @return true if the box is entirely in front of every plane
+        bool contains(const AxisAlignedBox3D &box) const;
+    };
+
+}
+
+#endif /* Frustum_hpp */
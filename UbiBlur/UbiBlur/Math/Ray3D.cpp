@@ -0,0 +1,23 @@
+//
+//  Ray3D.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "Ray3D.hpp"
+
+#include <glm/geometric.hpp>
+
+namespace Engine {
+
+    Ray3D::Ray3D(const glm::vec3 &origin, const glm::vec3 &direction)
+            : origin(origin), direction(glm::normalize(direction)) {
+    }
+
+    glm::vec3 Ray3D::pointAt(float distance) const {
+        return origin + direction * distance;
+    }
+
+}
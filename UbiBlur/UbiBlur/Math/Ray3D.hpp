@@ -0,0 +1,31 @@
+//
+//  Ray3D.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef Ray3D_hpp
+#define Ray3D_hpp
+
+#include <glm/vec3.hpp>
+
+namespace Engine {
+
+    struct Ray3D {
+        glm::vec3 origin = glm::vec3(0.f);
+        /// Unit length, distances along the ray are then measured in world units
+        glm::vec3 direction = glm::vec3(0.f, 0.f, -1.f);
+
+        Ray3D() = default;
+
+        /// @param direction normalized on construction
+        Ray3D(const glm::vec3 &origin, const glm::vec3 &direction);
+
+        glm::vec3 pointAt(float distance) const;
+    };
+
+}
+
+#endif /* Ray3D_hpp */
@@ -0,0 +1,140 @@
+//
+//  PackedVertex1P2UV1QT.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "Vertices/PackedVertex1P2UV1QT.hpp"
+
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/geometric.hpp>
+
+#include <cmath>
+
+namespace Engine {
+
+    namespace {
+
+        /// Smallest magnitude of the real part, which keeps its sign representable in snorm16
+        const float QTangentBias = 1.f / 32767.f;
+
+        glm::vec3 AnyPerpendicular(const glm::vec3 &v) {
+            glm::vec3 axis = std::fabs(v.x) < 0.9f ? glm::vec3(1.f, 0.f, 0.f) : glm::vec3(0.f, 1.f, 0.f);
+            return glm::normalize(glm::cross(v, axis));
+        }
+
+        glm::i16vec4 EncodeTangentFrame(const glm::vec3 &normal, const glm::vec3 &tangent, const glm::vec3 &bitangent) {
+            float normalLength = glm::length(normal);
+            glm::vec3 N = normalLength > 0.f ? normal / normalLength : glm::vec3(0.f, 0.f, 1.f);
+
+            // Gram-Schmidt, meshes without texture coordinates come with no tangents at all
+            glm::vec3 T = tangent - N * glm::dot(N, tangent);
+            float tangentLength = glm::length(T);
+            T = tangentLength > 1e-6f ? T / tangentLength : AnyPerpendicular(N);
+
+            glm::vec3 B = glm::cross(N, T);
+            bool isMirrored = glm::dot(B, bitangent) < 0.f;
+
+            glm::quat q = glm::normalize(glm::quat_cast(glm::mat3(T, B, N)));
+
+            // q and -q are the same rotation, which frees the sign of w to carry handedness
+            if (q.w < 0.f) {
+                q = -q;
+            }
+
+            if (q.w < QTangentBias) {
+                float scale = std::sqrt(1.f - QTangentBias * QTangentBias);
+                q = glm::quat(QTangentBias, q.x * scale, q.y * scale, q.z * scale);
+            }
+
+            if (isMirrored) {
+                q = -q;
+            }
+
+            return glm::i16vec4(glm::packSnorm<int16_t>(glm::vec4(q.x, q.y, q.z, q.w)));
+        }
+
+        /// Flat ranges would divide by zero, any positive scale decodes such axis correctly
+        float SafeExtent(float extent) {
+            return extent > 0.f ? extent : 1.f;
+        }
+
+        glm::vec2 Scale(const glm::vec2 &min, const glm::vec2 &max) {
+            return glm::vec2(SafeExtent(max.x - min.x), SafeExtent(max.y - min.y));
+        }
+
+        glm::u16vec2 PackCoords(const glm::vec2 &coords, const glm::vec2 &min, const glm::vec2 &max) {
+            return glm::packUnorm<uint16_t>(glm::clamp((coords - min) / Scale(min, max), 0.f, 1.f));
+        }
+
+        glm::vec2 UnpackCoords(const glm::u16vec2 &coords, const glm::vec2 &min, const glm::vec2 &max) {
+            return min + glm::unpackUnorm<uint16_t, float>(coords) * Scale(min, max);
+        }
+
+    }
+
+#pragma mark - Ranges
+
+    PackedVertex1P2UV1QT::Ranges::Ranges(const Vertex1P1N2UV1T1BT *vertices, size_t vertexCount, const AxisAlignedBox3D &boundingBox)
+        : positions(boundingBox) {
+
+        if (vertexCount == 0) {
+            return;
+        }
+
+        textureCoordsMin = textureCoordsMax = glm::vec2(vertices[0].textureCoords);
+        lightmapCoordsMin = lightmapCoordsMax = vertices[0].lightmapCoords;
+
+        for (size_t i = 1; i < vertexCount; ++i) {
+            glm::vec2 textureCoords(vertices[i].textureCoords);
+            textureCoordsMin = glm::min(textureCoordsMin, textureCoords);
+            textureCoordsMax = glm::max(textureCoordsMax, textureCoords);
+            lightmapCoordsMin = glm::min(lightmapCoordsMin, vertices[i].lightmapCoords);
+            lightmapCoordsMax = glm::max(lightmapCoordsMax, vertices[i].lightmapCoords);
+        }
+    }
+
+    glm::vec3 PackedVertex1P2UV1QT::Ranges::positionScale() const {
+        glm::vec3 extent = positions.max - positions.min;
+        return glm::vec3(SafeExtent(extent.x), SafeExtent(extent.y), SafeExtent(extent.z));
+    }
+
+    glm::vec2 PackedVertex1P2UV1QT::Ranges::textureCoordsScale() const {
+        return Scale(textureCoordsMin, textureCoordsMax);
+    }
+
+    glm::vec2 PackedVertex1P2UV1QT::Ranges::lightmapCoordsScale() const {
+        return Scale(lightmapCoordsMin, lightmapCoordsMax);
+    }
+
+#pragma mark - Vertex
+
+    PackedVertex1P2UV1QT::PackedVertex1P2UV1QT(const Vertex1P1N2UV1T1BT &vertex, const Ranges &ranges) {
+        glm::vec3 relative = (glm::vec3(vertex.position) - ranges.positions.min) / ranges.positionScale();
+        position = glm::packUnorm<uint16_t>(glm::vec4(glm::clamp(relative, 0.f, 1.f), 1.f));
+        textureCoords = PackCoords(glm::vec2(vertex.textureCoords), ranges.textureCoordsMin, ranges.textureCoordsMax);
+        lightmapCoords = PackCoords(vertex.lightmapCoords, ranges.lightmapCoordsMin, ranges.lightmapCoordsMax);
+        tangentFrame = EncodeTangentFrame(vertex.normal, vertex.tangent, vertex.bitangent);
+    }
+
+    Vertex1P1N2UV1T1BT PackedVertex1P2UV1QT::unpacked(const Ranges &ranges) const {
+        glm::vec4 relative = glm::unpackUnorm<uint16_t, float>(position);
+        glm::vec4 frame = glm::unpackSnorm<int16_t, float>(tangentFrame);
+        glm::quat q = glm::normalize(glm::quat(frame.w, frame.x, frame.y, frame.z));
+
+        glm::vec3 T = q * glm::vec3(1.f, 0.f, 0.f);
+        glm::vec3 N = q * glm::vec3(0.f, 0.f, 1.f);
+        glm::vec3 B = glm::cross(N, T) * (frame.w < 0.f ? -1.f : 1.f);
+
+        glm::vec2 texCoords = UnpackCoords(textureCoords, ranges.textureCoordsMin, ranges.textureCoordsMax);
+
+        return Vertex1P1N2UV1T1BT(glm::vec4(ranges.positions.min + glm::vec3(relative) * ranges.positionScale(), 1.f),
+                glm::vec3(texCoords, 0.f),
+                UnpackCoords(lightmapCoords, ranges.lightmapCoordsMin, ranges.lightmapCoordsMax),
+                N, T, B);
+    }
+
+}
@@ -0,0 +1,66 @@
+//
+//  PackedVertex1P2UV1QT.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef PackedVertex1P2UV1QT_hpp
+#define PackedVertex1P2UV1QT_hpp
+
+#include "Vertices/Vertex1P1N2UV1T1BT.hpp"
+#include "AxisAlignedBox3D.hpp"
+
+#include <glm/gtc/type_precision.hpp>
+
+namespace Engine {
+
+    /**
+     Quantized counterpart of Vertex1P1N2UV1T1BT, 24 bytes instead of 72
+
+     1 position, 16-bit unsigned normalized relative to the mesh bounding box
+     2 uv channels, 16-bit unsigned normalized relative to the uv ranges of the mesh
+     1 tangent frame encoded as a 16-bit signed normalized quaternion (QTangent),
+       sign of the real part holds bitangent handedness
+     */
+    struct PackedVertex1P2UV1QT {
+        /// Per-mesh ranges the normalized attributes are decoded with, value = offset + normalized * scale
+        struct Ranges {
+            AxisAlignedBox3D positions;
+            glm::vec2 textureCoordsMin = glm::vec2(0.f);
+            glm::vec2 textureCoordsMax = glm::vec2(1.f);
+            glm::vec2 lightmapCoordsMin = glm::vec2(0.f);
+            glm::vec2 lightmapCoordsMax = glm::vec2(1.f);
+
+            Ranges() = default;
+
+            /// @param boundingBox box containing all the vertices, uv ranges are measured from the vertices themselves
+            Ranges(const Vertex1P1N2UV1T1BT *vertices, size_t vertexCount, const AxisAlignedBox3D &boundingBox);
+
+            glm::vec3 positionScale() const;
+
+            glm::vec2 textureCoordsScale() const;
+
+            glm::vec2 lightmapCoordsScale() const;
+        };
+
+        glm::u16vec4 position;
+        glm::u16vec2 textureCoords;
+        glm::u16vec2 lightmapCoords;
+        glm::i16vec4 tangentFrame;
+
+        PackedVertex1P2UV1QT() = default;
+
+        /// @param ranges ranges containing the vertex, attributes are quantized relative to them
+        PackedVertex1P2UV1QT(const Vertex1P1N2UV1T1BT &vertex, const Ranges &ranges);
+
+        /// Decodes the vertex back, tangent frame comes out orthonormal
+        Vertex1P1N2UV1T1BT unpacked(const Ranges &ranges) const;
+    };
+
+    static_assert(sizeof(PackedVertex1P2UV1QT) == 24, "Packed vertex is expected to be tightly packed");
+
+}
+
+#endif /* PackedVertex1P2UV1QT_hpp */
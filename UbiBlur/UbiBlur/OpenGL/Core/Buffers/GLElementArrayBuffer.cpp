@@ -0,0 +1,57 @@
+//
+//  GLElementArrayBuffer.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "GLElementArrayBuffer.hpp"
+
+#include <stdexcept>
+
+namespace Engine {
+
+#pragma mark - Lifecycle
+
+    GLElementArrayBuffer::GLElementArrayBuffer(const void *indices, uint64_t count, size_t indexSize, GLenum indexType)
+            : mIndexType(indexType), mSize(count * indexSize), mCount(count) {
+
+        if (count == 0) {
+            throw std::invalid_argument("Buffer size cannot be 0, though it can be constructed without any data");
+        }
+
+        glGenBuffers(1, &mName);
+        bind();
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mSize, indices, GL_STATIC_DRAW);
+    }
+
+    GLElementArrayBuffer::GLElementArrayBuffer(const GLushort *indices, uint64_t count)
+            : GLElementArrayBuffer(indices, count, sizeof(GLushort), GL_UNSIGNED_SHORT) {}
+
+    GLElementArrayBuffer::GLElementArrayBuffer(const GLuint *indices, uint64_t count)
+            : GLElementArrayBuffer(indices, count, sizeof(GLuint), GL_UNSIGNED_INT) {}
+
+    GLElementArrayBuffer::~GLElementArrayBuffer() {
+        glDeleteBuffers(1, &mName);
+    }
+
+#pragma mark - Getters
+
+    size_t GLElementArrayBuffer::size() const {
+        return mSize;
+    }
+
+    size_t GLElementArrayBuffer::count() const {
+        return mCount;
+    }
+
+    GLenum GLElementArrayBuffer::indexType() const {
+        return mIndexType;
+    }
+
+    void GLElementArrayBuffer::bind() const {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mName);
+    }
+
+}
@@ -9,19 +9,48 @@
 #ifndef GLElementArrayBuffer_hpp
 #define GLElementArrayBuffer_hpp
 
-#include "GLBuffer.hpp"
+#include "GLNamedObject.hpp"
+
+#include <cstdint>
+#include <cstdio>
 
 namespace Engine {
 
-    class GLElementArrayBuffer : public GLBuffer<GLushort> {
+    /// Index buffer holding either 16 or 32 bit indices, the type is remembered for draw calls
+    class GLElementArrayBuffer : public GLNamedObject {
+    private:
+        GLenum mIndexType = GL_UNSIGNED_SHORT;
+        size_t mSize = 0;
+        size_t mCount = 0;
+
+        GLElementArrayBuffer(const void *indices, uint64_t count, size_t indexSize, GLenum indexType);
+
     public:
-        template<template<class...> class ContinuousContainer>
-        static auto Create(const ContinuousContainer<GLushort> &indices) {
+        template<template<class...> class ContinuousContainer, typename Index>
+        static auto Create(const ContinuousContainer<Index> &indices) {
             return GLElementArrayBuffer(indices.data(), indices.size());
         }
 
-        GLElementArrayBuffer(const GLushort *indices, uint64_t count)
-                : GLBuffer<GLushort>(indices, count, GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW) {}
+        GLElementArrayBuffer(const GLushort *indices, uint64_t count);
+
+        GLElementArrayBuffer(const GLuint *indices, uint64_t count);
+
+        ~GLElementArrayBuffer() override;
+
+        GLElementArrayBuffer(GLElementArrayBuffer &&that) = default;
+
+        GLElementArrayBuffer &operator=(GLElementArrayBuffer &&rhs) = default;
+
+        /// Size in bytes
+        size_t size() const;
+
+        /// Number of stored indices
+        size_t count() const;
+
+        /// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+        GLenum indexType() const;
+
+        void bind() const;
     };
 
 }
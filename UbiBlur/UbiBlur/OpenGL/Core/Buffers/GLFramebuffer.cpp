@@ -12,6 +12,7 @@
 
 #include <array>
 #include <vector>
+#include <atomic>
 #include <stdexcept>
 
 namespace Engine {
@@ -91,6 +92,8 @@ namespace Engine {
 
         bind();
 
+        mStencilContents = 0;
+
         if (layer == AllLayers) {
             glFramebufferTexture(mBindingPoint, GL_DEPTH_ATTACHMENT, texture.name(), mipLevel);
         } else {
@@ -169,6 +172,7 @@ namespace Engine {
 		bind();
 		renderbuffer.bind();
 		glFramebufferRenderbuffer(mBindingPoint, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, renderbuffer.name());
+		mStencilContents = 0;
 	}
 
     void GLFramebuffer::detachTexture(const GLTexture &texture) {
@@ -243,6 +247,35 @@ namespace Engine {
         auto bitmask = static_cast<underlying>(bufferMask);
         bind();
         glClear(bitmask);
+
+        if ((bufferMask & UnderlyingBuffer::Stencil) == UnderlyingBuffer::Stencil) {
+            mStencilContents = 0;
+        }
+    }
+
+    uint64_t GLFramebuffer::stencilContents() const {
+        return mStencilContents;
+    }
+
+    void GLFramebuffer::setStencilContents(uint64_t contents) {
+        mStencilContents = contents;
+    }
+
+    uint64_t GLFramebuffer::MakeStencilContentsID() {
+        static std::atomic<uint64_t> LastID(0);
+        return ++LastID;
+    }
+
+    void GLFramebuffer::readPixels(const GLTexture &texture, const Rect2D &region, void *pixels) const {
+        auto attachmentIt = mTextureAttachmentMap.find(texture.name());
+        if (attachmentIt == mTextureAttachmentMap.end()) {
+            throw std::invalid_argument(string_format("Texture %d was never attached to the framebuffer, therefore cannot read from it.", texture.name()));
+        }
+
+        bind();
+        glReadBuffer(attachmentIt->second.glColorAttachment);
+        glReadPixels(GLint(region.origin.x), GLint(region.origin.y), GLsizei(region.size.width), GLsizei(region.size.height), GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        glReadBuffer(GL_NONE);
     }
 
 }
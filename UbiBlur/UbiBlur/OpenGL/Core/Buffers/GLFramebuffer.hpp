@@ -57,6 +57,8 @@ namespace Engine {
         std::unordered_set<GLenum> mAvailableAttachments;
         std::unordered_map<GLint, AttachmentMetadata> mTextureAttachmentMap;
         std::vector<GLenum> mDrawBuffers;
+        /// Identifies whatever was last written into the stencil buffer, zero while the contents are unknown
+        uint64_t mStencilContents = 0;
 
         void obtainHardwareLimits();
 
@@ -112,6 +114,24 @@ namespace Engine {
         void blit(const GLTexture &fromTexture, const GLTexture &toTexture, bool useLinearFilter = true);
 
         void clear(UnderlyingBuffer bufferMask);
+
+        /// Identifier passed to the last setStencilContents() call. Stencil clears and depth-stencil attachment
+        /// changes reset it to zero, the record lives and dies with this object rather than with its GL name
+        uint64_t stencilContents() const;
+
+        /// Call after writing into the stencil buffer, zero marks the contents as unknown
+        /// @param contents identifier obtained from MakeStencilContentsID()
+        void setStencilContents(uint64_t contents);
+
+        /// Unique across the process, never zero
+        static uint64_t MakeStencilContentsID();
+
+        /// Reads RGBA8 pixels of an attached texture. When a buffer is bound to GL_PIXEL_PACK_BUFFER
+        /// pixels is an offset into that buffer and the call returns without waiting for the GPU.
+        /// @param texture color attachment to read from
+        /// @param region area in pixels, origin is the bottom left corner
+        /// @param pixels destination memory or offset into the bound pixel pack buffer
+        void readPixels(const GLTexture &texture, const Rect2D &region, void *pixels) const;
     };
 
 }
@@ -0,0 +1,136 @@
+//
+//  GLReadbackRing.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "GLReadbackRing.hpp"
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+namespace Engine {
+
+    constexpr size_t GLReadbackRing::DefaultSlotCount;
+
+#pragma mark - Lifecycle
+
+    GLReadbackRing::GLReadbackRing(size_t slotCount) : mSlots(std::max(slotCount, size_t(1))) {
+        for (Slot &slot : mSlots) {
+            glGenBuffers(1, &slot.buffer);
+        }
+    }
+
+    GLReadbackRing::~GLReadbackRing() {
+        finish();
+
+        for (Slot &slot : mSlots) {
+            glDeleteBuffers(1, &slot.buffer);
+        }
+    }
+
+#pragma mark - Private helpers
+
+    bool GLReadbackRing::complete(Slot &slot, bool wait) {
+        constexpr GLuint64 OneSecond = 1000000000;
+
+        GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        while (wait && status == GL_TIMEOUT_EXPIRED) {
+            status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, OneSecond);
+        }
+
+        if (status == GL_TIMEOUT_EXPIRED) {
+            return false;
+        }
+
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+
+        if (status == GL_WAIT_FAILED) {
+            slot.promise.set_exception(std::make_exception_ptr(std::runtime_error("Waiting for readback fence failed")));
+            return true;
+        }
+
+        Result result;
+        result.width = slot.width;
+        result.height = slot.height;
+        result.pixels.resize(slot.width * slot.height * 4);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        void *mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, result.pixels.size(), GL_MAP_READ_BIT);
+
+        if (mapped) {
+            std::memcpy(result.pixels.data(), mapped, result.pixels.size());
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            slot.promise.set_value(std::move(result));
+        } else {
+            slot.promise.set_exception(std::make_exception_ptr(std::runtime_error("Failed to map pixel pack buffer")));
+        }
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return true;
+    }
+
+#pragma mark - Readback
+
+    std::future<GLReadbackRing::Result> GLReadbackRing::readAsync(const GLFramebuffer &framebuffer, const GLTexture &texture) {
+        return readAsync(framebuffer, texture, Rect2D(texture.size()));
+    }
+
+    std::future<GLReadbackRing::Result> GLReadbackRing::readAsync(const GLFramebuffer &framebuffer, const GLTexture &texture, const Rect2D &region) {
+        // Slots are used round robin and completed in order, so the oldest one is the next to reuse
+        if (mPendingSlots.size() == mSlots.size()) {
+            complete(mSlots[mPendingSlots.front()], true);
+            mPendingSlots.pop_front();
+        }
+
+        size_t slotIndex = mNextSlot;
+        mNextSlot = (mNextSlot + 1) % mSlots.size();
+
+        Slot &slot = mSlots[slotIndex];
+        slot.width = size_t(region.size.width);
+        slot.height = size_t(region.size.height);
+        slot.promise = std::promise<Result>();
+
+        size_t byteCount = slot.width * slot.height * 4;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        if (byteCount > slot.capacity) {
+            glBufferData(GL_PIXEL_PACK_BUFFER, byteCount, nullptr, GL_STREAM_READ);
+            slot.capacity = byteCount;
+        }
+
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        framebuffer.readPixels(texture, region, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        mPendingSlots.push_back(slotIndex);
+
+        return slot.promise.get_future();
+    }
+
+    size_t GLReadbackRing::poll() {
+        size_t fulfilled = 0;
+        while (!mPendingSlots.empty() && complete(mSlots[mPendingSlots.front()], false)) {
+            mPendingSlots.pop_front();
+            fulfilled++;
+        }
+        return fulfilled;
+    }
+
+    void GLReadbackRing::finish() {
+        while (!mPendingSlots.empty()) {
+            complete(mSlots[mPendingSlots.front()], true);
+            mPendingSlots.pop_front();
+        }
+    }
+
+    size_t GLReadbackRing::pendingCount() const {
+        return mPendingSlots.size();
+    }
+
+}
@@ -0,0 +1,89 @@
+//
+//  GLReadbackRing.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef GLReadbackRing_hpp
+#define GLReadbackRing_hpp
+
+#include "GLFramebuffer.hpp"
+
+#include <Rect2D.hpp>
+
+#include <vector>
+#include <deque>
+#include <future>
+#include <cstdint>
+
+namespace Engine {
+
+    /**
+     Reads framebuffer contents back to system memory without stalling the pipeline.
+     Each request copies pixels into one of several pixel pack buffers and is guarded by a fence,
+     so the GPU keeps rendering while the copy is in flight. Results are delivered through futures
+     which are fulfilled by poll() once the fence is signalled, usually one or two frames later.
+
+     All member functions must be called on the thread owning the GL context. Futures can be
+     waited on anywhere, but only poll(), finish() or a subsequent readAsync() fulfill them.
+     */
+    class GLReadbackRing {
+    public:
+        struct Result {
+            size_t width = 0;
+            size_t height = 0;
+            /// Tightly packed RGBA8 rows, first row is the bottom one of the requested region
+            std::vector<uint8_t> pixels;
+        };
+
+        static constexpr size_t DefaultSlotCount = 3;
+
+    private:
+        struct Slot {
+            GLuint buffer = 0;
+            size_t capacity = 0;
+            GLsync fence = nullptr;
+            size_t width = 0;
+            size_t height = 0;
+            std::promise<Result> promise;
+        };
+
+        std::vector<Slot> mSlots;
+        std::deque<size_t> mPendingSlots;
+        size_t mNextSlot = 0;
+
+        bool complete(Slot &slot, bool wait);
+
+    public:
+        /// @param slotCount number of readbacks allowed in flight before readAsync() has to wait for the oldest one
+        GLReadbackRing(size_t slotCount = DefaultSlotCount);
+
+        GLReadbackRing(const GLReadbackRing &that) = delete;
+
+        GLReadbackRing &operator=(const GLReadbackRing &rhs) = delete;
+
+        /// Waits for all pending readbacks so that their futures are fulfilled
+        ~GLReadbackRing();
+
+        /// Schedules a copy of the whole texture attached to the framebuffer
+        std::future<Result> readAsync(const GLFramebuffer &framebuffer, const GLTexture &texture);
+
+        /// Schedules a copy of the region of the texture attached to the framebuffer.
+        /// Blocks on the oldest pending readback if all slots are occupied.
+        std::future<Result> readAsync(const GLFramebuffer &framebuffer, const GLTexture &texture, const Rect2D &region);
+
+        /// Fulfills futures of readbacks that are already finished without blocking
+        /// @return number of fulfilled futures
+        size_t poll();
+
+        /// Blocks until every pending readback is finished and fulfilled
+        void finish();
+
+        size_t pendingCount() const;
+    };
+
+}
+
+#endif /* GLReadbackRing_hpp */
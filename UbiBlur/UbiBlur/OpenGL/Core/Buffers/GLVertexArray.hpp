@@ -26,6 +26,15 @@ namespace Engine {
         std::unique_ptr<GLVertexArrayBuffer<Vertex>> mVertexBuffer;
         std::unique_ptr<GLElementArrayBuffer> mIndexBuffer;
 
+        static void SetAttributePointer(GLuint location, const GLVertexAttribute &attribute, GLsizei stride, GLuint offset) {
+            const void *pointer = reinterpret_cast<void *>(offset);
+            if (attribute.isIntegral()) {
+                glVertexAttribIPointer(location, attribute.components, attribute.type, stride, pointer);
+            } else {
+                glVertexAttribPointer(location, attribute.components, attribute.type, attribute.normalized, stride, pointer);
+            }
+        }
+
         void hookUpBuffers(const GLVertexAttribute *attributes, size_t attributeCount) {
             bind();
             mVertexBuffer->bind();
@@ -38,7 +47,7 @@ namespace Engine {
             for (GLuint location = 0; location < attributeCount; location++) {
                 glEnableVertexAttribArray(location);
                 const GLVertexAttribute &attribute = attributes[location];
-                glVertexAttribPointer(location, attribute.components, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(offset));
+                SetAttributePointer(location, attribute, sizeof(Vertex), offset);
                 glVertexAttribDivisor(location, attribute.divisor);
                 offset += attribute.bytes;
             }
@@ -60,6 +69,14 @@ namespace Engine {
             hookUpBuffers(attributes, attributeCount);
         }
 
+        GLVertexArray(const Vertex *vertices, size_t vertexCount, const GLuint *indices, size_t indexCount, const GLVertexAttribute *attributes, size_t attributeCount)
+                : mVertexBuffer(std::make_unique<GLVertexArrayBuffer<Vertex>>(vertices, vertexCount)),
+                  mIndexBuffer(std::make_unique<GLElementArrayBuffer>(indices, indexCount)) {
+
+            glGenVertexArrays(1, &mName);
+            hookUpBuffers(attributes, attributeCount);
+        }
+
         ~GLVertexArray() override {
             glDeleteVertexArrays(1, &mName);
         }
@@ -92,7 +109,7 @@ namespace Engine {
                 }
 
                 glEnableVertexAttribArray(attribute.location);
-                glVertexAttribPointer(attribute.location, attribute.components, GL_FLOAT, GL_FALSE, sizeof(T), reinterpret_cast<void *>(offset));
+                SetAttributePointer(attribute.location, attribute, sizeof(T), offset);
                 glVertexAttribDivisor(attribute.location, attribute.divisor);
                 offset += attribute.bytes;
             }
@@ -26,6 +26,35 @@ namespace Engine {
             location(location) {
     }
 
+    GLVertexAttribute::GLVertexAttribute(GLint sizeInBytes, GLint componentCount, GLint divisor, GLint location, GLenum type, GLboolean normalized)
+            :
+            bytes(sizeInBytes),
+            components(componentCount),
+            divisor(divisor),
+            location(location),
+            type(type),
+            normalized(normalized) {
+    }
+
+    bool GLVertexAttribute::isIntegral() const {
+        if (normalized) {
+            return false;
+        }
+
+        switch (type) {
+            case GL_BYTE:
+            case GL_UNSIGNED_BYTE:
+            case GL_SHORT:
+            case GL_UNSIGNED_SHORT:
+            case GL_INT:
+            case GL_UNSIGNED_INT:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
     GLVertexAttribute GLVertexAttribute::UniqueAttribute(GLint sizeInBytes, GLint componentCount, GLint location) {
         return GLVertexAttribute(sizeInBytes, componentCount, 0, location);
     }
@@ -34,4 +63,8 @@ namespace Engine {
         return GLVertexAttribute(sizeInBytes, componentCount, 1, location);
     }
 
+    GLVertexAttribute GLVertexAttribute::PackedAttribute(GLint sizeInBytes, GLint componentCount, GLenum type, GLboolean normalized, GLint location) {
+        return GLVertexAttribute(sizeInBytes, componentCount, 0, location, type, normalized);
+    }
+
 }
@@ -20,11 +20,20 @@ namespace Engine {
         GLint bytes;
         GLint components;
         GLint divisor;
+        /// Type of every component as stored in the buffer
+        GLenum type = GL_FLOAT;
+        /// Whether integer components are mapped to [0, 1] or [-1, 1] when read by the shader
+        GLboolean normalized = GL_FALSE;
 
         GLVertexAttribute(GLint sizeInBytes, GLint componentCount);
 
         GLVertexAttribute(GLint sizeInBytes, GLint componentCount, GLint divisor, GLint location);
 
+        GLVertexAttribute(GLint sizeInBytes, GLint componentCount, GLint divisor, GLint location, GLenum type, GLboolean normalized);
+
+        /// Integer attributes which are not normalized reach the shader as integers and have to be declared as ivec/uvec there
+        bool isIntegral() const;
+
         /**
          Factory function providing attribute unique for every vertex (default OpenGL behaviour)
 
@@ -42,6 +51,17 @@ namespace Engine {
          @return attribute with divisor parameter set to 1
          */
         static GLVertexAttribute SharedAttribute(GLint sizeInBytes, GLint componentCount, GLint location = LocationAutomatic);
+
+        /**
+         Factory function providing per-vertex attribute stored in a non-float or normalized format
+
+         @param sizeInBytes attribute's size in bytes
+         @param componentCount number of attribute's components
+         @param type component type, e.g. GL_HALF_FLOAT or GL_UNSIGNED_SHORT
+         @param normalized whether integer components should be normalized
+         @return attribute with divisor parameter set to 0
+         */
+        static GLVertexAttribute PackedAttribute(GLint sizeInBytes, GLint componentCount, GLenum type, GLboolean normalized, GLint location = LocationAutomatic);
     };
 
 }
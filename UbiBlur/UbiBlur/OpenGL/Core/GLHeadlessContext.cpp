@@ -0,0 +1,237 @@
+//
+//  GLHeadlessContext.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "GLHeadlessContext.hpp"
+#include "StringUtils.hpp"
+
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+
+#if UBIBLUR_HAS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#if UBIBLUR_HAS_GLFW
+#include <glfw3.h>
+#endif
+
+#if !UBIBLUR_HAS_EGL && !UBIBLUR_HAS_GLFW
+#error "Headless context needs either EGL or GLFW"
+#endif
+
+namespace Engine {
+
+    GLHeadlessContext::Backend GLHeadlessContext::ActiveBackend = GLHeadlessContext::Backend::EGL;
+
+#if UBIBLUR_HAS_EGL
+
+    namespace {
+
+        bool HasExtension(const char *extensions, const char *name) {
+            if (!extensions) return false;
+
+            size_t length = std::strlen(name);
+            for (const char *position = std::strstr(extensions, name); position; position = std::strstr(position + length, name)) {
+                bool startsToken = position == extensions || position[-1] == ' ';
+                bool endsToken = position[length] == ' ' || position[length] == '\0';
+                if (startsToken && endsToken) return true;
+            }
+            return false;
+        }
+
+        EGLDisplay AcquireDisplay() {
+            const char *clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+            // Surfaceless platform doesn't need X11, Wayland or a DRM device
+            if (HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+                auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+                if (getPlatformDisplay) {
+                    EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+                    if (display != EGL_NO_DISPLAY) return display;
+                }
+            }
+
+            return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        }
+
+    }
+
+#endif
+
+#pragma mark - Lifecycle
+
+    GLHeadlessContext::GLHeadlessContext() {
+        try {
+            createEGLContext();
+        } catch (const std::runtime_error &) {
+            // Without a display a hidden window can't be created either, EGL failure is the one worth reporting
+            if (!UBIBLUR_HAS_GLFW || !IsDisplayAvailable()) {
+                throw;
+            }
+            createGLFWContext();
+        }
+
+        ActiveBackend = mBackend;
+    }
+
+    GLHeadlessContext::~GLHeadlessContext() {
+        release();
+    }
+
+#pragma mark - Private
+
+    bool GLHeadlessContext::IsDisplayAvailable() {
+#if defined(_WIN32)
+        return true;
+#else
+        const char *x11Display = std::getenv("DISPLAY");
+        const char *waylandDisplay = std::getenv("WAYLAND_DISPLAY");
+        return (x11Display && *x11Display) || (waylandDisplay && *waylandDisplay);
+#endif
+    }
+
+    void GLHeadlessContext::createEGLContext() {
+#if UBIBLUR_HAS_EGL
+        EGLDisplay display = AcquireDisplay();
+        if (display == EGL_NO_DISPLAY) {
+            throw std::runtime_error("Unable to acquire EGL display");
+        }
+
+        EGLint major = 0, minor = 0;
+        if (!eglInitialize(display, &major, &minor)) {
+            throw std::runtime_error(string_format("Unable to initialize EGL display. Error: 0x%x", eglGetError()));
+        }
+        mDisplay = display;
+        mBackend = Backend::EGL;
+
+        try {
+            if (!eglBindAPI(EGL_OPENGL_API)) {
+                throw std::runtime_error(string_format("EGL %d.%d doesn't support desktop OpenGL", major, minor));
+            }
+
+            bool surfaceless = HasExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+
+            const EGLint configAttributes[] = {
+                EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+                EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                EGL_RED_SIZE, 8,
+                EGL_GREEN_SIZE, 8,
+                EGL_BLUE_SIZE, 8,
+                EGL_ALPHA_SIZE, 8,
+                EGL_NONE
+            };
+
+            EGLConfig config = nullptr;
+            EGLint configCount = 0;
+            if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0) {
+                throw std::runtime_error("No suitable EGL config found");
+            }
+
+            if (!surfaceless) {
+                const EGLint surfaceAttributes[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+                mSurface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+                if (mSurface == EGL_NO_SURFACE) {
+                    throw std::runtime_error(string_format("Unable to create EGL pbuffer surface. Error: 0x%x", eglGetError()));
+                }
+            }
+
+            const EGLint contextAttributes[] = {
+                EGL_CONTEXT_MAJOR_VERSION_KHR, 4,
+                EGL_CONTEXT_MINOR_VERSION_KHR, 2,
+                EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+                EGL_NONE
+            };
+
+            mContext = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+            if (mContext == EGL_NO_CONTEXT) {
+                throw std::runtime_error(string_format("Unable to create OpenGL 4.2 core context. Error: 0x%x", eglGetError()));
+            }
+
+            EGLSurface surface = mSurface ? static_cast<EGLSurface>(mSurface) : EGL_NO_SURFACE;
+            if (!eglMakeCurrent(display, surface, surface, static_cast<EGLContext>(mContext))) {
+                throw std::runtime_error(string_format("Unable to make EGL context current. Error: 0x%x", eglGetError()));
+            }
+        } catch (...) {
+            release();
+            throw;
+        }
+#else
+        throw std::runtime_error("Built without EGL support");
+#endif
+    }
+
+    void GLHeadlessContext::createGLFWContext() {
+#if UBIBLUR_HAS_GLFW
+        if (!glfwInit()) {
+            throw std::runtime_error("Unable to initialize GLFW");
+        }
+
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+        mWindow = glfwCreateWindow(1, 1, "Headless", nullptr, nullptr);
+        if (!mWindow) {
+            glfwTerminate();
+            throw std::runtime_error("Unable to create OpenGL 4.2 core context");
+        }
+
+        mBackend = Backend::GLFW;
+        glfwMakeContextCurrent(mWindow);
+#else
+        throw std::runtime_error("Built without GLFW support");
+#endif
+    }
+
+    void GLHeadlessContext::release() {
+#if UBIBLUR_HAS_EGL
+        if (mDisplay) {
+            EGLDisplay display = static_cast<EGLDisplay>(mDisplay);
+            eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            if (mContext) eglDestroyContext(display, static_cast<EGLContext>(mContext));
+            if (mSurface) eglDestroySurface(display, static_cast<EGLSurface>(mSurface));
+            eglTerminate(display);
+
+            mContext = nullptr;
+            mSurface = nullptr;
+            mDisplay = nullptr;
+        }
+#endif
+
+#if UBIBLUR_HAS_GLFW
+        if (mWindow) {
+            glfwDestroyWindow(mWindow);
+            glfwTerminate();
+            mWindow = nullptr;
+        }
+#endif
+    }
+
+#pragma mark - Public
+
+    GLHeadlessContext::Backend GLHeadlessContext::backend() const {
+        return mBackend;
+    }
+
+    void *GLHeadlessContext::ProcAddress(const char *name) {
+        switch (ActiveBackend) {
+#if UBIBLUR_HAS_EGL
+            case Backend::EGL: return reinterpret_cast<void *>(eglGetProcAddress(name));
+#endif
+#if UBIBLUR_HAS_GLFW
+            case Backend::GLFW: return reinterpret_cast<void *>(glfwGetProcAddress(name));
+#endif
+            default: return nullptr;
+        }
+    }
+
+}
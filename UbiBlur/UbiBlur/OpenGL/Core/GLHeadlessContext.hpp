@@ -0,0 +1,76 @@
+//
+//  GLHeadlessContext.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef GLHeadlessContext_hpp
+#define GLHeadlessContext_hpp
+
+// EGL is the only way to get a context without a display server on Linux, Windows builds have no EGL
+#if !defined(UBIBLUR_HAS_EGL)
+#if defined(_WIN32)
+#define UBIBLUR_HAS_EGL 0
+#else
+#define UBIBLUR_HAS_EGL 1
+#endif
+#endif
+
+// Hidden GLFW window is the fallback when a display is available, GPU-less build hosts may not have GLFW at all
+#if !defined(UBIBLUR_HAS_GLFW)
+#define UBIBLUR_HAS_GLFW 1
+#endif
+
+struct GLFWwindow;
+
+namespace Engine {
+
+    /// OpenGL 4.2 core context that is not attached to any visible window.
+    /// Default framebuffer is either absent or 1x1, so all rendering must go into GLFramebuffers.
+    /// EGL surfaceless or pbuffer display is tried first, which works without a display server and on GPU-less hosts
+    /// with llvmpipe. A hidden GLFW window is only used when EGL is unavailable and a display is present.
+    class GLHeadlessContext {
+    public:
+        enum class Backend { EGL, GLFW };
+
+    private:
+        Backend mBackend = Backend::EGL;
+
+        void *mDisplay = nullptr;
+        void *mSurface = nullptr;
+        void *mContext = nullptr;
+        GLFWwindow *mWindow = nullptr;
+
+        /// Backend of the most recently created context, ProcAddress dispatches on it
+        static Backend ActiveBackend;
+
+        static bool IsDisplayAvailable();
+
+        void createEGLContext();
+
+        void createGLFWContext();
+
+        void release();
+
+    public:
+        /// Creates context and makes it current on the calling thread
+        /// @throws std::runtime_error if neither backend can provide a 4.2 core context
+        GLHeadlessContext();
+
+        GLHeadlessContext(const GLHeadlessContext &that) = delete;
+
+        GLHeadlessContext &operator=(const GLHeadlessContext &rhs) = delete;
+
+        ~GLHeadlessContext();
+
+        Backend backend() const;
+
+        /// Function loader suitable for gladLoadGLLoader
+        static void *ProcAddress(const char *name);
+    };
+
+}
+
+#endif /* GLHeadlessContext_hpp */
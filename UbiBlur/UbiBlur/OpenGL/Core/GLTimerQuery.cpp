@@ -0,0 +1,45 @@
+//
+//  GLTimerQuery.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "GLTimerQuery.hpp"
+
+namespace Engine {
+
+    GLTimerQuery::GLTimerQuery() {
+        glGenQueries(1, &mName);
+    }
+
+    GLTimerQuery::~GLTimerQuery() {
+        glDeleteQueries(1, &mName);
+    }
+
+    void GLTimerQuery::begin() const {
+        glBeginQuery(GL_TIME_ELAPSED, mName);
+    }
+
+    void GLTimerQuery::end() const {
+        glEndQuery(GL_TIME_ELAPSED);
+    }
+
+    bool GLTimerQuery::isResultAvailable() const {
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(mName, GL_QUERY_RESULT_AVAILABLE, &available);
+        return available == GL_TRUE;
+    }
+
+    uint64_t GLTimerQuery::elapsedNanoseconds() const {
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(mName, GL_QUERY_RESULT, &elapsed);
+        return elapsed;
+    }
+
+    double GLTimerQuery::elapsedMilliseconds() const {
+        return double(elapsedNanoseconds()) / 1e6;
+    }
+
+}
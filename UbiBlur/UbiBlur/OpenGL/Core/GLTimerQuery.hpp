@@ -0,0 +1,44 @@
+//
+//  GLTimerQuery.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef GLTimerQuery_hpp
+#define GLTimerQuery_hpp
+
+#include "GLNamedObject.hpp"
+
+#include <cstdint>
+
+namespace Engine {
+
+    /// Measures GPU time spent on commands issued between begin() and end()
+    class GLTimerQuery : public GLNamedObject {
+    public:
+        GLTimerQuery();
+
+        GLTimerQuery(GLTimerQuery &&that) = default;
+
+        GLTimerQuery &operator=(GLTimerQuery &&rhs) = default;
+
+        ~GLTimerQuery() override;
+
+        void begin() const;
+
+        void end() const;
+
+        bool isResultAvailable() const;
+
+        /// Blocks until the result is available
+        /// @return GPU time elapsed between begin() and end()
+        uint64_t elapsedNanoseconds() const;
+
+        double elapsedMilliseconds() const;
+    };
+
+}
+
+#endif /* GLTimerQuery_hpp */
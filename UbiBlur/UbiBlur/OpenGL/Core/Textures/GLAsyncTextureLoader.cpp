@@ -0,0 +1,220 @@
+//
+//  GLAsyncTextureLoader.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "GLAsyncTextureLoader.hpp"
+#include "MemoryUtils.hpp"
+
+#include <stb_image.h>
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <memory>
+
+namespace Engine {
+
+#pragma mark - Lifecycle
+
+    GLAsyncTextureLoader::GLAsyncTextureLoader(size_t decoderCount, const GLCompressedTextureCache *cache)
+        : mCache(cache), mDecoders(decoderCount) { }
+
+    GLAsyncTextureLoader::~GLAsyncTextureLoader() {
+        finish();
+
+        for (PixelBuffer &buffer : mIdleBuffers) {
+            if (buffer.fence) {
+                glDeleteSync(buffer.fence);
+            }
+            glDeleteBuffers(1, &buffer.name);
+        }
+    }
+
+#pragma mark - Private helpers
+
+    size_t GLAsyncTextureLoader::LevelCount(const Encoding &encoding, size_t width, size_t height) {
+        return encoding.mipMapped ? MipChainGenerator::LevelCount(width, height) : 1;
+    }
+
+    size_t GLAsyncTextureLoader::LevelByteCount(const Encoding &encoding, size_t width, size_t height) {
+        return encoding.blockCompressed
+            ? BlockCompressor::CompressedByteCount(encoding.blockFormat, width, height)
+            : width * height * 4;
+    }
+
+    GLAsyncTextureLoader::PixelBuffer GLAsyncTextureLoader::acquireBuffer(size_t byteCount) {
+        // Prefer the smallest idle buffer which is large enough and no longer read by the GPU
+        auto best = mIdleBuffers.end();
+        for (auto it = mIdleBuffers.begin(); it != mIdleBuffers.end(); ++it) {
+            if (it->capacity < byteCount) continue;
+            if (it->fence && glClientWaitSync(it->fence, 0, 0) == GL_TIMEOUT_EXPIRED) continue;
+            if (best == mIdleBuffers.end() || it->capacity < best->capacity) {
+                best = it;
+            }
+        }
+
+        PixelBuffer buffer;
+        if (best != mIdleBuffers.end()) {
+            buffer = *best;
+            mIdleBuffers.erase(best);
+        } else {
+            glGenBuffers(1, &buffer.name);
+        }
+
+        if (buffer.fence) {
+            glDeleteSync(buffer.fence);
+            buffer.fence = nullptr;
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.name);
+        if (buffer.capacity < byteCount) {
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, byteCount, nullptr, GL_STREAM_DRAW);
+            buffer.capacity = byteCount;
+        }
+
+        return buffer;
+    }
+
+    void GLAsyncTextureLoader::enqueue(const std::string &imagePath, const Encoding &encoding, Finalizer finalizer) {
+        int32_t width = 0;
+        int32_t height = 0;
+        int32_t components = 0;
+
+        if (!stbi_info(imagePath.c_str(), &width, &height, &components)) {
+            finalizer(Size2D(), std::make_exception_ptr(std::invalid_argument(string_format("Failed to load texture file (%s)", imagePath.c_str()))));
+            return;
+        }
+
+        GLint maxTextureSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+        if (width > maxTextureSize || height > maxTextureSize) {
+            finalizer(Size2D(), std::make_exception_ptr(std::invalid_argument(string_format("Image %s (%dx%d) exceeds maximum texture size (%d). Use TiledGaussianBlur to process it in parts.", imagePath.c_str(), width, height, maxTextureSize))));
+            return;
+        }
+
+        size_t byteCount = 0;
+        for (size_t level = 0; level < LevelCount(encoding, width, height); ++level) {
+            size_t levelWidth = 0;
+            size_t levelHeight = 0;
+            MipChainGenerator::LevelSize(width, height, level, levelWidth, levelHeight);
+            byteCount += LevelByteCount(encoding, levelWidth, levelHeight);
+        }
+        PixelBuffer buffer = acquireBuffer(byteCount);
+
+        // Buffer is known to be idle, so neither the old contents nor synchronization are needed
+        void *destination = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, byteCount,
+                                             GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (!destination) {
+            mIdleBuffers.push_back(buffer);
+            finalizer(Size2D(), std::make_exception_ptr(std::runtime_error(string_format("Failed to map pixel unpack buffer for %s", imagePath.c_str()))));
+            return;
+        }
+
+        Request request;
+        request.buffer = buffer;
+        request.size = Size2D(width, height);
+        request.finalizer = std::move(finalizer);
+        request.decoding = mDecoders.enqueue([imagePath, destination, width, height, encoding] {
+            int32_t decodedWidth = 0;
+            int32_t decodedHeight = 0;
+            int32_t decodedComponents = 0;
+            std::unique_ptr<stbi_uc, void (*)(void *)> pixelData(stbi_load(imagePath.c_str(), &decodedWidth, &decodedHeight, &decodedComponents, STBI_rgb_alpha), stbi_image_free);
+
+            if (!pixelData) {
+                throw std::invalid_argument(string_format("Failed to load texture file (%s)", imagePath.c_str()));
+            }
+
+            if (decodedWidth != width || decodedHeight != height) {
+                throw std::runtime_error(string_format("Texture file (%s) changed while being loaded", imagePath.c_str()));
+            }
+
+            Utils::Memory::FlipRows(pixelData.get(), size_t(width) * 4, height);
+
+            uint8_t *target = static_cast<uint8_t *>(destination);
+            auto writeLevel = [&](const uint8_t *pixels, size_t levelWidth, size_t levelHeight) {
+                if (encoding.blockCompressed) {
+                    BlockCompressor::Compress(encoding.blockFormat, pixels, levelWidth, levelHeight, target);
+                } else {
+                    memcpy(target, pixels, levelWidth * levelHeight * 4);
+                }
+                target += LevelByteCount(encoding, levelWidth, levelHeight);
+            };
+
+            writeLevel(pixelData.get(), width, height);
+
+            if (encoding.mipMapped) {
+                for (const MipChainGenerator::Level &level : MipChainGenerator::Generate(pixelData.get(), width, height, encoding.mipMapSettings)) {
+                    writeLevel(level.pixels.data(), level.width, level.height);
+                }
+            }
+        });
+
+        mRequests.push_back(std::move(request));
+    }
+
+    void GLAsyncTextureLoader::complete(Request &request) {
+        std::exception_ptr error;
+        try {
+            request.decoding.get();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, request.buffer.name);
+        if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_FALSE && !error) {
+            error = std::make_exception_ptr(std::runtime_error("Pixel unpack buffer contents were lost during decoding"));
+        }
+
+        if (error) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            request.finalizer(request.size, error);
+        } else {
+            request.finalizer(request.size, nullptr);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            request.buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        mIdleBuffers.push_back(request.buffer);
+    }
+
+#pragma mark - Loading
+
+    size_t GLAsyncTextureLoader::update() {
+        size_t completed = 0;
+
+        for (auto it = mRequests.begin(); it != mRequests.end();) {
+            if (it->decoding.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                ++it;
+                continue;
+            }
+
+            complete(*it);
+            it = mRequests.erase(it);
+            ++completed;
+        }
+
+        return completed;
+    }
+
+    void GLAsyncTextureLoader::finish() {
+        while (!mRequests.empty()) {
+            mRequests.front().decoding.wait();
+            complete(mRequests.front());
+            mRequests.pop_front();
+        }
+    }
+
+#pragma mark - Getters
+
+    size_t GLAsyncTextureLoader::pendingCount() const {
+        return mRequests.size();
+    }
+
+}
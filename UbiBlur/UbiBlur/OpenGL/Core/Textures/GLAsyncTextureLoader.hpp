@@ -0,0 +1,190 @@
+//
+//  GLAsyncTextureLoader.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef GLAsyncTextureLoader_hpp
+#define GLAsyncTextureLoader_hpp
+
+#include "GLTexture2D.hpp"
+#include "GLCompressedTextureCache.hpp"
+#include "StringUtils.hpp"
+#include "ThreadPool.hpp"
+#include "MipChainGenerator.hpp"
+
+#include <string>
+#include <memory>
+#include <future>
+#include <vector>
+#include <list>
+#include <functional>
+
+namespace Engine {
+
+    /**
+     Loads LDR images into textures without blocking the GL thread on decoding.
+
+     For every request the GL thread maps a pixel unpack buffer and hands the mapped memory to a
+     decoder thread, which writes RGBA8 pixels straight into it. Mip chains are generated and formats
+     with a BCn counterpart (see GLTexture::BlockCompressedFormat) are compressed by the decoder
+     thread as well, so the GL thread only issues copies. Meanwhile the GL thread keeps
+     rendering. update() picks up finished requests, unmaps their buffers and creates textures
+     sourcing pixels from them, so the copy happens on the GPU timeline. Unpack buffers are fenced
+     and reused once the GPU has consumed them.
+
+     With a GLCompressedTextureCache attached, images with an up-to-date cache entry skip decoding
+     entirely, and freshly loaded compressed textures are written to the cache.
+
+     All member functions must be called on the thread owning the GL context. Futures can be
+     waited on anywhere, but only update() or finish() fulfill them.
+     */
+    class GLAsyncTextureLoader {
+    public:
+        template<GLTexture::Normalized Format>
+        using TexturePointer = std::unique_ptr<GLNormalizedTexture2D<Format>>;
+
+    private:
+        /// Called on the GL thread with the unpack buffer bound, or with the error which prevented decoding
+        using Finalizer = std::function<void(const Size2D &size, std::exception_ptr error)>;
+
+        /// Layout of the unpack buffer written by decoder threads: every level of the chain, one after another
+        struct Encoding {
+            bool blockCompressed = false;
+            BlockCompressor::Format blockFormat = BlockCompressor::Format::BC1;
+            GLenum compressedFormat = 0;
+            bool mipMapped = false;
+            MipMapSettings mipMapSettings;
+        };
+
+        struct PixelBuffer {
+            GLuint name = 0;
+            size_t capacity = 0;
+            GLsync fence = nullptr;
+        };
+
+        struct Request {
+            PixelBuffer buffer;
+            Size2D size;
+            std::future<void> decoding;
+            Finalizer finalizer;
+        };
+
+        std::vector<PixelBuffer> mIdleBuffers;
+        std::list<Request> mRequests;
+        const GLCompressedTextureCache *mCache;
+        ThreadPool mDecoders;
+
+        PixelBuffer acquireBuffer(size_t byteCount);
+
+        static size_t LevelCount(const Encoding &encoding, size_t width, size_t height);
+
+        static size_t LevelByteCount(const Encoding &encoding, size_t width, size_t height);
+
+        void enqueue(const std::string &imagePath, const Encoding &encoding, Finalizer finalizer);
+
+        /// Creates the texture from the bound unpack buffer filled according to the encoding
+        template<GLTexture::Normalized Format>
+        static TexturePointer<Format> CreateTexture(const Size2D &size, const Encoding &encoding, Sampling::Filter filter, Sampling::WrapMode wrapMode) {
+            TexturePointer<Format> texture;
+            size_t offset = 0;
+            size_t levelCount = LevelCount(encoding, size.width, size.height);
+
+            for (size_t level = 0; level < levelCount; ++level) {
+                size_t width = 0;
+                size_t height = 0;
+                MipChainGenerator::LevelSize(size.width, size.height, level, width, height);
+                size_t byteCount = LevelByteCount(encoding, width, height);
+
+                // Pointers are offsets inside of the bound unpack buffer
+                const void *data = reinterpret_cast<const void *>(offset);
+                offset += byteCount;
+
+                if (level == 0) {
+                    texture = encoding.blockCompressed
+                        ? std::make_unique<GLNormalizedTexture2D<Format>>(size, encoding.compressedFormat, data, byteCount, filter, wrapMode)
+                        : std::make_unique<GLNormalizedTexture2D<Format>>(size, data, filter, wrapMode);
+                } else if (encoding.blockCompressed) {
+                    texture->setCompressedImage(level, Size2D(width, height), encoding.compressedFormat, data, byteCount);
+                } else {
+                    texture->setMipMapImage(level, Size2D(width, height), data);
+                }
+            }
+
+            return texture;
+        }
+
+        void complete(Request &request);
+
+    public:
+        /// @param cache optional cache of compressed textures, must outlive the loader
+        GLAsyncTextureLoader(size_t decoderCount = Utils::Parallel::ConcurrencyLevel(), const GLCompressedTextureCache *cache = nullptr);
+
+        GLAsyncTextureLoader(const GLAsyncTextureLoader &that) = delete;
+
+        GLAsyncTextureLoader &operator=(const GLAsyncTextureLoader &rhs) = delete;
+
+        /// Waits for all pending requests so that their futures are fulfilled
+        ~GLAsyncTextureLoader();
+
+        /// Starts loading an image. Only the image header is read on the calling thread.
+        /// @param generateMipMaps build the mip chain on decoder threads according to mipMapSettings
+        /// @return future receiving the texture after a subsequent update() or finish()
+        template<GLTexture::Normalized Format>
+        std::future<TexturePointer<Format>> load(const std::string &imagePath,
+                                                 Sampling::Filter filter = Sampling::Filter::Anisotropic,
+                                                 Sampling::WrapMode wrapMode = Sampling::WrapMode::Repeat,
+                                                 bool generateMipMaps = true,
+                                                 const MipMapSettings &mipMapSettings = MipMapSettings()) {
+
+            auto promise = std::make_shared<std::promise<TexturePointer<Format>>>();
+            std::future<TexturePointer<Format>> future = promise->get_future();
+
+            if (mCache) {
+                if (auto texture = mCache->load<Format>(imagePath, generateMipMaps, filter, wrapMode)) {
+                    promise->set_value(std::move(texture));
+                    return future;
+                }
+            }
+
+            Encoding encoding;
+            encoding.blockCompressed = GLTexture::BlockCompressedFormat(Format, encoding.blockFormat, encoding.compressedFormat);
+            encoding.mipMapped = generateMipMaps;
+            encoding.mipMapSettings = mipMapSettings;
+
+            const GLCompressedTextureCache *cache = mCache;
+            enqueue(imagePath, encoding, [=](const Size2D &size, std::exception_ptr error) {
+                if (error) {
+                    promise->set_exception(error);
+                    return;
+                }
+
+                try {
+                    TexturePointer<Format> texture = CreateTexture<Format>(size, encoding, filter, wrapMode);
+                    if (cache) {
+                        cache->store(imagePath, Format, generateMipMaps, *texture);
+                    }
+                    promise->set_value(std::move(texture));
+                } catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+            });
+
+            return future;
+        }
+
+        /// Uploads images whose decoding has finished, never blocks
+        /// @return number of fulfilled futures
+        size_t update();
+
+        /// Blocks until every pending request is decoded and uploaded
+        void finish();
+
+        size_t pendingCount() const;
+    };
+
+}
+
+#endif /* GLAsyncTextureLoader_hpp */
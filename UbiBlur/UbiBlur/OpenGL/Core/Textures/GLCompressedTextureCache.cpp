@@ -0,0 +1,221 @@
+//
+//  GLCompressedTextureCache.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "GLCompressedTextureCache.hpp"
+#include "StringUtils.hpp"
+
+#include <filesystem/path.h>
+
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+#include <type_traits>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+namespace Engine {
+
+    static const char EntryMagic[4] = {'U', 'B', 'T', 'C'};
+    static const uint32_t EntryVersion = 1;
+
+#pragma mark - File system helpers
+
+    static bool SourceStamp(const std::string &path, int64_t &modificationTime, int64_t &byteCount) {
+#ifdef _WIN32
+        struct _stat64 info;
+        if (_stat64(path.c_str(), &info) != 0) return false;
+#else
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) return false;
+#endif
+        modificationTime = int64_t(info.st_mtime);
+        byteCount = int64_t(info.st_size);
+        return true;
+    }
+
+    static void MakeDirectory(const std::string &path) {
+#ifdef _WIN32
+        _mkdir(path.c_str());
+#else
+        mkdir(path.c_str(), 0755);
+#endif
+    }
+
+    template<typename T>
+    static void WriteValue(std::ofstream &file, const T &value) {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    static void WriteString(std::ofstream &file, const std::string &string) {
+        WriteValue(file, uint32_t(string.size()));
+        file.write(string.data(), string.size());
+    }
+
+    template<typename T>
+    static bool ReadValue(std::ifstream &file, T &value) {
+        return bool(file.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+
+    static bool ReadString(std::ifstream &file, std::string &string, uint32_t maxLength) {
+        uint32_t length = 0;
+        if (!ReadValue(file, length) || length > maxLength) return false;
+        string.resize(length);
+        return bool(file.read(&string[0], length));
+    }
+
+#pragma mark - Lifecycle
+
+    GLCompressedTextureCache::GLCompressedTextureCache(const std::string &directory) : mDirectory(directory) {
+        MakeDirectory(mDirectory);
+
+        const char *renderer = reinterpret_cast<const char *>(glGetString(GL_RENDERER));
+        const char *version = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+        mDeviceIdentifier = std::string(renderer ? renderer : "") + " | " + std::string(version ? version : "");
+    }
+
+#pragma mark - Private helpers
+
+    std::string GLCompressedTextureCache::entryPath(const std::string &imagePath, GLTexture::Normalized format, bool mipMapped) const {
+        // FNV-1a keeps file names short and stable across runs
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : imagePath) {
+            hash ^= uint8_t(c);
+            hash *= 1099511628211ull;
+        }
+
+        auto formatIndex = static_cast<std::underlying_type<GLTexture::Normalized>::type>(format);
+        std::string fileName = string_format("%016llx_%d%s.texcache", (unsigned long long)hash, int(formatIndex), mipMapped ? "_mips" : "");
+        return (filesystem::path(mDirectory) / filesystem::path(fileName)).str();
+    }
+
+    bool GLCompressedTextureCache::read(const std::string &imagePath, GLTexture::Normalized format, bool mipMapped, std::vector<Level> &levels) const {
+        int64_t modificationTime = 0;
+        int64_t sourceByteCount = 0;
+        if (!SourceStamp(imagePath, modificationTime, sourceByteCount)) {
+            return false;
+        }
+
+        std::ifstream file(entryPath(imagePath, format, mipMapped), std::ios::binary);
+        if (!file) {
+            return false;
+        }
+
+        char magic[4] = {};
+        uint32_t version = 0;
+        int64_t entryModificationTime = 0;
+        int64_t entrySourceByteCount = 0;
+        uint32_t entryFormat = 0;
+        uint8_t entryMipMapped = 0;
+        std::string entryDevice;
+        std::string entryImagePath;
+        uint32_t levelCount = 0;
+
+        bool valid = file.read(magic, sizeof(magic)) &&
+                     std::equal(magic, magic + sizeof(magic), EntryMagic) &&
+                     ReadValue(file, version) && version == EntryVersion &&
+                     ReadValue(file, entryModificationTime) && entryModificationTime == modificationTime &&
+                     ReadValue(file, entrySourceByteCount) && entrySourceByteCount == sourceByteCount &&
+                     ReadValue(file, entryFormat) && entryFormat == uint32_t(format) &&
+                     ReadValue(file, entryMipMapped) && bool(entryMipMapped) == mipMapped &&
+                     ReadString(file, entryDevice, 4096) && entryDevice == mDeviceIdentifier &&
+                     ReadString(file, entryImagePath, 4096) && entryImagePath == imagePath &&
+                     ReadValue(file, levelCount) && levelCount > 0 && levelCount <= 32;
+
+        if (!valid) {
+            return false;
+        }
+
+        levels.resize(levelCount);
+        for (Level &level : levels) {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint32_t byteCount = 0;
+
+            if (!ReadValue(file, width) || !ReadValue(file, height) ||
+                !ReadValue(file, level.internalFormat) || !ReadValue(file, byteCount)) {
+                return false;
+            }
+
+            if (!GLTexture::IsCompressedFormatSupported(level.internalFormat)) {
+                return false;
+            }
+
+            level.size = Size2D(width, height);
+            level.data.resize(byteCount);
+            if (!file.read(reinterpret_cast<char *>(level.data.data()), byteCount)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+#pragma mark - Storing
+
+    bool GLCompressedTextureCache::store(const std::string &imagePath, GLTexture::Normalized format, bool mipMapped, const GLTexture &texture) const {
+        int64_t modificationTime = 0;
+        int64_t sourceByteCount = 0;
+        if (!texture.isCompressed() || !SourceStamp(imagePath, modificationTime, sourceByteCount)) {
+            return false;
+        }
+
+        std::string path = entryPath(imagePath, format, mipMapped);
+        std::string temporaryPath = path + ".tmp";
+
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                return false;
+            }
+
+            uint32_t levelCount = uint32_t(texture.mipMapCount()) + 1;
+
+            file.write(EntryMagic, sizeof(EntryMagic));
+            WriteValue(file, EntryVersion);
+            WriteValue(file, modificationTime);
+            WriteValue(file, sourceByteCount);
+            WriteValue(file, uint32_t(format));
+            WriteValue(file, uint8_t(mipMapped));
+            WriteString(file, mDeviceIdentifier);
+            WriteString(file, imagePath);
+            WriteValue(file, levelCount);
+
+            for (uint32_t i = 0; i < levelCount; ++i) {
+                GLenum internalFormat = 0;
+                std::vector<uint8_t> data = texture.compressedImage(i, internalFormat);
+                Size2D size = texture.mipMapSize(i);
+
+                WriteValue(file, uint32_t(size.width));
+                WriteValue(file, uint32_t(size.height));
+                WriteValue(file, internalFormat);
+                WriteValue(file, uint32_t(data.size()));
+                file.write(reinterpret_cast<const char *>(data.data()), data.size());
+            }
+
+            if (!file) {
+                return false;
+            }
+        }
+
+        // Readers never observe a partially written entry
+        std::remove(path.c_str());
+        return std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+    }
+
+#pragma mark - Getters
+
+    const std::string &GLCompressedTextureCache::directory() const {
+        return mDirectory;
+    }
+
+}
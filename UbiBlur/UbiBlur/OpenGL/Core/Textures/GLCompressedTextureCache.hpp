@@ -0,0 +1,76 @@
+//
+//  GLCompressedTextureCache.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef GLCompressedTextureCache_hpp
+#define GLCompressedTextureCache_hpp
+
+#include "GLTexture2D.hpp"
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace Engine {
+
+    /**
+     Persists textures in the compressed form produced by the driver, so that formats like
+     GLTexture::Normalized::RGBACompressedRGBAInput are compressed only once per source image.
+
+     Entries are keyed by source image path, its modification time and size, texture format and
+     presence of mip maps. They also record the GL renderer, because the compressed internal
+     format is chosen by the driver. Any mismatch makes the entry stale and it is rebuilt on store().
+     */
+    class GLCompressedTextureCache {
+    private:
+        struct Level {
+            Size2D size;
+            GLenum internalFormat = 0;
+            std::vector<uint8_t> data;
+        };
+
+        std::string mDirectory;
+        std::string mDeviceIdentifier;
+
+        std::string entryPath(const std::string &imagePath, GLTexture::Normalized format, bool mipMapped) const;
+
+        bool read(const std::string &imagePath, GLTexture::Normalized format, bool mipMapped, std::vector<Level> &levels) const;
+
+    public:
+        /// @param directory folder holding cache entries, created if missing
+        explicit GLCompressedTextureCache(const std::string &directory);
+
+        /// Creates a texture from a valid cache entry without decoding or compressing anything
+        /// @return nullptr if there is no up-to-date entry for the image
+        template<GLTexture::Normalized Format>
+        std::unique_ptr<GLNormalizedTexture2D<Format>> load(const std::string &imagePath,
+                                                            bool mipMapped = true,
+                                                            Sampling::Filter filter = Sampling::Filter::Anisotropic,
+                                                            Sampling::WrapMode wrapMode = Sampling::WrapMode::Repeat) const {
+            std::vector<Level> levels;
+            if (!read(imagePath, Format, mipMapped, levels)) {
+                return nullptr;
+            }
+
+            auto texture = std::make_unique<GLNormalizedTexture2D<Format>>(levels.front().size, nullptr, filter, wrapMode);
+            for (size_t i = 0; i < levels.size(); ++i) {
+                texture->setCompressedImage(i, levels[i].size, levels[i].internalFormat, levels[i].data.data(), levels[i].data.size());
+            }
+            return texture;
+        }
+
+        /// Writes compressed contents of the texture, including all of its mip maps
+        /// @return false if the texture is not compressed by the driver or the entry could not be written
+        bool store(const std::string &imagePath, GLTexture::Normalized format, bool mipMapped, const GLTexture &texture) const;
+
+        const std::string &directory() const;
+    };
+
+}
+
+#endif /* GLCompressedTextureCache_hpp */
@@ -11,6 +11,11 @@
 
 #include <cmath>
 #include <algorithm>
+#include <vector>
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
 
 namespace Engine {
 
@@ -134,6 +139,54 @@ namespace Engine {
         return textureSize.transformedBy(glm::vec2(std::pow(0.5, mipLevel)));
     }
 
+    bool GLTexture::BlockCompressedFormat(Normalized format, BlockCompressor::Format &blockFormat, GLenum &internalFormat) {
+        switch (format) {
+            case Normalized::RCompressedRGBAInput:
+                blockFormat = BlockCompressor::Format::BC4;
+                internalFormat = GL_COMPRESSED_RED_RGTC1;
+                break;
+            case Normalized::RGCompressedRGBAInput:
+                blockFormat = BlockCompressor::Format::BC5;
+                internalFormat = GL_COMPRESSED_RG_RGTC2;
+                break;
+            case Normalized::RGBCompressedRGBAInput:
+                blockFormat = BlockCompressor::Format::BC1;
+                internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+                break;
+            case Normalized::RGBACompressedRGBAInput:
+                blockFormat = BlockCompressor::Format::BC7;
+                internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
+                break;
+            default:
+                return false;
+        }
+
+        return IsCompressedFormatSupported(internalFormat);
+    }
+
+    bool GLTexture::IsCompressedFormatSupported(GLenum internalFormat) {
+        // RGTC and BPTC are core formats, but drivers are not required to enumerate them
+        switch (internalFormat) {
+            case GL_COMPRESSED_RED_RGTC1:
+            case GL_COMPRESSED_SIGNED_RED_RGTC1:
+            case GL_COMPRESSED_RG_RGTC2:
+            case GL_COMPRESSED_SIGNED_RG_RGTC2:
+            case GL_COMPRESSED_RGBA_BPTC_UNORM:
+            case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+            case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+            case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+                return true;
+            default:
+                break;
+        }
+
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &formatCount);
+        std::vector<GLint> formats(std::max(formatCount, 0));
+        glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+        return std::find(formats.begin(), formats.end(), GLint(internalFormat)) != formats.end();
+    }
+
     const Size2D &GLTexture::size() const {
         return mSize;
     }
@@ -165,4 +218,46 @@ namespace Engine {
         return {float(w), float(h)};
     }
 
+    bool GLTexture::isCompressed() const {
+        GLTextureUnitManager::Shared().bindTextureToActiveUnit(*this);
+        GLint compressed = GL_FALSE;
+        glGetTexLevelParameteriv(mBindingPoint, 0, GL_TEXTURE_COMPRESSED, &compressed);
+        return compressed == GL_TRUE;
+    }
+
+    std::vector<uint8_t> GLTexture::compressedImage(size_t mipLevel, GLenum &internalFormat) const {
+        GLTextureUnitManager::Shared().bindTextureToActiveUnit(*this);
+        GLint format = 0;
+        GLint byteCount = 0;
+        glGetTexLevelParameteriv(mBindingPoint, GLint(mipLevel), GL_TEXTURE_INTERNAL_FORMAT, &format);
+        glGetTexLevelParameteriv(mBindingPoint, GLint(mipLevel), GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &byteCount);
+
+        std::vector<uint8_t> data(byteCount);
+        glGetCompressedTexImage(mBindingPoint, GLint(mipLevel), data.data());
+
+        internalFormat = GLenum(format);
+        return data;
+    }
+
+    void GLTexture::setCompressedImage(size_t mipLevel, const Size2D &size, GLenum internalFormat, const void *data, size_t byteCount) {
+        GLTextureUnitManager::Shared().bindTextureToActiveUnit(*this);
+        glCompressedTexImage2D(mBindingPoint, GLint(mipLevel), internalFormat, GLsizei(size.width), GLsizei(size.height), 0, GLsizei(byteCount), data);
+
+        if (mipLevel == 0) {
+            mSize = size;
+        } else {
+            registerMipLevel(mipLevel);
+        }
+    }
+
+    void GLTexture::registerMipLevel(size_t mipLevel) {
+        if (mipLevel <= mMipMapsCount) {
+            return;
+        }
+
+        mMipMapsCount = uint16_t(mipLevel);
+        glTexParameteri(mBindingPoint, GL_TEXTURE_MAX_LEVEL, GLint(mipLevel));
+        setFilter(Sampling::Filter::Trilinear);
+    }
+
 }
@@ -14,10 +14,14 @@
 #include "Color.hpp"
 #include "GLTextureFormat.hpp"
 #include "Sampling.hpp"
+#include "BlockCompressor.hpp"
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
+#include <vector>
+#include <cstdint>
+
 namespace Engine {
 
     class GLTexture : public GLNamedObject {
@@ -57,6 +61,9 @@ namespace Engine {
 
         void setComparisonMode(Sampling::ComparisonMode comparisonMode);
 
+        /// Extends the mip chain after a level was specified explicitly rather than generated by the driver
+        void registerMipLevel(size_t mipLevel);
+
         static constexpr GLTextureFormat glFormat(Depth format) {
             switch (format) {
                 case Depth::Default:
@@ -86,6 +93,12 @@ namespace Engine {
             }
         }
 
+        /// Explicit BCn format used instead of the generic driver compression of *CompressedRGBAInput formats
+        /// @return false if the format is not compressed or the driver does not support its BCn counterpart
+        static bool BlockCompressedFormat(Normalized format, BlockCompressor::Format &blockFormat, GLenum &internalFormat);
+
+        static bool IsCompressedFormatSupported(GLenum internalFormat);
+
         static constexpr GLTextureFormat glFormat(Integer format) {
             switch (format) {
                 case Integer::R32UI:
@@ -149,6 +162,17 @@ namespace Engine {
         void generateMipMaps(size_t count = 1000);
 
         Size2D mipMapSize(size_t mipLevel) const;
+
+        /// Whether the driver stores the base level in a compressed internal format
+        bool isCompressed() const;
+
+        /// Reads back compressed data of a mip level exactly as the driver stores it
+        /// @param internalFormat receives the specific compressed format chosen by the driver
+        std::vector<uint8_t> compressedImage(size_t mipLevel, GLenum &internalFormat) const;
+
+        /// Replaces a mip level with precompressed data, the inverse of compressedImage().
+        /// Specifying levels above the current mip map count extends the mip chain.
+        void setCompressedImage(size_t mipLevel, const Size2D &size, GLenum internalFormat, const void *data, size_t byteCount);
     };
 
 }
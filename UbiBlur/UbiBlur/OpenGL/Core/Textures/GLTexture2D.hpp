@@ -10,6 +10,7 @@
 #define GLTexture2D_hpp
 
 #include "GLTexture.hpp"
+#include "GLTextureUnitManager.hpp"
 
 namespace Engine {
 
@@ -30,9 +31,41 @@ namespace Engine {
             setWrapMode(wrapMode);
         }
 
+        void initializeCompressed(const Size2D &size, Sampling::Filter filter, Sampling::WrapMode wrapMode,
+                                  GLenum internalFormat, const void *data, size_t byteCount) {
+            if (size.width <= 0.0 || size.height <= 0.0) {
+                throw std::invalid_argument("Texture size must not be zero");
+            }
+
+            mSize = size;
+            glCompressedTexImage2D(GL_TEXTURE_2D, 0, internalFormat, size.width, size.height, 0, GLsizei(byteCount), data);
+
+            setFilter(filter);
+            setWrapMode(wrapMode);
+        }
+
     public:
         GLTexture2D() : GLTexture(GL_TEXTURE_2D) {};
 
+        /// Replaces contents of the base mip level
+        /// @param pixelData pixels matching texture's size and input format of the texture
+        void upload(const void *pixelData) {
+            constexpr GLTextureFormat f = glFormat(Format);
+
+            GLTextureUnitManager::Shared().bindTextureToActiveUnit(*this);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, this->mSize.width, this->mSize.height, f.inputPixelFormat, f.inputPixelType, pixelData);
+        }
+
+        /// Specifies a mip level explicitly, e.g. one produced by MipChainGenerator
+        /// @param pixelData pixels of the level in the input format of the texture
+        void setMipMapImage(size_t mipLevel, const Size2D &size, const void *pixelData) {
+            constexpr GLTextureFormat f = glFormat(Format);
+
+            GLTextureUnitManager::Shared().bindTextureToActiveUnit(*this);
+            glTexImage2D(GL_TEXTURE_2D, GLint(mipLevel), f.internalFormat, size.width, size.height, 0, f.inputPixelFormat, f.inputPixelType, pixelData);
+            this->registerMipLevel(mipLevel);
+        }
+
         virtual ~GLTexture2D() = 0;
     };
 
@@ -50,6 +83,16 @@ namespace Engine {
             this->initialize(size, filter, wrapMode, data);
         }
 
+        /// Creates texture from precompressed base level, see BlockCompressor
+        GLNormalizedTexture2D(const Size2D &size,
+                GLenum compressedInternalFormat,
+                const void *compressedData,
+                size_t byteCount,
+                Sampling::Filter filter = Sampling::Filter::Bilinear,
+                Sampling::WrapMode wrapMode = Sampling::WrapMode::ClampToEdge) {
+            this->initializeCompressed(size, filter, wrapMode, compressedInternalFormat, compressedData, byteCount);
+        }
+
         ~GLNormalizedTexture2D() = default;
     };
 
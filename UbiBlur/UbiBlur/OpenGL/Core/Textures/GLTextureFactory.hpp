@@ -11,10 +11,13 @@
 
 #include "GLTexture2D.hpp"
 #include "StringUtils.hpp"
+#include "MipChainGenerator.hpp"
+#include "MemoryUtils.hpp"
 
 #include <string>
 #include <memory>
 #include <array>
+#include <vector>
 
 #include <stb_image.h>
 
@@ -23,23 +26,62 @@ namespace Engine {
     class GLTextureFactory {
     public:
 
+        /// @param generateMipMaps build the mip chain on the CPU and upload it along with the base level
         template<GLTexture::Normalized Format>
-        static std::unique_ptr<GLNormalizedTexture2D<Format>> LoadLDRImage(const std::string &imagePath) {
+        static std::unique_ptr<GLNormalizedTexture2D<Format>> LoadLDRImage(const std::string &imagePath,
+                                                                           bool generateMipMaps = false,
+                                                                           const MipMapSettings &mipMapSettings = MipMapSettings()) {
 
             int32_t width = 0;
             int32_t height = 0;
             int32_t components = 0;
-            stbi_set_flip_vertically_on_load(true);
             stbi_uc *pixelData = stbi_load(imagePath.c_str(), &width, &height, &components, STBI_rgb_alpha);
 
             if (!pixelData) {
                 throw std::invalid_argument(string_format("Failed to load texture file (%s)", imagePath.c_str()));
             }
 
+            GLint maxTextureSize = 0;
+            glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+            if (width > maxTextureSize || height > maxTextureSize) {
+                stbi_image_free(pixelData);
+                throw std::invalid_argument(string_format("Image %s (%dx%d) exceeds maximum texture size (%d). Use TiledGaussianBlur to process it in parts.", imagePath.c_str(), width, height, maxTextureSize));
+            }
+
+            Utils::Memory::FlipRows(pixelData, size_t(width) * 4, height);
+
             Size2D size(width, height);
+            std::vector<MipChainGenerator::Level> mipLevels;
+            if (generateMipMaps) {
+                mipLevels = MipChainGenerator::Generate(pixelData, width, height, mipMapSettings);
+            }
+
+            BlockCompressor::Format blockFormat;
+            GLenum compressedFormat = 0;
+
+            // Compress explicitly instead of leaving it to the driver, so the result is the same everywhere
+            if (GLTexture::BlockCompressedFormat(Format, blockFormat, compressedFormat)) {
+                std::vector<uint8_t> blocks = BlockCompressor::Compress(blockFormat, pixelData, width, height);
+                stbi_image_free(pixelData);
+                auto texture = std::make_unique<GLNormalizedTexture2D<Format>>(size, compressedFormat, blocks.data(), blocks.size(), Sampling::Filter::Anisotropic, Sampling::WrapMode::Repeat);
+
+                for (size_t i = 0; i < mipLevels.size(); ++i) {
+                    const MipChainGenerator::Level &level = mipLevels[i];
+                    blocks = BlockCompressor::Compress(blockFormat, level.pixels.data(), level.width, level.height);
+                    texture->setCompressedImage(i + 1, Size2D(level.width, level.height), compressedFormat, blocks.data(), blocks.size());
+                }
+
+                return texture;
+            }
+
             auto texture = std::make_unique<GLNormalizedTexture2D<Format>>(size, pixelData, Sampling::Filter::Anisotropic, Sampling::WrapMode::Repeat);
             stbi_image_free(pixelData);
 
+            for (size_t i = 0; i < mipLevels.size(); ++i) {
+                const MipChainGenerator::Level &level = mipLevels[i];
+                texture->setMipMapImage(i + 1, Size2D(level.width, level.height), level.pixels.data());
+            }
+
             return texture;
         }
 
@@ -49,13 +91,14 @@ namespace Engine {
             int32_t height = 0;
             int32_t components = 0;
 
-            stbi_set_flip_vertically_on_load(true);
             float *pixelData = stbi_loadf(imagePath.c_str(), &width, &height, &components, STBI_default);
 
             if (!pixelData) {
                 throw std::invalid_argument(string_format("Failed to load texture file (%s)", imagePath.c_str()));
             }
 
+            Utils::Memory::FlipRows(pixelData, size_t(width) * components * sizeof(float), height);
+
             Size2D size(width, height);
             auto texture = std::make_unique<GLFloatTexture2D<GLTexture::Float::RGB16F>>(size, pixelData, Sampling::Filter::Bilinear, Sampling::WrapMode::Repeat);
             stbi_image_free(pixelData);
@@ -1,23 +1,54 @@
 #include "Renderer.hpp"
 
 #include <WavefrontMeshLoader.hpp>
-#include <GLTextureFactory.hpp>
+#include <MeshCache.hpp>
+#include <MeshOptimizer.hpp>
+#include <MeshSimplifier.hpp>
+#include <GaussianFunction.hpp>
+#include <StringUtils.hpp>
+
+#include <cstdlib>
 
 namespace Engine {
 
+	/// Per-user directory for data measured on this machine, resources may be read-only or shared
+	/// @return empty path if there is no such directory and it can't be created
+	static filesystem::path UserCacheDirectory() {
+#if defined(_WIN32)
+		const char *localAppData = std::getenv("LOCALAPPDATA");
+		filesystem::path root = localAppData ? filesystem::path(localAppData) : filesystem::path();
+#else
+		const char *xdgCache = std::getenv("XDG_CACHE_HOME");
+		const char *home = std::getenv("HOME");
+		filesystem::path root = xdgCache && *xdgCache ? filesystem::path(xdgCache) : home ? filesystem::path(home) / ".cache" : filesystem::path();
+#endif
+		if (root.empty()) {
+			return filesystem::path();
+		}
+
+		filesystem::path directory = root / "UbiBlur";
+		for (const filesystem::path &level : { root, directory }) {
+			if (!level.is_directory() && !filesystem::create_directory(level)) {
+				return filesystem::path();
+			}
+		}
+		return directory;
+	}
+
 	Renderer::Renderer(const filesystem::path &resourceRoot, const Size2D &rtSize)
 		: mCamera(90.0, 10.0, 200.0),
 		mFramebuffer(rtSize),
 		mRenderTarget(rtSize),
 		mDepthStencilRenderbuffer(rtSize),
-		mMeshShader(resourceRoot.str() + "\\Shaders\\Mesh.vert", resourceRoot.str() + "\\Shaders\\Mesh.frag", ""),
-		mRTOutputShader(resourceRoot.str() + "\\Shaders\\FullScreenQuad.vert", resourceRoot.str() + "\\Shaders\\FullScreenQuad.frag", ""),
-		mBackgroundPatternShader(resourceRoot.str() + "\\Shaders\\FullScreenQuad.vert", resourceRoot.str() + "\\Shaders\\BackgroundPattern.frag", ""),
+		mTextureCache((resourceRoot / "TextureCache").str()),
+		mTextureLoader(Utils::Parallel::ConcurrencyLevel(), &mTextureCache),
+		mPendingMaps(requestMaterialMaps(resourceRoot)),
+		mMeshShader((resourceRoot / "Shaders/Mesh.vert").str(), (resourceRoot / "Shaders/Mesh.frag").str(), ""),
+		mRTOutputShader((resourceRoot / "Shaders/FullScreenQuad.vert").str(), (resourceRoot / "Shaders/FullScreenQuad.frag").str(), ""),
+		mBackgroundPatternShader((resourceRoot / "Shaders/FullScreenQuad.vert").str(), (resourceRoot / "Shaders/BackgroundPattern.frag").str(), ""),
 		mVAO(constructMeshVAO(resourceRoot)), 
-		mAlbedoMap(GLTextureFactory::LoadLDRImage<GLTexture::Normalized::RGBACompressedRGBAInput>(resourceRoot.str() + "\\Textures\\albedo.png")),
-		mNormalMap(GLTextureFactory::LoadLDRImage<GLTexture::Normalized::RGBCompressedRGBAInput>(resourceRoot.str() + "\\Textures\\normal.png")),
-		mRoughnessMap(GLTextureFactory::LoadLDRImage<GLTexture::Normalized::RCompressedRGBAInput>(resourceRoot.str() + "\\Textures\\roughness.png")),
-		mBlurEffect(resourceRoot, rtSize) {
+		mBlurEffect(resourceRoot, rtSize),
+		mBlurSettings{ 30, 15, GaussianFunction::LDRTruncationEpsilon, 0 } {
 		 
 		mFramebuffer.attachRenderbuffer(mDepthStencilRenderbuffer);
 		mFramebuffer.attachTexture(mRenderTarget);
@@ -25,36 +56,99 @@ namespace Engine {
 		mCamera.setViewportAspectRatio(mFramebuffer.size().width / mFramebuffer.size().height);
 		mCamera.moveTo(glm::vec3(0.0, 10.0, 100.0));
 		mCamera.lookAt(glm::vec3(0.0, 0.0, 0.0));
+
+		mMeshNode = mSceneGraph.createNode();
+		mMeshWorldBounds = mMeshRanges.positions;
+		mMeshCullingIndex = mCuller.add(mMeshWorldBounds);
 		 
 		glEnable(GL_DEPTH_TEST);
 		glClearColor(0.0, 0.0, 0.0, 1.0);
 		glClearDepth(1.0);
 
-		mAlbedoMap->generateMipMaps();
-		mNormalMap->generateMipMaps();
-		mRoughnessMap->generateMipMaps();
+		// Without a writable cache algorithms are ranked by texture fetch counts
+		filesystem::path cacheDirectory = UserCacheDirectory();
+		if (!cacheDirectory.empty()) {
+			std::string tableName = string_format("BlurCostTable_%dx%d.txt", int(rtSize.width), int(rtSize.height));
+			mBlurEffect.beginCalibration((cacheDirectory / tableName).str());
+		}
+
+		// Only uploads happen here, decoding, mip map generation and compression have been running in the background
+		mTextureLoader.finish();
+		mAlbedoMap = mPendingMaps.albedo.get();
+		mNormalMap = mPendingMaps.normal.get();
+		mRoughnessMap = mPendingMaps.roughness.get();
 	}
 
-	GLVertexArray<Vertex1P1N2UV1T1BT> Renderer::constructMeshVAO(const filesystem::path &resourceRoot) {
-		WavefrontMeshLoader loader(resourceRoot.str() + "\\Models\\Teapot.obj");
+	Renderer::PendingMaterialMaps Renderer::requestMaterialMaps(const filesystem::path &resourceRoot) {
+		// Normal and roughness maps hold data rather than colors and are filtered without gamma correction
+		MipMapSettings colorMipMaps;
+		MipMapSettings dataMipMaps;
+		dataMipMaps.gammaCorrect = false;
+
+		PendingMaterialMaps maps;
+		maps.albedo = mTextureLoader.load<GLTexture::Normalized::RGBACompressedRGBAInput>((resourceRoot / "Textures/albedo.png").str(), Sampling::Filter::Anisotropic, Sampling::WrapMode::Repeat, true, colorMipMaps);
+		maps.normal = mTextureLoader.load<GLTexture::Normalized::RGBCompressedRGBAInput>((resourceRoot / "Textures/normal.png").str(), Sampling::Filter::Anisotropic, Sampling::WrapMode::Repeat, true, dataMipMaps);
+		maps.roughness = mTextureLoader.load<GLTexture::Normalized::RCompressedRGBAInput>((resourceRoot / "Textures/roughness.png").str(), Sampling::Filter::Anisotropic, Sampling::WrapMode::Repeat, true, dataMipMaps);
+		return maps;
+	}
+
+	GLVertexArray<PackedVertex1P2UV1QT> Renderer::constructMeshVAO(const filesystem::path &resourceRoot) {
+		std::string meshPath = (resourceRoot / "Models/Teapot.obj").str();
+		std::string cachePath = meshPath + ".meshcache";
+
+		// Vertices of an up-to-date cache entry are packed straight from the mapped file
+		auto cache = MeshCache::Open(cachePath, meshPath);
+		if (cache && !cache->subMeshes().empty() && cache->subMeshes().back().indexCount > 0) {
+			auto &subMesh = cache->subMeshes().back();
+			return constructPackedVAO(subMesh.vertices, subMesh.vertexCount, subMesh.indices, subMesh.indexCount, subMesh.boundingBox, subMesh.levelsOfDetail);
+		}
+
+		WavefrontMeshLoader loader(meshPath);
 
 		std::vector<Engine::Mesh> meshes;
 		std::string meshName;
 		AxisAlignedBox3D boundingBox;
 		loader.load(meshes, meshName, boundingBox); 
 
+		// Simplified levels and optimized order are what gets cached, so this only runs when the source mesh changes
+		for (auto &subMesh : meshes) {
+			MeshSimplifier::BuildLevelsOfDetail(subMesh);
+
+			MeshOptimizer::Optimize(subMesh);
+		}
+
+		MeshCache::Write(cachePath, meshPath, meshes, meshName, boundingBox);
+
+		// Loader welds shared vertices, so the mesh is always drawn through its index buffer
 		auto &mesh = meshes.back();
-		std::array<Engine::GLVertexAttribute, 6> attributes{
-					Engine::GLVertexAttribute::UniqueAttribute(sizeof(glm::vec4), glm::vec4::length()),
-					Engine::GLVertexAttribute::UniqueAttribute(sizeof(glm::vec3), glm::vec3::length()),
-					Engine::GLVertexAttribute::UniqueAttribute(sizeof(glm::vec2), glm::vec2::length()),
-					Engine::GLVertexAttribute::UniqueAttribute(sizeof(glm::vec3), glm::vec3::length()),
-					Engine::GLVertexAttribute::UniqueAttribute(sizeof(glm::vec3), glm::vec3::length()),
-					Engine::GLVertexAttribute::UniqueAttribute(sizeof(glm::vec3), glm::vec3::length()) 
-		}; 
-
-		return GLVertexArray<Vertex1P1N2UV1T1BT>(
-			mesh.vertices().data(), mesh.vertices().size(), 
+		return constructPackedVAO(mesh.vertices().data(), mesh.vertices().size(), mesh.indices().data(), mesh.indices().size(), mesh.boundingBox(), mesh.levelsOfDetail());
+	}
+
+	GLVertexArray<PackedVertex1P2UV1QT> Renderer::constructPackedVAO(const Vertex1P1N2UV1T1BT *vertices, size_t vertexCount,
+		const uint32_t *indices, size_t indexCount, const AxisAlignedBox3D &boundingBox,
+		const std::vector<Mesh::LevelOfDetail> &levels) {
+
+		std::array<Engine::GLVertexAttribute, 4> attributes{
+					Engine::GLVertexAttribute::PackedAttribute(sizeof(glm::u16vec4), glm::u16vec4::length(), GL_UNSIGNED_SHORT, GL_TRUE),
+					Engine::GLVertexAttribute::PackedAttribute(sizeof(glm::u16vec2), glm::u16vec2::length(), GL_UNSIGNED_SHORT, GL_TRUE),
+					Engine::GLVertexAttribute::PackedAttribute(sizeof(glm::u16vec2), glm::u16vec2::length(), GL_UNSIGNED_SHORT, GL_TRUE),
+					Engine::GLVertexAttribute::PackedAttribute(sizeof(glm::i16vec4), glm::i16vec4::length(), GL_SHORT, GL_TRUE)
+		};
+
+		mMeshRanges = PackedVertex1P2UV1QT::Ranges(vertices, vertexCount, boundingBox);
+
+		std::vector<PackedVertex1P2UV1QT> packedVertices;
+		packedVertices.reserve(vertexCount);
+		for (size_t i = 0; i < vertexCount; i++) {
+			packedVertices.emplace_back(vertices[i], mMeshRanges);
+		}
+
+		mMeshLevels = levels;
+		mMeshBVH = std::make_unique<TriangleBVH>(vertices, vertexCount, indices, levels.empty() ? indexCount : levels.front().indexCount);
+
+		return GLVertexArray<PackedVertex1P2UV1QT>(
+			packedVertices.data(), packedVertices.size(),
+			indices, indexCount,
 			attributes.data(), attributes.size());
 	}
 
@@ -70,6 +164,36 @@ namespace Engine {
 		mShadingModel = model;
 	}
 
+	bool Renderer::pick(const glm::vec2 &ndc, TriangleBVH::Hit &hit) const {
+		// Bringing the ray into mesh space is cheaper than transforming the hierarchy
+		Ray3D ray = mCamera.rayThroughNDC(ndc);
+		const glm::mat4 &modelMatrix = mSceneGraph.worldMatrix(mMeshNode);
+		glm::mat4 inverseModelMatrix = glm::inverse(modelMatrix);
+		Ray3D meshRay(glm::vec3(inverseModelMatrix * glm::vec4(ray.origin, 1.f)), glm::vec3(inverseModelMatrix * glm::vec4(ray.direction, 0.f)));
+
+		if (!mMeshBVH->closestHit(meshRay, hit)) {
+			return false;
+		}
+
+		// Distances along the mesh space ray are stretched by the model matrix, measure the world space one instead
+		glm::vec3 worldPoint(modelMatrix * glm::vec4(meshRay.pointAt(hit.distance), 1.f));
+		hit.distance = glm::length(worldPoint - ray.origin);
+		return true;
+	}
+
+	void Renderer::updateSceneTransformations() {
+		// Nothing to do for a scene that didn't move since the last frame
+		if (mSceneGraph.update() == 0) {
+			return;
+		}
+
+		const glm::mat4 &modelMatrix = mSceneGraph.worldMatrix(mMeshNode);
+		mMeshWorldBounds = mMeshRanges.positions.transformedBy(modelMatrix);
+		mMeshWorldScale = glm::max(glm::length(glm::vec3(modelMatrix[0])),
+			glm::max(glm::length(glm::vec3(modelMatrix[1])), glm::length(glm::vec3(modelMatrix[2]))));
+		mCuller.update(mMeshCullingIndex, mMeshWorldBounds);
+	}
+
 	void Renderer::renderBackground() {
 		glDisable(GL_DEPTH_TEST);
 		mBackgroundPatternShader.bind();
@@ -77,19 +201,48 @@ namespace Engine {
 		glEnable(GL_DEPTH_TEST);
 	}
 
-	void Renderer::renderMesh() {
-		glm::mat4 modelMatrix(1.0);
-		glm::mat4 normalMatrix(glm::transpose(glm::inverse(modelMatrix)));
+	const Mesh::LevelOfDetail *Renderer::selectMeshLevel() const {
+		if (mMeshLevels.empty()) {
+			return nullptr;
+		}
+
+		// Distance to the closest point of the bounds, zero when the camera is inside
+		glm::vec3 cameraPosition = mCamera.position();
+		glm::vec3 closestPoint = glm::clamp(cameraPosition, mMeshWorldBounds.min, mMeshWorldBounds.max);
+		float distance = glm::length(cameraPosition - closestPoint);
+		if (distance <= 0.f) {
+			return &mMeshLevels.front();
+		}
+
+		float pixelsPerUnit = mFramebuffer.size().height / (2.f * distance * std::tan(glm::radians(mCamera.FOVV()) / 2.f));
+
+		// Simplification errors are measured in mesh space, the largest axis scale bounds how far the node stretches them
+		float pixelsPerError = pixelsPerUnit * mMeshWorldScale;
 
+		const Mesh::LevelOfDetail *selected = &mMeshLevels.front();
+		for (const auto &level : mMeshLevels) {
+			if (level.error * pixelsPerError > 1.f) {
+				break;
+			}
+			selected = &level;
+		}
+		return selected;
+	}
+
+	void Renderer::renderMesh() {
 		auto model = std::underlying_type<ShadingModel>::type(mShadingModel);
 
 		mMeshShader.bind();
 		mMeshShader.setUniformInteger(ctcrc32("uLightingModel"), model);
-		mMeshShader.setUniformMatrix(ctcrc32("uModelMat"), modelMatrix);
-		mMeshShader.setUniformMatrix(ctcrc32("uNormalMat"), normalMatrix);
+		mMeshShader.setUniformMatrix(ctcrc32("uModelMat"), mSceneGraph.worldMatrix(mMeshNode));
+		mMeshShader.setUniformMatrix(ctcrc32("uNormalMat"), mSceneGraph.normalMatrix(mMeshNode));
 		mMeshShader.setUniformMatrix(ctcrc32("uCameraViewMat"), mCamera.viewMatrix());
 		mMeshShader.setUniformMatrix(ctcrc32("uCameraProjectionMat"), mCamera.projectionMatrix());
 		mMeshShader.setUniformVector(ctcrc32("uCameraPosition"), mCamera.position());
+		mMeshShader.setUniformVector(ctcrc32("uPositionOffset"), mMeshRanges.positions.min);
+		mMeshShader.setUniformVector(ctcrc32("uPositionScale"), mMeshRanges.positionScale());
+		mMeshShader.setUniformVector(ctcrc32("uTexCoordsOffset"), mMeshRanges.textureCoordsMin);
+		mMeshShader.setUniformVector(ctcrc32("uTexCoordsScale"), mMeshRanges.textureCoordsScale());
 		mMeshShader.ensureSamplerValidity([&] {
 			mMeshShader.setUniformTexture(ctcrc32("uMaterial.albedoMap"), *mAlbedoMap);
 			mMeshShader.setUniformTexture(ctcrc32("uMaterial.normalMap"), *mNormalMap);
@@ -97,10 +250,21 @@ namespace Engine {
 		});
 
 		mFramebuffer.clear(GLFramebuffer::UnderlyingBuffer::Depth);
-		Drawable::TriangleMesh::Draw(mVAO.vertexBuffer()->count());
+
+		mCuller.cull(Frustum(mCamera.viewProjectionMatrix()), mVisibility);
+		if (!mVisibility[mMeshCullingIndex]) {
+			return;
+		}
+
+		mVAO.bind();
+		if (auto level = selectMeshLevel()) {
+			Drawable::TriangleMesh::DrawIndexed(*mVAO.indexBuffer(), level->indexCount, level->firstIndex);
+		} else {
+			Drawable::TriangleMesh::DrawIndexed(*mVAO.indexBuffer());
+		}
 	}
 
-	void Renderer::renderFinalImage() {
+	void Renderer::present() {
 		mRTOutputShader.bind();
 		mRTOutputShader.ensureSamplerValidity([&] {
 			mRTOutputShader.setUniformTexture(ctcrc32("uImage"), mRenderTarget);
@@ -112,18 +276,33 @@ namespace Engine {
 	}
 
 	void Renderer::render() {
+		// Measurements only matter when approximate algorithms are allowed to compete with the exact one
+		if (mBlurEnabled && mBlurSettings.errorBudget > 0) {
+			mBlurEffect.continueCalibration();
+		}
+
 		mFramebuffer.bind();
 		mFramebuffer.viewport().apply();
 
+		updateSceneTransformations();
+
 		renderBackground();
 		renderMesh();
 
 		if (mBlurEnabled) {
-			mBlurEffect.blurWithVertexMask(mRenderTarget, mFramebuffer, { 30, 15 });
-			//mBlurEffect.blurWithStencilMask(mRenderTarget, mFramebuffer, { 30, 15 });
+			mBlurEffect.blurWithVertexMask(mRenderTarget, mFramebuffer, mBlurSettings);
+			//mBlurEffect.blurWithStencilMask(mRenderTarget, mFramebuffer, mBlurSettings);
 		}
+	}
+
+	const GLNormalizedTexture2D<GLTexture::Normalized::RGBA> &Renderer::renderTarget() const {
+		return mRenderTarget;
+	}
 
-		renderFinalImage();
+	std::vector<uint8_t> Renderer::readFrame() const {
+		std::vector<uint8_t> pixels(size_t(mRenderTarget.size().width) * size_t(mRenderTarget.size().height) * 4);
+		mFramebuffer.readPixels(mRenderTarget, Rect2D(mRenderTarget.size()), pixels.data());
+		return pixels;
 	}
 
 }
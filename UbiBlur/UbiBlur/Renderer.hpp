@@ -1,15 +1,21 @@
 #pragma once
 
 #include <Mesh.hpp>
+#include <Vertices/PackedVertex1P2UV1QT.hpp>
 #include <GLFramebuffer.hpp>
 #include <GLProgram.hpp>
 #include <Camera.hpp>
+#include <FrustumCuller.hpp>
+#include <SceneGraph.hpp>
+#include <TriangleBVH.hpp>
 #include <GLVertexArray.hpp>
 #include <Drawable.hpp>
 #include <GaussianBlur/GaussianBlurEffect.hpp>
 #include <GLDepthStencilRenderbuffer.hpp>
+#include <GLAsyncTextureLoader.hpp>
 #include <filesystem/path.h>
 #include <memory>
+#include <future>
 
 namespace Engine {
 
@@ -23,28 +29,71 @@ namespace Engine {
 		GLNormalizedTexture2D<Engine::GLTexture::Normalized::RGBA> mRenderTarget;
 		GLDepthStencilRenderbuffer mDepthStencilRenderbuffer;
 
+		/// Material maps are decoded on loader threads while shaders and meshes are being prepared
+		struct PendingMaterialMaps {
+			std::future<GLAsyncTextureLoader::TexturePointer<GLTexture::Normalized::RGBACompressedRGBAInput>> albedo;
+			std::future<GLAsyncTextureLoader::TexturePointer<GLTexture::Normalized::RGBCompressedRGBAInput>> normal;
+			std::future<GLAsyncTextureLoader::TexturePointer<GLTexture::Normalized::RCompressedRGBAInput>> roughness;
+		};
+
+		GLCompressedTextureCache mTextureCache;
+		GLAsyncTextureLoader mTextureLoader;
+		PendingMaterialMaps mPendingMaps;
+
 		GLProgram mMeshShader;
 		GLProgram mRTOutputShader;
 		GLProgram mBackgroundPatternShader;
-		GLVertexArray<Vertex1P1N2UV1T1BT> mVAO;
+		/// Packed mesh attributes are relative to these ranges, position range doubles as the mesh bounding box.
+		/// Has to be initialized before the VAO
+		PackedVertex1P2UV1QT::Ranges mMeshRanges;
+		/// Index ranges of simplified versions of the mesh, has to be initialized before the VAO as well
+		std::vector<Mesh::LevelOfDetail> mMeshLevels;
+		/// Full detail mesh triangles for picking, built alongside the VAO
+		std::unique_ptr<TriangleBVH> mMeshBVH;
+		GLVertexArray<PackedVertex1P2UV1QT> mVAO;
+
+		/// Placement of everything drawn, matrices are only recomputed for nodes that moved
+		SceneGraph mSceneGraph;
+		SceneGraph::NodeID mMeshNode;
+		/// Mesh bounds transformed by the world matrix of its node
+		AxisAlignedBox3D mMeshWorldBounds;
+		/// Largest axis scale of the world matrix of the mesh node
+		float mMeshWorldScale = 1.f;
+
+		/// World space bounds of everything drawn, culled against the camera frustum every frame
+		FrustumCuller mCuller;
+		std::vector<uint8_t> mVisibility;
+		size_t mMeshCullingIndex = 0;
 
 		std::unique_ptr<GLNormalizedTexture2D<GLTexture::Normalized::RGBACompressedRGBAInput>> mAlbedoMap;
 		std::unique_ptr<GLNormalizedTexture2D<GLTexture::Normalized::RGBCompressedRGBAInput>> mNormalMap;
 		std::unique_ptr<GLNormalizedTexture2D<GLTexture::Normalized::RCompressedRGBAInput>> mRoughnessMap;
 
 		GaussianBlurEffect mBlurEffect;
+		/// Exact blur only by default, a nonzero error budget lets the calibrated cost model pick a cheaper approximation
+		GaussianBlurSettings mBlurSettings;
 
 		bool mBlurEnabled = true;
 		ShadingModel mShadingModel = ShadingModel::CookTorrance;
 
-		GLVertexArray<Vertex1P1N2UV1T1BT> constructMeshVAO(const filesystem::path &resourceRoot);
+		PendingMaterialMaps requestMaterialMaps(const filesystem::path &resourceRoot);
+
+		GLVertexArray<PackedVertex1P2UV1QT> constructMeshVAO(const filesystem::path &resourceRoot);
+
+		GLVertexArray<PackedVertex1P2UV1QT> constructPackedVAO(const Vertex1P1N2UV1T1BT *vertices, size_t vertexCount,
+			const uint32_t *indices, size_t indexCount, const AxisAlignedBox3D &boundingBox,
+			const std::vector<Mesh::LevelOfDetail> &levels);
+
+		/// Picks the coarsest level whose simplification error projects to less than a pixel
+		const Mesh::LevelOfDetail *selectMeshLevel() const;
+
+		/// Resolves the scene graph and refreshes world space bounds of whatever moved
+		void updateSceneTransformations();
 
 		void renderBackground();
 
 		void renderMesh();
 
-		void renderFinalImage();
-
 	public:
 		Renderer(const filesystem::path &resourceRoot, const Size2D &rtSize);
 
@@ -54,7 +103,22 @@ namespace Engine {
 
 		void setShadingModel(ShadingModel model);
 
+		/// Casts a ray from the camera through a point on the screen against the mesh
+		/// @param ndc point in normalized device coordinates
+		/// @return false if the ray misses the mesh, hit distance is measured in world space
+		bool pick(const glm::vec2 &ndc, TriangleBVH::Hit &hit) const;
+
+		/// Renders the frame into offscreen render target, default framebuffer is not touched
 		void render();
+
+		/// Outputs rendered frame to the default framebuffer
+		void present();
+
+		const GLNormalizedTexture2D<GLTexture::Normalized::RGBA> &renderTarget() const;
+
+		/// Waits for the GPU and reads the render target back
+		/// @return RGBA8 pixels, bottom row first
+		std::vector<uint8_t> readFrame() const;
 	};
 
 }
@@ -0,0 +1,297 @@
+//
+//  MeshCache.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "MeshCache.hpp"
+#include "CRC32.hpp"
+
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+namespace Engine {
+
+    static_assert(std::is_trivially_copyable<Vertex1P1N2UV1T1BT>::value, "Cached vertices are written and mapped as raw bytes");
+    static_assert(sizeof(Vertex1P1N2UV1T1BT) % alignof(uint32_t) == 0, "Indices following vertex data must stay aligned");
+
+    static const char EntryMagic[4] = {'U', 'B', 'M', 'C'};
+    static const uint32_t EntryVersion = 5;
+    static const size_t VertexDataAlignment = 16;
+
+#pragma mark - Serialization helpers
+
+    namespace {
+
+        size_t Padding(size_t offset, size_t alignment) {
+            return (alignment - offset % alignment) % alignment;
+        }
+
+        /// Sequential writer keeping track of the offset, so vertex data can be aligned
+        class EntryWriter {
+        private:
+            std::ofstream &mFile;
+            size_t mOffset = 0;
+
+        public:
+            EntryWriter(std::ofstream &file) : mFile(file) {}
+
+            void write(const void *data, size_t byteCount) {
+                mFile.write(reinterpret_cast<const char *>(data), byteCount);
+                mOffset += byteCount;
+            }
+
+            template<typename T>
+            void writeValue(const T &value) {
+                write(&value, sizeof(T));
+            }
+
+            void writeString(const std::string &string) {
+                writeValue(uint32_t(string.size()));
+                write(string.data(), string.size());
+            }
+
+            void writeBox(const AxisAlignedBox3D &box) {
+                const float values[6] = {box.min.x, box.min.y, box.min.z, box.max.x, box.max.y, box.max.z};
+                write(values, sizeof(values));
+            }
+
+            void align(size_t alignment) {
+                static const char zeros[VertexDataAlignment] = {};
+                write(zeros, Padding(mOffset, alignment));
+            }
+        };
+
+        /// Bounds-checked cursor over the mapped entry
+        class EntryReader {
+        private:
+            const uint8_t *mData;
+            size_t mSize;
+            size_t mOffset = 0;
+
+        public:
+            EntryReader(const uint8_t *data, size_t size) : mData(data), mSize(size) {}
+
+            const uint8_t *read(size_t byteCount) {
+                if (byteCount > mSize - mOffset) {
+                    return nullptr;
+                }
+                const uint8_t *pointer = mData + mOffset;
+                mOffset += byteCount;
+                return pointer;
+            }
+
+            template<typename T>
+            bool readValue(T &value) {
+                const uint8_t *pointer = read(sizeof(T));
+                if (!pointer) return false;
+                std::memcpy(&value, pointer, sizeof(T));
+                return true;
+            }
+
+            bool readString(std::string &string) {
+                uint32_t length = 0;
+                if (!readValue(length)) return false;
+                const uint8_t *pointer = read(length);
+                if (!pointer) return false;
+                string.assign(reinterpret_cast<const char *>(pointer), length);
+                return true;
+            }
+
+            bool readBox(AxisAlignedBox3D &box) {
+                float values[6];
+                if (!readValue(values)) return false;
+                box = AxisAlignedBox3D(glm::vec3(values[0], values[1], values[2]), glm::vec3(values[3], values[4], values[5]));
+                return true;
+            }
+
+            bool align(size_t alignment) {
+                return read(Padding(mOffset, alignment)) != nullptr;
+            }
+        };
+
+        bool SourceChecksum(const std::string &sourcePath, uint64_t &byteCount, uint32_t &checksum) {
+            MemoryMappedFile source(sourcePath);
+            if (!source.isOpen()) {
+                return false;
+            }
+            byteCount = source.size();
+            checksum = rtcrc32(source.data(), source.size());
+            return true;
+        }
+
+    }
+
+#pragma mark - Lifecycle
+
+    MeshCache::MeshCache(MemoryMappedFile &&file) : mFile(std::move(file)) {}
+
+    std::unique_ptr<MeshCache> MeshCache::Open(const std::string &cachePath, const std::string &sourcePath) {
+        MemoryMappedFile file(cachePath);
+        if (!file.isOpen()) {
+            return nullptr;
+        }
+
+        std::unique_ptr<MeshCache> cache(new MeshCache(std::move(file)));
+        if (!cache->parse(sourcePath)) {
+            return nullptr;
+        }
+        return cache;
+    }
+
+#pragma mark - Private helpers
+
+    bool MeshCache::parse(const std::string &sourcePath) {
+        EntryReader reader(mFile.data(), mFile.size());
+
+        const uint8_t *magic = reader.read(sizeof(EntryMagic));
+        uint32_t version = 0;
+        uint32_t vertexSize = 0;
+        uint64_t entrySourceByteCount = 0;
+        uint32_t entrySourceChecksum = 0;
+
+        bool valid = magic && std::equal(magic, magic + sizeof(EntryMagic), EntryMagic) &&
+                     reader.readValue(version) && version == EntryVersion &&
+                     reader.readValue(vertexSize) && vertexSize == sizeof(Vertex1P1N2UV1T1BT) &&
+                     reader.readValue(entrySourceByteCount) &&
+                     reader.readValue(entrySourceChecksum);
+
+        if (!valid) {
+            return false;
+        }
+
+        // Size is compared first, so that a stale entry is usually rejected without hashing the source
+        MemoryMappedFile source(sourcePath);
+        if (!source.isOpen() || source.size() != entrySourceByteCount ||
+            rtcrc32(source.data(), source.size()) != entrySourceChecksum) {
+            return false;
+        }
+
+        uint32_t subMeshCount = 0;
+        if (!reader.readString(mMeshName) || !reader.readBox(mBoundingBox) || !reader.readValue(subMeshCount)) {
+            return false;
+        }
+
+        mSubMeshes.resize(subMeshCount);
+        for (SubMesh &subMesh : mSubMeshes) {
+            uint64_t vertexCount = 0;
+            uint64_t indexCount = 0;
+            uint32_t levelCount = 0;
+
+            if (!reader.readString(subMesh.name) || !reader.readString(subMesh.materialName) ||
+                !reader.readBox(subMesh.boundingBox) || !reader.readValue(subMesh.surfaceArea) ||
+                !reader.readValue(vertexCount) || !reader.readValue(indexCount) || !reader.readValue(levelCount)) {
+                return false;
+            }
+
+            if (levelCount > mFile.size() / sizeof(Mesh::LevelOfDetail)) {
+                return false;
+            }
+
+            subMesh.levelsOfDetail.resize(levelCount);
+            for (Mesh::LevelOfDetail &level : subMesh.levelsOfDetail) {
+                if (!reader.readValue(level.firstIndex) || !reader.readValue(level.indexCount) || !reader.readValue(level.error) ||
+                    uint64_t(level.firstIndex) + level.indexCount > indexCount) {
+                    return false;
+                }
+            }
+
+            if (!reader.align(VertexDataAlignment)) {
+                return false;
+            }
+
+            if (vertexCount > mFile.size() / sizeof(Vertex1P1N2UV1T1BT) || indexCount > mFile.size() / sizeof(uint32_t)) {
+                return false;
+            }
+
+            const uint8_t *vertices = reader.read(size_t(vertexCount) * sizeof(Vertex1P1N2UV1T1BT));
+            const uint8_t *indices = vertices ? reader.read(size_t(indexCount) * sizeof(uint32_t)) : nullptr;
+            if (!vertices || !indices) {
+                return false;
+            }
+
+            subMesh.vertices = reinterpret_cast<const Vertex1P1N2UV1T1BT *>(vertices);
+            subMesh.vertexCount = size_t(vertexCount);
+            subMesh.indices = indexCount > 0 ? reinterpret_cast<const uint32_t *>(indices) : nullptr;
+            subMesh.indexCount = size_t(indexCount);
+        }
+
+        return true;
+    }
+
+#pragma mark - Writing
+
+    bool MeshCache::Write(const std::string &cachePath, const std::string &sourcePath,
+                          const std::vector<Mesh> &subMeshes, const std::string &meshName, const AxisAlignedBox3D &boundingBox) {
+        uint64_t sourceByteCount = 0;
+        uint32_t sourceChecksum = 0;
+        if (!SourceChecksum(sourcePath, sourceByteCount, sourceChecksum)) {
+            return false;
+        }
+
+        std::string temporaryPath = cachePath + ".tmp";
+
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                return false;
+            }
+
+            EntryWriter writer(file);
+            writer.write(EntryMagic, sizeof(EntryMagic));
+            writer.writeValue(EntryVersion);
+            writer.writeValue(uint32_t(sizeof(Vertex1P1N2UV1T1BT)));
+            writer.writeValue(sourceByteCount);
+            writer.writeValue(sourceChecksum);
+            writer.writeString(meshName);
+            writer.writeBox(boundingBox);
+            writer.writeValue(uint32_t(subMeshes.size()));
+
+            for (const Mesh &subMesh : subMeshes) {
+                writer.writeString(subMesh.name());
+                writer.writeString(subMesh.materialName());
+                writer.writeBox(subMesh.boundingBox());
+                writer.writeValue(subMesh.surfaceArea());
+                writer.writeValue(uint64_t(subMesh.vertices().size()));
+                writer.writeValue(uint64_t(subMesh.indices().size()));
+                writer.writeValue(uint32_t(subMesh.levelsOfDetail().size()));
+                for (const Mesh::LevelOfDetail &level : subMesh.levelsOfDetail()) {
+                    writer.writeValue(level.firstIndex);
+                    writer.writeValue(level.indexCount);
+                    writer.writeValue(level.error);
+                }
+                writer.align(VertexDataAlignment);
+                writer.write(subMesh.vertices().data(), subMesh.vertices().size() * sizeof(Vertex1P1N2UV1T1BT));
+                writer.write(subMesh.indices().data(), subMesh.indices().size() * sizeof(uint32_t));
+            }
+
+            if (!file) {
+                return false;
+            }
+        }
+
+        // Readers never observe a partially written entry
+        std::remove(cachePath.c_str());
+        return std::rename(temporaryPath.c_str(), cachePath.c_str()) == 0;
+    }
+
+#pragma mark - Getters
+
+    const std::string &MeshCache::meshName() const {
+        return mMeshName;
+    }
+
+    const AxisAlignedBox3D &MeshCache::boundingBox() const {
+        return mBoundingBox;
+    }
+
+    const std::vector<MeshCache::SubMesh> &MeshCache::subMeshes() const {
+        return mSubMeshes;
+    }
+
+}
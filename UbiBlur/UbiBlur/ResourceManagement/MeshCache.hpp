@@ -0,0 +1,74 @@
+//
+//  MeshCache.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef MeshCache_hpp
+#define MeshCache_hpp
+
+#include "Mesh.hpp"
+#include "MemoryMappedFile.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace Engine {
+
+    /**
+     Binary snapshot of the WavefrontMeshLoader output which is memory mapped instead of being parsed.
+
+     Vertices and indices are stored exactly as they are laid out in memory and vertices are 16-byte aligned inside the file,
+     so sub mesh vertex and index pointers lead directly into the mapping and can be handed to GLVertexArray as is.
+     Entries are validated by the size and CRC32 of the source file, any mismatch makes them stale.
+     */
+    class MeshCache {
+    public:
+        struct SubMesh {
+            std::string name;
+            std::string materialName;
+            AxisAlignedBox3D boundingBox;
+            float surfaceArea = 0.0;
+            /// Points into the mapped file, valid as long as the cache object is alive
+            const Vertex1P1N2UV1T1BT *vertices = nullptr;
+            size_t vertexCount = 0;
+            /// Triangle list indices, also pointing into the mapped file. Null for non-indexed meshes.
+            const uint32_t *indices = nullptr;
+            size_t indexCount = 0;
+            /// Index ranges of simplified levels, empty if the mesh was never simplified
+            std::vector<Mesh::LevelOfDetail> levelsOfDetail;
+        };
+
+    private:
+        MemoryMappedFile mFile;
+        std::string mMeshName;
+        AxisAlignedBox3D mBoundingBox;
+        std::vector<SubMesh> mSubMeshes;
+
+        MeshCache(MemoryMappedFile &&file);
+
+        bool parse(const std::string &sourcePath);
+
+    public:
+        /// Maps a cache entry of the source mesh
+        /// @return nullptr if the entry is missing, corrupted or older than the source
+        static std::unique_ptr<MeshCache> Open(const std::string &cachePath, const std::string &sourcePath);
+
+        /// Writes the loader output for the source mesh, replacing an existing entry
+        /// @return false if the source is unreadable or the entry could not be written
+        static bool Write(const std::string &cachePath, const std::string &sourcePath,
+                          const std::vector<Mesh> &subMeshes, const std::string &meshName, const AxisAlignedBox3D &boundingBox);
+
+        const std::string &meshName() const;
+
+        const AxisAlignedBox3D &boundingBox() const;
+
+        const std::vector<SubMesh> &subMeshes() const;
+    };
+
+}
+
+#endif /* MeshCache_hpp */
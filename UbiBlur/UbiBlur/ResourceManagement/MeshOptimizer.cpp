@@ -0,0 +1,307 @@
+//
+//  MeshOptimizer.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <limits>
+
+#include <glm/geometric.hpp>
+
+namespace Engine {
+
+    constexpr size_t MeshOptimizer::DefaultCacheSize;
+
+    namespace {
+
+        const uint32_t InvalidVertex = std::numeric_limits<uint32_t>::max();
+
+        /// Triangles using each vertex, stored as one flat array
+        struct VertexTriangles {
+            std::vector<uint32_t> offsets;
+            std::vector<uint32_t> triangles;
+
+            VertexTriangles(const std::vector<uint32_t> &indices, size_t vertexCount) : offsets(vertexCount + 1, 0), triangles(indices.size()) {
+                for (uint32_t index : indices) {
+                    ++offsets[index + 1];
+                }
+                std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+                std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < indices.size(); ++i) {
+                    triangles[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+                }
+            }
+
+            uint32_t count(uint32_t vertex) const {
+                return offsets[vertex + 1] - offsets[vertex];
+            }
+        };
+
+#pragma mark - Tipsify
+
+        /// Picks a vertex with live triangles from the dead-end stack or, failing that, scans forward for one
+        uint32_t SkipDeadEnd(std::vector<uint32_t> &deadEnds, const std::vector<uint32_t> &liveTriangles, uint32_t &cursor) {
+            while (!deadEnds.empty()) {
+                uint32_t vertex = deadEnds.back();
+                deadEnds.pop_back();
+                if (liveTriangles[vertex] > 0) {
+                    return vertex;
+                }
+            }
+
+            for (; cursor < liveTriangles.size(); ++cursor) {
+                if (liveTriangles[cursor] > 0) {
+                    return cursor;
+                }
+            }
+
+            return InvalidVertex;
+        }
+
+        /**
+         @param clusterStarts receives first triangle of every cluster, new clusters start whenever the fanning
+         vertex has to be taken from a dead end, which effectively flushes the cache
+         @return reordered triangle list
+         */
+        std::vector<uint32_t> Tipsify(const std::vector<uint32_t> &indices, size_t vertexCount, size_t cacheSize, std::vector<uint32_t> &clusterStarts) {
+            VertexTriangles adjacency(indices, vertexCount);
+
+            std::vector<uint32_t> liveTriangles(vertexCount);
+            for (uint32_t v = 0; v < vertexCount; ++v) {
+                liveTriangles[v] = adjacency.count(v);
+            }
+
+            std::vector<size_t> cacheTimestamps(vertexCount, 0);
+            std::vector<bool> isEmitted(indices.size() / 3, false);
+            std::vector<uint32_t> deadEnds;
+            std::vector<uint32_t> candidates;
+            std::vector<uint32_t> output;
+            output.reserve(indices.size());
+
+            size_t time = cacheSize + 1;
+            uint32_t cursor = 0;
+            uint32_t fanningVertex = SkipDeadEnd(deadEnds, liveTriangles, cursor);
+            bool startsCluster = true;
+
+            while (fanningVertex != InvalidVertex) {
+                if (startsCluster) {
+                    clusterStarts.push_back(static_cast<uint32_t>(output.size() / 3));
+                }
+
+                candidates.clear();
+
+                for (uint32_t i = adjacency.offsets[fanningVertex]; i < adjacency.offsets[fanningVertex + 1]; ++i) {
+                    uint32_t triangle = adjacency.triangles[i];
+                    if (isEmitted[triangle]) {
+                        continue;
+                    }
+
+                    for (size_t corner = 0; corner < 3; ++corner) {
+                        uint32_t vertex = indices[triangle * 3 + corner];
+                        output.push_back(vertex);
+                        deadEnds.push_back(vertex);
+                        candidates.push_back(vertex);
+                        --liveTriangles[vertex];
+
+                        if (time - cacheTimestamps[vertex] > cacheSize) {
+                            cacheTimestamps[vertex] = time++;
+                        }
+                    }
+
+                    isEmitted[triangle] = true;
+                }
+
+                // Prefer the candidate staying in the cache the longest, provided all its triangles fit in there as well
+                uint32_t nextVertex = InvalidVertex;
+                size_t bestPriority = 0;
+                bool hasPriority = false;
+
+                for (uint32_t vertex : candidates) {
+                    if (liveTriangles[vertex] == 0) {
+                        continue;
+                    }
+
+                    size_t priority = 0;
+                    size_t age = time - cacheTimestamps[vertex];
+                    if (age + 2 * liveTriangles[vertex] <= cacheSize) {
+                        priority = age;
+                    }
+
+                    if (!hasPriority || priority > bestPriority) {
+                        bestPriority = priority;
+                        nextVertex = vertex;
+                        hasPriority = true;
+                    }
+                }
+
+                startsCluster = nextVertex == InvalidVertex;
+                fanningVertex = startsCluster ? SkipDeadEnd(deadEnds, liveTriangles, cursor) : nextVertex;
+            }
+
+            return output;
+        }
+
+#pragma mark - Overdraw
+
+        /// Clusters facing away from the mesh center are drawn first, they're likely to occlude the rest from any viewpoint
+        std::vector<uint32_t> SortClustersByOverdraw(const std::vector<uint32_t> &indices, const std::vector<uint32_t> &clusterStarts,
+                                                     const std::vector<Vertex1P1N2UV1T1BT> &vertices) {
+            size_t triangleCount = indices.size() / 3;
+            size_t clusterCount = clusterStarts.size();
+
+            auto position = [&](size_t corner) {
+                return glm::vec3(vertices[indices[corner]].position);
+            };
+
+            std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3(0.f));
+            std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3(0.f));
+            std::vector<float> clusterAreas(clusterCount, 0.f);
+            glm::vec3 meshCentroid(0.f);
+            float meshArea = 0.f;
+
+            for (size_t c = 0; c < clusterCount; ++c) {
+                size_t end = c + 1 < clusterCount ? clusterStarts[c + 1] : triangleCount;
+
+                for (size_t t = clusterStarts[c]; t < end; ++t) {
+                    glm::vec3 p0 = position(t * 3);
+                    glm::vec3 p1 = position(t * 3 + 1);
+                    glm::vec3 p2 = position(t * 3 + 2);
+
+                    // Length of the cross product is twice the area, so both sums end up area-weighted
+                    glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+                    float area = glm::length(normal);
+                    glm::vec3 centroid = (p0 + p1 + p2) / 3.f;
+
+                    clusterNormals[c] += normal;
+                    clusterCentroids[c] += centroid * area;
+                    clusterAreas[c] += area;
+                    meshCentroid += centroid * area;
+                    meshArea += area;
+                }
+            }
+
+            if (meshArea > 0.f) {
+                meshCentroid /= meshArea;
+            }
+
+            std::vector<float> clusterScores(clusterCount, 0.f);
+            for (size_t c = 0; c < clusterCount; ++c) {
+                float normalLength = glm::length(clusterNormals[c]);
+                if (clusterAreas[c] > 0.f && normalLength > 0.f) {
+                    glm::vec3 centroid = clusterCentroids[c] / clusterAreas[c];
+                    clusterScores[c] = glm::dot(centroid - meshCentroid, clusterNormals[c] / normalLength);
+                }
+            }
+
+            std::vector<uint32_t> order(clusterCount);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+                return clusterScores[lhs] > clusterScores[rhs];
+            });
+
+            std::vector<uint32_t> sorted;
+            sorted.reserve(indices.size());
+            for (uint32_t c : order) {
+                size_t end = c + 1 < clusterCount ? clusterStarts[c + 1] : triangleCount;
+                sorted.insert(sorted.end(), indices.begin() + clusterStarts[c] * 3, indices.begin() + end * 3);
+            }
+            return sorted;
+        }
+
+#pragma mark - Vertex fetch
+
+        /// Renumbers vertices in order of first reference, unreferenced vertices are moved to the end
+        void ReorderVertices(std::vector<uint32_t> &indices, std::vector<Vertex1P1N2UV1T1BT> &vertices) {
+            std::vector<uint32_t> remap(vertices.size(), InvalidVertex);
+            std::vector<Vertex1P1N2UV1T1BT> reordered;
+            reordered.reserve(vertices.size());
+
+            for (uint32_t &index : indices) {
+                if (remap[index] == InvalidVertex) {
+                    remap[index] = static_cast<uint32_t>(reordered.size());
+                    reordered.push_back(vertices[index]);
+                }
+                index = remap[index];
+            }
+
+            for (size_t v = 0; v < vertices.size(); ++v) {
+                if (remap[v] == InvalidVertex) {
+                    reordered.push_back(vertices[v]);
+                }
+            }
+
+            vertices.swap(reordered);
+        }
+
+    }
+
+#pragma mark - Public
+
+    float MeshOptimizer::ACMR(const std::vector<uint32_t> &indices, size_t vertexCount, size_t cacheSize) {
+        size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0) {
+            return 0.f;
+        }
+
+        std::vector<size_t> cacheTimestamps(vertexCount, 0);
+        size_t time = cacheSize + 1;
+        size_t misses = 0;
+
+        for (uint32_t index : indices) {
+            if (time - cacheTimestamps[index] > cacheSize) {
+                cacheTimestamps[index] = time++;
+                ++misses;
+            }
+        }
+
+        return float(misses) / float(triangleCount);
+    }
+
+    MeshOptimizer::Statistics MeshOptimizer::Optimize(Mesh &mesh, size_t cacheSize) {
+        if (!mesh.isIndexed()) {
+            throw std::invalid_argument("Mesh has to be welded into an indexed one before optimization");
+        }
+
+        if (cacheSize == 0) {
+            throw std::invalid_argument("Vertex cache size must be greater than zero");
+        }
+
+        std::vector<uint32_t> &indices = mesh.indices();
+        std::vector<Vertex1P1N2UV1T1BT> &vertices = mesh.vertices();
+
+        Statistics statistics;
+        statistics.initialACMR = ACMR(indices, vertices.size(), cacheSize);
+
+        std::vector<Mesh::LevelOfDetail> levels = mesh.levelsOfDetail();
+        if (levels.empty()) {
+            levels.push_back({0, static_cast<uint32_t>(indices.size()), 0.f});
+        }
+
+        // Levels are drawn separately, so each of them is ordered on its own
+        for (const Mesh::LevelOfDetail &level : levels) {
+            auto first = indices.begin() + level.firstIndex;
+            std::vector<uint32_t> levelIndices(first, first + level.indexCount);
+
+            std::vector<uint32_t> clusterStarts;
+            std::vector<uint32_t> ordered = Tipsify(levelIndices, vertices.size(), cacheSize, clusterStarts);
+            levelIndices = SortClustersByOverdraw(ordered, clusterStarts, vertices);
+            std::copy(levelIndices.begin(), levelIndices.end(), first);
+
+            statistics.clusterCount += clusterStarts.size();
+        }
+
+        ReorderVertices(indices, vertices);
+
+        statistics.optimizedACMR = ACMR(indices, vertices.size(), cacheSize);
+        return statistics;
+    }
+
+}
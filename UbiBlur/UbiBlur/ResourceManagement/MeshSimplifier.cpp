@@ -0,0 +1,495 @@
+//
+//  MeshSimplifier.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "MeshSimplifier.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+#include <glm/geometric.hpp>
+
+namespace Engine {
+
+    constexpr size_t MeshSimplifier::DefaultLevelCount;
+
+    namespace {
+
+        /// Border edge planes are weighted heavier than face planes, so that silhouettes of open meshes are kept
+        const float BorderWeight = 10.f;
+        /// Attribute penalties are expressed in squared fractions of the mesh extent, like the geometric error
+        const float NormalWeight = 1e-3f;
+        const float TextureCoordsWeight = 1e-2f;
+        /// Cosine of the largest rotation a collapse may apply to a neighbouring triangle
+        const float MaximumTriangleTilt = 0.25f;
+        /// Levels shrinking less than that relative to the previous one are not worth an extra index range
+        const float MinimumLevelReduction = 0.8f;
+        const size_t MinimumLevelTriangleCount = 8;
+
+        enum class VertexKind : uint8_t {
+            Manifold, Border, Locked
+        };
+
+        /// Symmetric 4x4 error quadric with the weight it has accumulated
+        struct Quadric {
+            float a00 = 0.f, a11 = 0.f, a22 = 0.f;
+            float a01 = 0.f, a02 = 0.f, a12 = 0.f;
+            float b0 = 0.f, b1 = 0.f, b2 = 0.f;
+            float c = 0.f;
+            float weight = 0.f;
+
+            void addPlane(const glm::vec3 &normal, float distance, float planeWeight) {
+                a00 += planeWeight * normal.x * normal.x;
+                a11 += planeWeight * normal.y * normal.y;
+                a22 += planeWeight * normal.z * normal.z;
+                a01 += planeWeight * normal.x * normal.y;
+                a02 += planeWeight * normal.x * normal.z;
+                a12 += planeWeight * normal.y * normal.z;
+                b0 += planeWeight * normal.x * distance;
+                b1 += planeWeight * normal.y * distance;
+                b2 += planeWeight * normal.z * distance;
+                c += planeWeight * distance * distance;
+                weight += planeWeight;
+            }
+
+            Quadric &operator+=(const Quadric &that) {
+                a00 += that.a00; a11 += that.a11; a22 += that.a22;
+                a01 += that.a01; a02 += that.a02; a12 += that.a12;
+                b0 += that.b0; b1 += that.b1; b2 += that.b2;
+                c += that.c;
+                weight += that.weight;
+                return *this;
+            }
+
+            /// Weighted mean of squared distances from the point to accumulated planes
+            float error(const glm::vec3 &p) const {
+                float rx = a00 * p.x + a01 * p.y + a02 * p.z;
+                float ry = a01 * p.x + a11 * p.y + a12 * p.z;
+                float rz = a02 * p.x + a12 * p.y + a22 * p.z;
+                float value = p.x * rx + p.y * ry + p.z * rz + 2.f * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+                return weight > 0.f ? std::max(value, 0.f) / weight : 0.f;
+            }
+        };
+
+        struct Collapse {
+            uint32_t from;
+            uint32_t to;
+            float cost;
+            float geometricError;
+        };
+
+        struct PositionHash {
+            size_t operator()(const glm::vec3 &p) const {
+                uint32_t bits[3];
+                std::memcpy(bits, &p, sizeof(bits));
+                return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+            }
+        };
+
+        uint64_t EdgeKey(uint32_t from, uint32_t to) {
+            return (uint64_t(from) << 32) | to;
+        }
+
+        /// Per-simplification state, positions are normalized to the unit cube so errors and weights don't depend on mesh scale
+        class Simplifier {
+        private:
+            std::vector<glm::vec3> mPositions;
+            std::vector<glm::vec3> mNormals;
+            std::vector<glm::vec2> mTextureCoords;
+            std::vector<uint32_t> mPositionIDs;
+            std::vector<VertexKind> mKinds;
+            std::unordered_set<uint64_t> mOpenEdges;
+            std::vector<Quadric> mQuadrics;
+            std::vector<uint32_t> mIndices;
+            float mScale = 1.f;
+            float mMaximumError = 0.f;
+
+            void normalizePositions(const std::vector<Vertex1P1N2UV1T1BT> &vertices) {
+                glm::vec3 minimum(std::numeric_limits<float>::max());
+                glm::vec3 maximum(-std::numeric_limits<float>::max());
+                for (uint32_t index : mIndices) {
+                    minimum = glm::min(minimum, glm::vec3(vertices[index].position));
+                    maximum = glm::max(maximum, glm::vec3(vertices[index].position));
+                }
+
+                glm::vec3 extent = maximum - minimum;
+                mScale = std::max(std::max(extent.x, extent.y), extent.z);
+                if (mScale <= 0.f) {
+                    mScale = 1.f;
+                }
+
+                mPositions.resize(vertices.size());
+                mNormals.resize(vertices.size());
+                mTextureCoords.resize(vertices.size());
+                for (size_t i = 0; i < vertices.size(); i++) {
+                    const auto &vertex = vertices[i];
+                    float normalLength = glm::length(vertex.normal);
+
+                    mPositions[i] = (glm::vec3(vertex.position) - minimum) / mScale;
+                    mNormals[i] = normalLength > 0.f ? vertex.normal / normalLength : vertex.normal;
+                    mTextureCoords[i] = glm::vec2(vertex.textureCoords);
+                }
+            }
+
+            /// Vertices sharing a position sit on an attribute seam and are locked, collapsing one side only would tear the seam open
+            void classifyVertices() {
+                size_t vertexCount = mPositions.size();
+                mPositionIDs.resize(vertexCount);
+                std::vector<uint32_t> siblingCounts(vertexCount, 0);
+
+                std::unordered_map<glm::vec3, uint32_t, PositionHash> firstVertices;
+                firstVertices.reserve(vertexCount);
+                for (uint32_t v = 0; v < vertexCount; v++) {
+                    uint32_t id = firstVertices.emplace(mPositions[v], v).first->second;
+                    mPositionIDs[v] = id;
+                    siblingCounts[id]++;
+                }
+
+                // Edges are matched by positions, so triangles meeting at a seam still count as neighbours
+                std::unordered_map<uint64_t, uint32_t> directedEdges;
+                directedEdges.reserve(mIndices.size());
+                for (size_t i = 0; i < mIndices.size(); i += 3) {
+                    for (size_t e = 0; e < 3; e++) {
+                        uint32_t from = mPositionIDs[mIndices[i + e]];
+                        uint32_t to = mPositionIDs[mIndices[i + (e + 1) % 3]];
+                        directedEdges[EdgeKey(from, to)]++;
+                    }
+                }
+
+                std::vector<uint32_t> openOut(vertexCount, 0);
+                std::vector<uint32_t> openIn(vertexCount, 0);
+                std::vector<bool> isComplex(vertexCount, false);
+
+                for (const auto &edge : directedEdges) {
+                    uint32_t from = uint32_t(edge.first >> 32);
+                    uint32_t to = uint32_t(edge.first & 0xFFFFFFFF);
+
+                    if (edge.second > 1) {
+                        isComplex[from] = isComplex[to] = true;
+                    }
+
+                    if (directedEdges.find(EdgeKey(to, from)) == directedEdges.end()) {
+                        mOpenEdges.insert(edge.first);
+                        openOut[from]++;
+                        openIn[to]++;
+                    }
+                }
+
+                mKinds.resize(vertexCount);
+                for (uint32_t v = 0; v < vertexCount; v++) {
+                    uint32_t id = mPositionIDs[v];
+
+                    if (siblingCounts[id] > 1 || isComplex[id]) {
+                        mKinds[v] = VertexKind::Locked;
+                    } else if (openOut[id] == 0 && openIn[id] == 0) {
+                        mKinds[v] = VertexKind::Manifold;
+                    } else if (openOut[id] == 1 && openIn[id] == 1) {
+                        mKinds[v] = VertexKind::Border;
+                    } else {
+                        mKinds[v] = VertexKind::Locked;
+                    }
+                }
+            }
+
+            void accumulateQuadrics() {
+                mQuadrics.assign(mPositions.size(), Quadric());
+
+                for (size_t i = 0; i < mIndices.size(); i += 3) {
+                    const uint32_t *corners = &mIndices[i];
+                    const glm::vec3 &p0 = mPositions[corners[0]];
+                    glm::vec3 normal = glm::cross(mPositions[corners[1]] - p0, mPositions[corners[2]] - p0);
+                    float length = glm::length(normal);
+                    if (length <= 0.f) {
+                        continue;
+                    }
+
+                    normal /= length;
+                    float area = length * 0.5f;
+                    for (size_t k = 0; k < 3; k++) {
+                        mQuadrics[corners[k]].addPlane(normal, -glm::dot(normal, p0), area);
+                    }
+
+                    // Planes perpendicular to the face through its open edges keep borders in place
+                    for (size_t e = 0; e < 3; e++) {
+                        uint32_t from = corners[e];
+                        uint32_t to = corners[(e + 1) % 3];
+                        if (!isOpenEdge(from, to)) {
+                            continue;
+                        }
+
+                        glm::vec3 edge = mPositions[to] - mPositions[from];
+                        glm::vec3 borderNormal = glm::cross(edge, normal);
+                        float borderLength = glm::length(borderNormal);
+                        if (borderLength <= 0.f) {
+                            continue;
+                        }
+
+                        borderNormal /= borderLength;
+                        float distance = -glm::dot(borderNormal, mPositions[from]);
+                        float weight = glm::dot(edge, edge) * BorderWeight;
+                        mQuadrics[from].addPlane(borderNormal, distance, weight);
+                        mQuadrics[to].addPlane(borderNormal, distance, weight);
+                    }
+                }
+            }
+
+            bool isOpenEdge(uint32_t a, uint32_t b) const {
+                uint32_t idA = mPositionIDs[a];
+                uint32_t idB = mPositionIDs[b];
+                return mOpenEdges.count(EdgeKey(idA, idB)) || mOpenEdges.count(EdgeKey(idB, idA));
+            }
+
+            bool canCollapse(uint32_t from, uint32_t to) const {
+                switch (mKinds[from]) {
+                    case VertexKind::Manifold:
+                        return true;
+
+                    case VertexKind::Border:
+                        return mKinds[to] != VertexKind::Manifold && isOpenEdge(from, to);
+
+                    default:
+                        return false;
+                }
+            }
+
+            Collapse evaluate(uint32_t from, uint32_t to) const {
+                float geometricError = mQuadrics[from].error(mPositions[to]);
+                glm::vec3 normalDelta = mNormals[from] - mNormals[to];
+                glm::vec2 textureCoordsDelta = mTextureCoords[from] - mTextureCoords[to];
+
+                float cost = geometricError +
+                             NormalWeight * glm::dot(normalDelta, normalDelta) +
+                             TextureCoordsWeight * glm::dot(textureCoordsDelta, textureCoordsDelta);
+
+                return {from, to, cost, geometricError};
+            }
+
+            /// Moving a vertex must not turn any of the surrounding triangles over, or even tilt them steeply,
+            /// since steep tilts add up to folds over consecutive collapses
+            bool flipsTriangles(uint32_t from, uint32_t to, const std::vector<uint32_t> &offsets, const std::vector<uint32_t> &triangles) const {
+                for (uint32_t i = offsets[from]; i < offsets[from + 1]; i++) {
+                    const uint32_t *corners = &mIndices[triangles[i] * 3];
+                    if (corners[0] == to || corners[1] == to || corners[2] == to) {
+                        continue;
+                    }
+
+                    glm::vec3 p[3];
+                    glm::vec3 moved[3];
+                    for (size_t k = 0; k < 3; k++) {
+                        p[k] = mPositions[corners[k]];
+                        moved[k] = corners[k] == from ? mPositions[to] : p[k];
+                    }
+
+                    glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    glm::vec3 after = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+                    if (glm::dot(before, after) <= MaximumTriangleTilt * glm::length(before) * glm::length(after)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /// @return whether anything was collapsed
+            bool collapsePass(size_t targetIndexCount, float &maximumError) {
+                size_t vertexCount = mPositions.size();
+                size_t triangleCount = mIndices.size() / 3;
+
+                std::vector<uint32_t> offsets(vertexCount + 1, 0);
+                for (uint32_t index : mIndices) {
+                    offsets[index + 1]++;
+                }
+                for (size_t v = 0; v < vertexCount; v++) {
+                    offsets[v + 1] += offsets[v];
+                }
+
+                std::vector<uint32_t> triangles(mIndices.size());
+                std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < mIndices.size(); i++) {
+                    triangles[cursors[mIndices[i]]++] = uint32_t(i / 3);
+                }
+
+                std::vector<Collapse> collapses;
+                collapses.reserve(mIndices.size());
+                for (size_t i = 0; i < mIndices.size(); i += 3) {
+                    for (size_t e = 0; e < 3; e++) {
+                        uint32_t a = mIndices[i + e];
+                        uint32_t b = mIndices[i + (e + 1) % 3];
+
+                        // Interior edges are seen from both adjacent triangles, only one of them emits the candidate
+                        if (a > b && !isOpenEdge(a, b)) {
+                            continue;
+                        }
+
+                        bool forward = canCollapse(a, b);
+                        bool backward = canCollapse(b, a);
+                        if (forward && backward) {
+                            Collapse ab = evaluate(a, b);
+                            Collapse ba = evaluate(b, a);
+                            collapses.push_back(ab.cost <= ba.cost ? ab : ba);
+                        } else if (forward) {
+                            collapses.push_back(evaluate(a, b));
+                        } else if (backward) {
+                            collapses.push_back(evaluate(b, a));
+                        }
+                    }
+                }
+
+                std::sort(collapses.begin(), collapses.end(), [](const Collapse &lhs, const Collapse &rhs) {
+                    return lhs.cost < rhs.cost;
+                });
+
+                // Interior collapse removes two triangles, stopping halfway to the target leaves room for cheaper collapses next pass
+                size_t targetTriangleCount = targetIndexCount / 3;
+                size_t collapseGoal = triangleCount > targetTriangleCount ? (triangleCount - targetTriangleCount) / 2 + 1 : 0;
+
+                std::vector<uint32_t> remap(vertexCount);
+                for (uint32_t v = 0; v < vertexCount; v++) {
+                    remap[v] = v;
+                }
+
+                // Neighbourhoods of collapsed vertices are frozen until the next pass rebuilds adjacency
+                std::vector<bool> isLocked(vertexCount, false);
+                size_t collapseCount = 0;
+
+                for (const Collapse &collapse : collapses) {
+                    if (collapseCount >= collapseGoal) {
+                        break;
+                    }
+
+                    if (isLocked[collapse.from] || isLocked[collapse.to]) {
+                        continue;
+                    }
+
+                    if (flipsTriangles(collapse.from, collapse.to, offsets, triangles)) {
+                        continue;
+                    }
+
+                    remap[collapse.from] = collapse.to;
+                    mQuadrics[collapse.to] += mQuadrics[collapse.from];
+                    maximumError = std::max(maximumError, collapse.geometricError);
+
+                    for (uint32_t i = offsets[collapse.from]; i < offsets[collapse.from + 1]; i++) {
+                        const uint32_t *corners = &mIndices[triangles[i] * 3];
+                        isLocked[corners[0]] = isLocked[corners[1]] = isLocked[corners[2]] = true;
+                    }
+                    isLocked[collapse.to] = true;
+
+                    collapseCount++;
+                }
+
+                if (collapseCount == 0) {
+                    return false;
+                }
+
+                size_t writePosition = 0;
+                for (size_t i = 0; i < mIndices.size(); i += 3) {
+                    uint32_t a = remap[mIndices[i]];
+                    uint32_t b = remap[mIndices[i + 1]];
+                    uint32_t c = remap[mIndices[i + 2]];
+
+                    if (a != b && b != c && a != c) {
+                        mIndices[writePosition++] = a;
+                        mIndices[writePosition++] = b;
+                        mIndices[writePosition++] = c;
+                    }
+                }
+                mIndices.resize(writePosition);
+
+                return true;
+            }
+
+        public:
+            Simplifier(const std::vector<Vertex1P1N2UV1T1BT> &vertices, const uint32_t *indices, size_t indexCount)
+                    : mIndices(indices, indices + indexCount) {
+                normalizePositions(vertices);
+                classifyVertices();
+                accumulateQuadrics();
+            }
+
+            /// Can be called repeatedly with decreasing targets, quadrics keep the whole collapse history,
+            /// so continuing from the previous result is equivalent to simplifying the original
+            const std::vector<uint32_t> &simplify(size_t targetIndexCount, float &error) {
+                while (mIndices.size() > targetIndexCount && collapsePass(targetIndexCount, mMaximumError));
+
+                error = std::sqrt(mMaximumError) * mScale;
+                return mIndices;
+            }
+        };
+
+    }
+
+    std::vector<uint32_t> MeshSimplifier::Simplify(const std::vector<Vertex1P1N2UV1T1BT> &vertices, const uint32_t *indices, size_t indexCount,
+                                                   size_t targetIndexCount, float *error) {
+        if (indexCount % 3 != 0) {
+            throw std::invalid_argument("Simplified index list has to consist of whole triangles");
+        }
+
+        float resultError = 0.f;
+        std::vector<uint32_t> result;
+
+        if (indexCount <= targetIndexCount) {
+            result.assign(indices, indices + indexCount);
+        } else {
+            result = Simplifier(vertices, indices, indexCount).simplify(targetIndexCount, resultError);
+        }
+
+        if (error) {
+            *error = resultError;
+        }
+        return result;
+    }
+
+    void MeshSimplifier::BuildLevelsOfDetail(Mesh &mesh, size_t levelCount) {
+        if (!mesh.isIndexed()) {
+            throw std::invalid_argument("Mesh has to be welded into an indexed one before building levels of detail");
+        }
+
+        std::vector<uint32_t> &indices = mesh.indices();
+
+        // Rebuilding starts from the full detail level, previously built levels are dropped
+        size_t baseIndexCount = mesh.levelsOfDetail().empty() ? indices.size() : mesh.levelsOfDetail().front().indexCount;
+        indices.resize(baseIndexCount);
+
+        std::vector<Mesh::LevelOfDetail> levels;
+        levels.push_back({0, static_cast<uint32_t>(baseIndexCount), 0.f});
+
+        size_t baseTriangleCount = baseIndexCount / 3;
+
+        // Single simplifier walks down through all levels, errors are still measured against the full detail surface
+        Simplifier simplifier(mesh.vertices(), indices.data(), baseIndexCount);
+
+        for (size_t level = 1; level < levelCount; level++) {
+            size_t targetTriangleCount = baseTriangleCount >> level;
+            if (targetTriangleCount < MinimumLevelTriangleCount) {
+                break;
+            }
+
+            float error = 0.f;
+            const std::vector<uint32_t> &simplified = simplifier.simplify(targetTriangleCount * 3, error);
+
+            if (simplified.empty() || simplified.size() > levels.back().indexCount * MinimumLevelReduction) {
+                break;
+            }
+
+            Mesh::LevelOfDetail lod;
+            lod.firstIndex = static_cast<uint32_t>(indices.size());
+            lod.indexCount = static_cast<uint32_t>(simplified.size());
+            lod.error = error;
+            levels.push_back(lod);
+
+            indices.insert(indices.end(), simplified.begin(), simplified.end());
+        }
+
+        mesh.setLevelsOfDetail(levels.size() > 1 ? levels : std::vector<Mesh::LevelOfDetail>());
+    }
+
+}
@@ -0,0 +1,48 @@
+//
+//  MeshSimplifier.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef MeshSimplifier_hpp
+#define MeshSimplifier_hpp
+
+#include "Mesh.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace Engine {
+
+    /**
+     Quadric error metric simplification (Garland, Heckbert 1997) of indexed triangle lists.
+
+     Edges are collapsed onto one of their existing endpoints, so simplified levels reuse the vertex buffer of the full detail mesh
+     and differ only in indices. This also preserves vertex attributes: nothing is resampled, vertices split along
+     texture or normal seams are locked, open borders only slide along themselves, and collapses between vertices with
+     differing normals or texture coordinates are penalized on top of the geometric error.
+     */
+    class MeshSimplifier {
+    public:
+        /// Full detail level included
+        static constexpr size_t DefaultLevelCount = 4;
+
+        /**
+         @param targetIndexCount simplification stops once triangle count drops to that many indices or no collapse is possible
+         @param error receives estimated geometric deviation of the result, in mesh space units
+         @return simplified triangle list indexing the same vertices
+         */
+        static std::vector<uint32_t> Simplify(const std::vector<Vertex1P1N2UV1T1BT> &vertices, const uint32_t *indices, size_t indexCount,
+                                              size_t targetIndexCount, float *error = nullptr);
+
+        /// Appends simplified levels to mesh indices, every level having about half the triangles of the previous one.
+        /// Fewer levels are produced if the mesh stops simplifying.
+        /// @throws std::invalid_argument if the mesh is not indexed
+        static void BuildLevelsOfDetail(Mesh &mesh, size_t levelCount = DefaultLevelCount);
+    };
+
+}
+
+#endif /* MeshSimplifier_hpp */
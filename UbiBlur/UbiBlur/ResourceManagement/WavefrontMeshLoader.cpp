@@ -7,12 +7,89 @@
 //
 
 #include "WavefrontMeshLoader.hpp"
+#include "WavefrontParser.hpp"
+#include "ParallelUtils.hpp"
 
 #include <fstream>
 #include <algorithm>
+#include <cmath>
+
+#include <glm/geometric.hpp>
 
 namespace Engine {
 
+    namespace {
+
+        /// Keeps per-thread partial sums from outweighing the work they are accumulating
+        const size_t MinTrianglesPerRange = 16384;
+        const size_t MinVerticesPerRange = 16384;
+
+        struct TangentSum {
+            glm::vec3 tangent = glm::vec3(0.f);
+            glm::vec3 bitangent = glm::vec3(0.f);
+
+            TangentSum &operator+=(const TangentSum &that) {
+                tangent += that.tangent;
+                bitangent += that.bitangent;
+                return *this;
+            }
+        };
+
+        /// Tangent and bitangent of a triangle following its UV gradients, unnormalized, so that larger faces weigh more
+        /// @return false for triangles with degenerate UVs
+        bool FaceTangents(const Vertex1P1N2UV1T1BT &v0, const Vertex1P1N2UV1T1BT &v1, const Vertex1P1N2UV1T1BT &v2, TangentSum &face) {
+            glm::vec3 edge1 = glm::vec3(v1.position - v0.position);
+            glm::vec3 edge2 = glm::vec3(v2.position - v0.position);
+            glm::vec2 deltaUV1 = glm::vec2(v1.textureCoords - v0.textureCoords);
+            glm::vec2 deltaUV2 = glm::vec2(v2.textureCoords - v0.textureCoords);
+
+            float f = 1.f / (deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y);
+            if (!std::isfinite(f)) {
+                return false;
+            }
+
+            face.tangent = f * (deltaUV2.y * edge1 - deltaUV1.y * edge2);
+            face.bitangent = f * (deltaUV1.x * edge2 - deltaUV2.x * edge1);
+            return true;
+        }
+
+        /**
+         Runs accumulate(triangle, sums) over triangle ranges in parallel, every range writing into its own copy of the sums,
+         which are reduced afterwards. No locks and no atomics, at the cost of one sums array per range.
+         */
+        template<typename Value, typename Accumulate>
+        std::vector<Value> AccumulateOverTriangles(size_t triangleCount, size_t valueCount, const Accumulate &accumulate) {
+            size_t rangeCount = std::max(std::min(Utils::Parallel::ConcurrencyLevel(), triangleCount / MinTrianglesPerRange), size_t(1));
+            std::vector<std::vector<Value>> partialSums(rangeCount);
+
+            Utils::Parallel::For(rangeCount, 1, [&](size_t begin, size_t end) {
+                for (size_t range = begin; range < end; range++) {
+                    std::vector<Value> &sums = partialSums[range];
+                    sums.assign(valueCount, Value());
+
+                    size_t firstTriangle = triangleCount * range / rangeCount;
+                    size_t lastTriangle = triangleCount * (range + 1) / rangeCount;
+                    for (size_t triangle = firstTriangle; triangle < lastTriangle; triangle++) {
+                        accumulate(triangle, sums);
+                    }
+                }
+            });
+
+            std::vector<Value> result = std::move(partialSums[0]);
+            Utils::Parallel::For(valueCount, MinVerticesPerRange, [&](size_t begin, size_t end) {
+                for (size_t range = 1; range < rangeCount; range++) {
+                    const std::vector<Value> &sums = partialSums[range];
+                    for (size_t i = begin; i < end; i++) {
+                        result[i] += sums[i];
+                    }
+                }
+            });
+
+            return result;
+        }
+
+    }
+
     void WavefrontMeshLoader::vertexCallback(void *userData, float x, float y, float z, float w) {
         WavefrontMeshLoader *thisPtr = reinterpret_cast<WavefrontMeshLoader *>(userData);
 
@@ -98,7 +175,6 @@ namespace Engine {
 
     void WavefrontMeshLoader::processTriangle(const std::array<tinyobj::index_t, 3> &indices) {
         std::array<int32_t, 3> positionIndices;
-        std::array<int32_t, 3> texCoordIndices;
         bool shouldBuildTangent = false;
         bool shouldCalculateNormal = false;
 
@@ -123,61 +199,178 @@ namespace Engine {
             shouldBuildTangent = isTexCoordPresent;
 
             positionIndices[i] = fixedVIdx;
-            texCoordIndices[i] = fixedTIdx;
         }
 
+        uint8_t flags = 0;
         if (shouldCalculateNormal) {
-            calculateNormal(positionIndices);
+            flags |= TriangleNeedsNormal;
+            mNeedsNormals = true;
         }
 
         if (shouldBuildTangent) {
-            buildTangentSpace(positionIndices, texCoordIndices);
+            flags |= TriangleHasTexCoords;
         }
+
+        mTriangleFlags.push_back(flags);
+        mCornerPositionIndices.insert(mCornerPositionIndices.end(), positionIndices.begin(), positionIndices.end());
     }
 
-    void WavefrontMeshLoader::buildTangentSpace(const std::array<int32_t, 3> &positionIndices, const std::array<int32_t, 3> &texCoordIndices) {
-        glm::vec3 edge1 = mVertices[positionIndices[1]] - mVertices[positionIndices[0]];
-        glm::vec3 edge2 = mVertices[positionIndices[2]] - mVertices[positionIndices[0]];
-        glm::vec2 deltaUV1 = mTexCoords[texCoordIndices[1]] - mTexCoords[texCoordIndices[0]];
-        glm::vec2 deltaUV2 = mTexCoords[texCoordIndices[2]] - mTexCoords[texCoordIndices[0]];
+    void WavefrontMeshLoader::generateSmoothNormals(Mesh &subMesh) {
+        if (!mNeedsNormals) {
+            return;
+        }
 
-        float f = 1.f / (deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y);
+        size_t triangleCount = mTriangleFlags.size();
+        auto &vertices = subMesh.vertices();
 
-        glm::vec3 tangent;
-        tangent.x = f * (deltaUV2.y * edge1.x - deltaUV1.y * edge2.x);
-        tangent.y = f * (deltaUV2.y * edge1.y - deltaUV1.y * edge2.y);
-        tangent.z = f * (deltaUV2.y * edge1.z - deltaUV1.y * edge2.z);
+        if (mPositionRemap.size() < mVertices.size()) {
+            mPositionRemap.resize(mVertices.size(), -1);
+        }
 
-        glm::vec3 bitangent;
-        bitangent.x = f * (-deltaUV2.x * edge1.x + deltaUV1.x * edge2.x);
-        bitangent.y = f * (-deltaUV2.x * edge1.y + deltaUV1.x * edge2.y);
-        bitangent.z = f * (-deltaUV2.x * edge1.z + deltaUV1.x * edge2.z);
+        // Dense numbering of positions touched by this submesh keeps sum arrays small
+        std::vector<uint32_t> cornerSlots(mCornerPositionIndices.size());
+        uint32_t slotCount = 0;
+        for (size_t triangle = 0; triangle < triangleCount; triangle++) {
+            if (!(mTriangleFlags[triangle] & TriangleNeedsNormal)) {
+                continue;
+            }
 
-        // Update tangent vectors for latest vertices
-        auto size = mSubMeshes->back().vertices().size();
-        for (int32_t i = 1; i <= 3; i++) {
-            auto &vertex = mSubMeshes->back().vertices()[size - i];
-            vertex.tangent = tangent;
-            vertex.bitangent = bitangent;
+            for (size_t corner = triangle * 3; corner < triangle * 3 + 3; corner++) {
+                int32_t &slot = mPositionRemap[mCornerPositionIndices[corner]];
+                if (slot < 0) {
+                    slot = slotCount++;
+                }
+                cornerSlots[corner] = slot;
+            }
         }
+
+        for (int32_t positionIndex : mCornerPositionIndices) {
+            mPositionRemap[positionIndex] = -1;
+        }
+
+        std::vector<glm::vec3> normals = AccumulateOverTriangles<glm::vec3>(triangleCount, slotCount, [&](size_t triangle, std::vector<glm::vec3> &sums) {
+            if (!(mTriangleFlags[triangle] & TriangleNeedsNormal)) {
+                return;
+            }
+
+            size_t corner = triangle * 3;
+            glm::vec3 edge1 = glm::vec3(vertices[corner + 1].position - vertices[corner].position);
+            glm::vec3 edge2 = glm::vec3(vertices[corner + 2].position - vertices[corner].position);
+            glm::vec3 surfaceNormal = glm::cross(edge1, edge2);
+
+            sums[cornerSlots[corner]] += surfaceNormal;
+            sums[cornerSlots[corner + 1]] += surfaceNormal;
+            sums[cornerSlots[corner + 2]] += surfaceNormal;
+        });
+
+        Utils::Parallel::For(slotCount, MinVerticesPerRange, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                float length = glm::length(normals[i]);
+                if (length > 0.f) {
+                    normals[i] /= length;
+                }
+            }
+        });
+
+        Utils::Parallel::For(triangleCount, MinTrianglesPerRange, [&](size_t begin, size_t end) {
+            for (size_t triangle = begin; triangle < end; triangle++) {
+                if (!(mTriangleFlags[triangle] & TriangleNeedsNormal)) {
+                    continue;
+                }
+
+                for (size_t corner = triangle * 3; corner < triangle * 3 + 3; corner++) {
+                    vertices[corner].normal = normals[cornerSlots[corner]];
+                }
+            }
+        });
     }
 
-    void WavefrontMeshLoader::calculateNormal(const std::array<int32_t, 3> &positionIndices) {
-        glm::vec3 edge1 = mVertices[positionIndices[1]] - mVertices[positionIndices[0]];
-        glm::vec3 edge2 = mVertices[positionIndices[2]] - mVertices[positionIndices[0]];
-        glm::vec3 surfaceNormal = glm::cross(edge1, edge2);
+    void WavefrontMeshLoader::generateFaceTangents(Mesh &subMesh) {
+        auto &vertices = subMesh.vertices();
 
-        const int32_t faceVertexCount = 3;
+        Utils::Parallel::For(mTriangleFlags.size(), MinTrianglesPerRange, [&](size_t begin, size_t end) {
+            for (size_t triangle = begin; triangle < end; triangle++) {
+                if (!(mTriangleFlags[triangle] & TriangleHasTexCoords)) {
+                    continue;
+                }
 
-        Mesh &lastSubMesh = mSubMeshes->back();
+                size_t corner = triangle * 3;
+                TangentSum face;
+                FaceTangents(vertices[corner], vertices[corner + 1], vertices[corner + 2], face);
 
-        for (int32_t i = 0; i < faceVertexCount; i++) {
-            auto &normalData = mManualNormals[positionIndices[i]];
-            normalData.first += surfaceNormal;
-            // Indicate that [submeshVertexIndex] vertex should receive averaged normal afterwards (normalData.first)
-            int32_t submeshVertexIndex = static_cast<int32_t>(lastSubMesh.vertices().size()) - (faceVertexCount - i);
-            normalData.second.emplace_back(submeshVertexIndex);
+                for (size_t i = corner; i < corner + 3; i++) {
+                    vertices[i].tangent = face.tangent;
+                    vertices[i].bitangent = face.bitangent;
+                }
+            }
+        });
+    }
+
+    void WavefrontMeshLoader::accumulateVertexTangents(Mesh &subMesh) {
+        auto &vertices = subMesh.vertices();
+        const auto &indices = subMesh.indices();
+
+        bool hasTexCoords = std::any_of(mTriangleFlags.begin(), mTriangleFlags.end(), [](uint8_t flags) {
+            return (flags & TriangleHasTexCoords) != 0;
+        });
+
+        if (!hasTexCoords) {
+            return;
         }
+
+        // Welding never merges corners of opposite handedness, so faces summed into a vertex agree on it
+        std::vector<TangentSum> tangents = AccumulateOverTriangles<TangentSum>(mTriangleFlags.size(), vertices.size(), [&](size_t triangle, std::vector<TangentSum> &sums) {
+            if (!(mTriangleFlags[triangle] & TriangleHasTexCoords)) {
+                return;
+            }
+
+            const uint32_t *corners = &indices[triangle * 3];
+            TangentSum face;
+            if (!FaceTangents(vertices[corners[0]], vertices[corners[1]], vertices[corners[2]], face)) {
+                return;
+            }
+
+            sums[corners[0]] += face;
+            sums[corners[1]] += face;
+            sums[corners[2]] += face;
+        });
+
+        Utils::Parallel::For(vertices.size(), MinVerticesPerRange, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const TangentSum &sum = tangents[i];
+                auto &vertex = vertices[i];
+
+                // Untouched vertices belong to triangles without texture coordinates
+                if (sum.tangent == glm::vec3(0.f) && sum.bitangent == glm::vec3(0.f)) {
+                    continue;
+                }
+
+                // Gram-Schmidt against the normal, bitangent is rebuilt keeping the accumulated handedness
+                glm::vec3 normal = vertex.normal;
+                float normalLength = glm::length(normal);
+                glm::vec3 tangent = sum.tangent;
+                if (normalLength > 0.f) {
+                    normal /= normalLength;
+                    tangent -= normal * glm::dot(normal, tangent);
+                }
+
+                float tangentLength = glm::length(tangent);
+                if (tangentLength <= 0.f || normalLength <= 0.f) {
+                    vertex.tangent = glm::vec3(0.f);
+                    vertex.bitangent = glm::vec3(0.f);
+                    continue;
+                }
+
+                tangent /= tangentLength;
+                glm::vec3 bitangent = glm::cross(normal, tangent);
+                if (glm::dot(bitangent, sum.bitangent) < 0.f) {
+                    bitangent = -bitangent;
+                }
+
+                vertex.tangent = tangent;
+                vertex.bitangent = bitangent;
+            }
+        });
     }
 
     int32_t WavefrontMeshLoader::fixIndex(int32_t idx, int32_t n) {
@@ -193,20 +386,22 @@ namespace Engine {
     }
 
     void WavefrontMeshLoader::finalizeSubMesh(Mesh &subMesh) {
-        // Check if manual normal calculation took place in triangle callback
-        if (mManualNormals.size()) {
-            for (auto &keyObjectPair : mManualNormals) {
-                glm::vec3 normal = glm::normalize(keyObjectPair.second.first);
-                std::vector<int32_t> &vertexIndices = keyObjectPair.second.second;
-                for (auto submeshVertexIdx : vertexIndices) {
-                    subMesh.vertices()[submeshVertexIdx].normal = normal;
-                }
-            }
-            mManualNormals.clear();
-        }
+        generateSmoothNormals(subMesh);
+        generateFaceTangents(subMesh);
+
+        // Triangles are emitted with three unique vertices each, shared corners are merged only now,
+        // when normals are final and face tangents tell mirrored UV islands apart
+        subMesh.weldVertices();
+
+        accumulateVertexTangents(subMesh);
+
+        mCornerPositionIndices.clear();
+        mTriangleFlags.clear();
+        mNeedsNormals = false;
     }
 
-    WavefrontMeshLoader::WavefrontMeshLoader(const std::string &meshPath) : mMeshPath(meshPath) {}
+    WavefrontMeshLoader::WavefrontMeshLoader(const std::string &meshPath, bool parallelParsing)
+            : mMeshPath(meshPath), mParallelParsing(parallelParsing) {}
 
     void WavefrontMeshLoader::load(std::vector<Mesh> &subMeshes, std::string &meshName, AxisAlignedBox3D &boundingBox) {
         mSubMeshes = &subMeshes;
@@ -224,14 +419,25 @@ namespace Engine {
         cb.usemtl_cb = materialCallback;
 
         std::string err;
-        std::ifstream ifs(mMeshPath.c_str());
+        bool ret = false;
 
-        if (ifs.fail()) {
-            std::cerr << "file not found." << std::endl;
-            return;
+        if (mParallelParsing) {
+            if (!WavefrontParser::Parse(mMeshPath, cb, this, &err)) {
+                std::cerr << "file not found." << std::endl;
+                return;
+            }
+            ret = true;
+        } else {
+            std::ifstream ifs(mMeshPath.c_str());
+
+            if (ifs.fail()) {
+                std::cerr << "file not found." << std::endl;
+                return;
+            }
+
+            ret = tinyobj::LoadObjWithCallback(ifs, cb, this, nullptr, &err);
         }
 
-        bool ret = tinyobj::LoadObjWithCallback(ifs, cb, this, nullptr, &err);
         meshName = mMeshName;
 
         finalizeSubMesh(mSubMeshes->back());
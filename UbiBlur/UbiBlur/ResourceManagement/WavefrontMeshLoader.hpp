@@ -12,7 +12,7 @@
 #include <string>
 #include <vector>
 #include <array>
-#include <unordered_map>
+#include <cstdint>
 
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
@@ -24,15 +24,22 @@ namespace Engine {
 
     class WavefrontMeshLoader {
     private:
-        /// Objects of such type contain averaged normal for a vertex and indices of vertices
-        /// in current submesh which are sharing this normal
-        using SmoothNormalData = std::pair<glm::vec3, std::vector<int32_t>>;
+        enum TriangleFlags : uint8_t {
+            TriangleNeedsNormal = 1 << 0,
+            TriangleHasTexCoords = 1 << 1
+        };
 
         std::string mMeshPath;
+        bool mParallelParsing = true;
         std::vector<glm::vec4> mVertices;
         std::vector<glm::vec3> mNormals;
         std::vector<glm::vec3> mTexCoords;
-        std::unordered_map<int32_t, SmoothNormalData> mManualNormals;
+        /// Position index of every corner of the current submesh, smooth normals are shared by corners with the same position
+        std::vector<int32_t> mCornerPositionIndices;
+        std::vector<uint8_t> mTriangleFlags;
+        bool mNeedsNormals = false;
+        /// Maps position indices to dense per-submesh ones, kept filled with -1 between submeshes
+        std::vector<int32_t> mPositionRemap;
         std::vector<Mesh> *mSubMeshes;
         AxisAlignedBox3D *mBoundingBox;
         std::string mMeshName;
@@ -53,9 +60,14 @@ namespace Engine {
 
         void processTriangle(const std::array<tinyobj::index_t, 3> &indices);
 
-        void buildTangentSpace(const std::array<int32_t, 3> &positionIndices, const std::array<int32_t, 3> &texCoordIndices);
+        /// Averages face normals over corners sharing a position for triangles which came without normals
+        void generateSmoothNormals(Mesh &subMesh);
 
-        void calculateNormal(const std::array<int32_t, 3> &positionIndices);
+        /// Assigns per-face tangents to corners, so that welding can tell mirrored UV islands apart
+        void generateFaceTangents(Mesh &subMesh);
+
+        /// Accumulates face tangents over welded vertices and orthogonalizes resulting frames against vertex normals
+        void accumulateVertexTangents(Mesh &subMesh);
 
         int32_t fixIndex(int32_t idx, int32_t n);
 
@@ -64,7 +76,9 @@ namespace Engine {
         void finalizeSubMesh(Mesh &subMesh);
 
     public:
-        WavefrontMeshLoader(const std::string &meshPath);
+        /// @param parallelParsing parse memory mapped file on multiple threads instead of streaming it through tinyobj,
+        /// produced meshes are identical
+        WavefrontMeshLoader(const std::string &meshPath, bool parallelParsing = true);
 
         void load(std::vector<Mesh> &subMeshes, std::string &meshName, AxisAlignedBox3D &boundingBox);
     };
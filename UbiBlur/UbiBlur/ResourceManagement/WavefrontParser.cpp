@@ -0,0 +1,506 @@
+//
+//  WavefrontParser.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "WavefrontParser.hpp"
+#include "MemoryMappedFile.hpp"
+#include "ThreadPool.hpp"
+#include "ParallelUtils.hpp"
+
+#include <vector>
+#include <array>
+#include <future>
+#include <cmath>
+#include <cctype>
+#include <cstring>
+#include <algorithm>
+
+namespace Engine {
+
+    namespace {
+
+        /// Chunks smaller than that aren't worth a separate task
+        constexpr size_t MinimumChunkByteCount = 1 << 20;
+
+        /// More chunks than threads let callbacks consume early chunks while later ones are still being parsed
+        constexpr size_t ChunksPerThread = 8;
+
+        /// tinyobj reads names with sscanf("%s") into a buffer of that size
+        constexpr size_t MaximumNameLength = 4095;
+
+        enum class CommandType : uint8_t {
+            Vertices, Normals, TexCoords, Face, Group, Object, Material
+        };
+
+        /// Consecutive vertices, normals and texture coordinates are merged into a single command
+        struct Command {
+            CommandType type;
+            uint32_t count;
+        };
+
+        /// Everything found in a chunk, in a form that can be replayed into the callbacks
+        struct ParsedChunk {
+            std::vector<float> positions;
+            std::vector<float> normals;
+            std::vector<float> texCoords;
+            std::vector<tinyobj::index_t> indices;
+            std::vector<std::string> names;
+            std::vector<Command> commands;
+
+            void append(CommandType type, uint32_t count = 1) {
+                bool isMergeable = type == CommandType::Vertices || type == CommandType::Normals || type == CommandType::TexCoords;
+                if (isMergeable && !commands.empty() && commands.back().type == type) {
+                    commands.back().count += count;
+                } else {
+                    commands.push_back({type, count});
+                }
+            }
+        };
+
+#pragma mark - Line-bounded equivalents of C string functions used by tinyobj
+
+        inline bool IsSpace(char c) {
+            return c == ' ' || c == '\t';
+        }
+
+        inline bool IsDigit(char c) {
+            return static_cast<unsigned int>(c - '0') < 10u;
+        }
+
+        /// Mapped lines are not null-terminated, reading past the end yields the terminator tinyobj would see
+        inline char At(const char *pointer, const char *end) {
+            return pointer < end ? *pointer : '\0';
+        }
+
+        /// strspn(token, " \t")
+        inline const char *SkipBlanks(const char *token, const char *end) {
+            while (token < end && IsSpace(*token)) ++token;
+            return token;
+        }
+
+        /// strspn(token, " \t\r")
+        inline const char *SkipBlanksAndReturns(const char *token, const char *end) {
+            while (token < end && (IsSpace(*token) || *token == '\r')) ++token;
+            return token;
+        }
+
+        /// token + strcspn(token, " \t\r")
+        inline const char *FindDelimiter(const char *token, const char *end) {
+            while (token < end && !IsSpace(*token) && *token != '\r') ++token;
+            return token;
+        }
+
+        /// token + strcspn(token, "/ \t\r")
+        inline const char *FindIndexDelimiter(const char *token, const char *end) {
+            while (token < end && *token != '/' && !IsSpace(*token) && *token != '\r') ++token;
+            return token;
+        }
+
+        /// atoi()
+        int ParseInt(const char *token, const char *end) {
+            while (token < end && std::isspace(static_cast<unsigned char>(*token))) ++token;
+
+            bool isNegative = false;
+            if (token < end && (*token == '+' || *token == '-')) {
+                isNegative = *token == '-';
+                ++token;
+            }
+
+            int64_t value = 0;
+            while (token < end && IsDigit(*token)) {
+                value = value * 10 + (*token - '0');
+                ++token;
+            }
+            return static_cast<int>(isNegative ? -value : value);
+        }
+
+        /// sscanf(token, "%s", buffer)
+        std::string ScanWord(const char *token, const char *end) {
+            while (token < end && std::isspace(static_cast<unsigned char>(*token))) ++token;
+            const char *wordEnd = token;
+            while (wordEnd < end && !std::isspace(static_cast<unsigned char>(*wordEnd))) ++wordEnd;
+            return std::string(token, std::min(size_t(wordEnd - token), MaximumNameLength));
+        }
+
+#pragma mark - Numbers
+
+        /// pow(10.0, -n) tinyobj computes for the n-th decimal digit
+        struct DecimalDigitWeights {
+            std::array<double, 32> values;
+
+            DecimalDigitWeights() {
+                for (size_t i = 0; i < values.size(); ++i) {
+                    values[i] = std::pow(10.0, -double(i));
+                }
+            }
+
+            double operator[](int digit) const {
+                return size_t(digit) < values.size() ? values[digit] : std::pow(10.0, -double(digit));
+            }
+        };
+
+        const DecimalDigitWeights DigitWeights;
+
+        /// Same grammar and the same floating point operations as tinyobj's tryParseDouble,
+        /// so the results are bit-identical, but without a pow() call for every decimal digit
+        bool TryParseDouble(const char *string, const char *end, double &result) {
+            if (string >= end) {
+                return false;
+            }
+
+            double mantissa = 0.0;
+            int exponent = 0;
+            char sign = '+';
+            char exponentSign = '+';
+            const char *current = string;
+            int read = 0;
+
+            if (*current == '+' || *current == '-') {
+                sign = *current;
+                ++current;
+            } else if (!IsDigit(*current)) {
+                return false;
+            }
+
+            while (current != end && IsDigit(*current)) {
+                mantissa *= 10;
+                mantissa += static_cast<int>(*current - '0');
+                ++current;
+                ++read;
+            }
+
+            if (read == 0) {
+                return false;
+            }
+
+            if (current != end && *current == '.') {
+                ++current;
+                read = 1;
+                while (current != end && IsDigit(*current)) {
+                    mantissa += static_cast<int>(*current - '0') * DigitWeights[read];
+                    ++read;
+                    ++current;
+                }
+            }
+
+            if (current != end && (*current == 'e' || *current == 'E')) {
+                ++current;
+                if (current != end && (*current == '+' || *current == '-')) {
+                    exponentSign = *current;
+                    ++current;
+                } else if (!IsDigit(At(current, end))) {
+                    return false;
+                }
+
+                read = 0;
+                while (current != end && IsDigit(*current)) {
+                    exponent *= 10;
+                    exponent += static_cast<int>(*current - '0');
+                    ++current;
+                    ++read;
+                }
+                exponent *= (exponentSign == '+' ? 1 : -1);
+
+                if (read == 0) {
+                    return false;
+                }
+            }
+
+            // Zero exponent makes both pow() and ldexp() exact identities
+            double magnitude = exponent == 0 ? mantissa : std::ldexp(mantissa * std::pow(5.0, exponent), exponent);
+            result = (sign == '+' ? 1 : -1) * magnitude;
+            return true;
+        }
+
+        /// tinyobj's parseFloat
+        float ParseFloat(const char *&token, const char *end, double defaultValue = 0.0) {
+            token = SkipBlanks(token, end);
+            const char *valueEnd = FindDelimiter(token, end);
+            double value = defaultValue;
+            TryParseDouble(token, valueEnd, value);
+            token = valueEnd;
+            return static_cast<float>(value);
+        }
+
+        /// tinyobj's parseRawTriple: i, i/j/k, i//k, i/j
+        tinyobj::index_t ParseIndexTriple(const char *&token, const char *end) {
+            // 0 is an invalid index in OBJ
+            tinyobj::index_t index;
+            index.vertex_index = ParseInt(token, end);
+            index.normal_index = 0;
+            index.texcoord_index = 0;
+
+            token = FindIndexDelimiter(token, end);
+            if (At(token, end) != '/') {
+                return index;
+            }
+            ++token;
+
+            if (At(token, end) == '/') {
+                ++token;
+                index.normal_index = ParseInt(token, end);
+                token = FindIndexDelimiter(token, end);
+                return index;
+            }
+
+            index.texcoord_index = ParseInt(token, end);
+            token = FindIndexDelimiter(token, end);
+            if (At(token, end) != '/') {
+                return index;
+            }
+
+            ++token;
+            index.normal_index = ParseInt(token, end);
+            token = FindIndexDelimiter(token, end);
+            return index;
+        }
+
+#pragma mark - Chunk parsing
+
+        bool StartsWithKeyword(const char *token, const char *end, const char *keyword, size_t length) {
+            return size_t(end - token) > length && std::strncmp(token, keyword, length) == 0 && IsSpace(token[length]);
+        }
+
+        void ParseLine(const char *token, const char *end, ParsedChunk &chunk) {
+            token = SkipBlanks(token, end);
+
+            if (token == end || *token == '#') {
+                return;
+            }
+
+            char second = At(token + 1, end);
+            char third = At(token + 2, end);
+
+            if (*token == 'v' && IsSpace(second)) {
+                token += 2;
+                float x = ParseFloat(token, end);
+                float y = ParseFloat(token, end);
+                float z = ParseFloat(token, end);
+                float w = ParseFloat(token, end, 1.0);
+                chunk.positions.insert(chunk.positions.end(), {x, y, z, w});
+                chunk.append(CommandType::Vertices);
+                return;
+            }
+
+            if (*token == 'v' && second == 'n' && IsSpace(third)) {
+                token += 3;
+                float x = ParseFloat(token, end);
+                float y = ParseFloat(token, end);
+                float z = ParseFloat(token, end);
+                chunk.normals.insert(chunk.normals.end(), {x, y, z});
+                chunk.append(CommandType::Normals);
+                return;
+            }
+
+            if (*token == 'v' && second == 't' && IsSpace(third)) {
+                token += 3;
+                float x = ParseFloat(token, end);
+                float y = ParseFloat(token, end);
+                float z = ParseFloat(token, end);
+                chunk.texCoords.insert(chunk.texCoords.end(), {x, y, z});
+                chunk.append(CommandType::TexCoords);
+                return;
+            }
+
+            if (*token == 'f' && IsSpace(second)) {
+                token = SkipBlanks(token + 2, end);
+
+                uint32_t count = 0;
+                while (token < end && *token != '\r') {
+                    chunk.indices.push_back(ParseIndexTriple(token, end));
+                    token = SkipBlanksAndReturns(token, end);
+                    ++count;
+                }
+
+                if (count > 0) {
+                    chunk.append(CommandType::Face, count);
+                }
+                return;
+            }
+
+            if (StartsWithKeyword(token, end, "usemtl", 6)) {
+                chunk.names.push_back(ScanWord(token + 7, end));
+                chunk.append(CommandType::Material);
+                return;
+            }
+
+            // Material libraries are not loaded
+            if (StartsWithKeyword(token, end, "mtllib", 6)) {
+                return;
+            }
+
+            if (*token == 'g' && IsSpace(second)) {
+                // The first name parsed is 'g' itself
+                uint32_t count = 0;
+                bool isKeyword = true;
+                while (token < end && *token != '\r') {
+                    token = SkipBlanks(token, end);
+                    const char *nameEnd = FindDelimiter(token, end);
+                    if (!isKeyword) {
+                        chunk.names.emplace_back(token, nameEnd);
+                        ++count;
+                    }
+                    isKeyword = false;
+                    token = SkipBlanksAndReturns(nameEnd, end);
+                }
+
+                chunk.append(CommandType::Group, count);
+                return;
+            }
+
+            if (*token == 'o' && IsSpace(second)) {
+                chunk.names.push_back(ScanWord(token + 2, end));
+                chunk.append(CommandType::Object);
+                return;
+            }
+
+            // Unknown commands are ignored
+        }
+
+        ParsedChunk ParseChunk(const char *begin, const char *end) {
+            ParsedChunk chunk;
+
+            while (begin < end) {
+                const char *lineEnd = reinterpret_cast<const char *>(std::memchr(begin, '\n', end - begin));
+                const char *next = lineEnd ? lineEnd + 1 : end;
+                if (!lineEnd) {
+                    lineEnd = end;
+                }
+
+                // Only a single trailing carriage return is trimmed, like tinyobj does
+                if (lineEnd > begin && lineEnd[-1] == '\r') {
+                    --lineEnd;
+                }
+
+                ParseLine(begin, lineEnd, chunk);
+                begin = next;
+            }
+
+            return chunk;
+        }
+
+        /// Chunks start right after a line break, so no line is shared by two of them
+        std::vector<const char *> ChunkBoundaries(const char *data, size_t size, size_t chunkByteCount) {
+            std::vector<const char *> boundaries{data};
+            const char *end = data + size;
+
+            for (size_t offset = chunkByteCount; offset < size; offset += chunkByteCount) {
+                const char *searchStart = std::max(data + offset - 1, boundaries.back());
+                const char *lineBreak = reinterpret_cast<const char *>(std::memchr(searchStart, '\n', end - searchStart));
+                if (!lineBreak) {
+                    break;
+                }
+                if (lineBreak + 1 > boundaries.back() && lineBreak + 1 < end) {
+                    boundaries.push_back(lineBreak + 1);
+                }
+            }
+
+            boundaries.push_back(end);
+            return boundaries;
+        }
+
+#pragma mark - Replaying
+
+        void Replay(ParsedChunk &chunk, const tinyobj::callback_t &callback, void *userData) {
+            const float *position = chunk.positions.data();
+            const float *normal = chunk.normals.data();
+            const float *texCoord = chunk.texCoords.data();
+            tinyobj::index_t *index = chunk.indices.data();
+            const std::string *name = chunk.names.data();
+            std::vector<const char *> groupNames;
+
+            for (const Command &command : chunk.commands) {
+                switch (command.type) {
+                    case CommandType::Vertices:
+                        for (uint32_t i = 0; i < command.count; ++i, position += 4) {
+                            if (callback.vertex_cb) callback.vertex_cb(userData, position[0], position[1], position[2], position[3]);
+                        }
+                        break;
+
+                    case CommandType::Normals:
+                        for (uint32_t i = 0; i < command.count; ++i, normal += 3) {
+                            if (callback.normal_cb) callback.normal_cb(userData, normal[0], normal[1], normal[2]);
+                        }
+                        break;
+
+                    case CommandType::TexCoords:
+                        for (uint32_t i = 0; i < command.count; ++i, texCoord += 3) {
+                            if (callback.texcoord_cb) callback.texcoord_cb(userData, texCoord[0], texCoord[1], texCoord[2]);
+                        }
+                        break;
+
+                    case CommandType::Face:
+                        if (callback.index_cb) callback.index_cb(userData, index, static_cast<int>(command.count));
+                        index += command.count;
+                        break;
+
+                    case CommandType::Group:
+                        groupNames.clear();
+                        for (uint32_t i = 0; i < command.count; ++i, ++name) {
+                            groupNames.push_back(name->c_str());
+                        }
+                        if (callback.group_cb) callback.group_cb(userData, groupNames.empty() ? nullptr : groupNames.data(), static_cast<int>(groupNames.size()));
+                        break;
+
+                    case CommandType::Object:
+                        if (callback.object_cb) callback.object_cb(userData, name->c_str());
+                        ++name;
+                        break;
+
+                    case CommandType::Material:
+                        if (callback.usemtl_cb) callback.usemtl_cb(userData, name->c_str(), -1);
+                        ++name;
+                        break;
+                }
+            }
+        }
+
+    }
+
+#pragma mark - Public
+
+    bool WavefrontParser::Parse(const std::string &path, const tinyobj::callback_t &callback, void *userData, std::string *error) {
+        MemoryMappedFile file(path);
+        if (!file.isOpen()) {
+            if (error) {
+                *error += "Cannot open " + path + "\n";
+            }
+            return false;
+        }
+
+        const char *data = reinterpret_cast<const char *>(file.data());
+        size_t concurrency = Utils::Parallel::ConcurrencyLevel();
+        size_t chunkByteCount = std::max(MinimumChunkByteCount, file.size() / (concurrency * ChunksPerThread));
+        std::vector<const char *> boundaries = ChunkBoundaries(data, file.size(), chunkByteCount);
+        size_t chunkCount = boundaries.size() - 1;
+
+        if (chunkCount <= 1) {
+            ParsedChunk chunk = ParseChunk(boundaries.front(), boundaries.back());
+            Replay(chunk, callback, userData);
+            return true;
+        }
+
+        ThreadPool pool(std::min(concurrency, chunkCount));
+        std::vector<std::future<ParsedChunk>> chunks;
+        chunks.reserve(chunkCount);
+
+        for (size_t i = 0; i < chunkCount; ++i) {
+            const char *begin = boundaries[i];
+            const char *end = boundaries[i + 1];
+            chunks.push_back(pool.enqueue([begin, end] { return ParseChunk(begin, end); }));
+        }
+
+        // Callbacks see chunks in file order, each chunk is released as soon as it has been consumed
+        for (auto &future : chunks) {
+            ParsedChunk chunk = future.get();
+            Replay(chunk, callback, userData);
+        }
+
+        return true;
+    }
+
+}
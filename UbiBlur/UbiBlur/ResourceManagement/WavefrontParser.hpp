@@ -0,0 +1,34 @@
+//
+//  WavefrontParser.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef WavefrontParser_hpp
+#define WavefrontParser_hpp
+
+#include <string>
+
+#include "obj_loader/tiny_obj_loader.h"
+
+namespace Engine {
+
+    /**
+     Multithreaded drop-in replacement for tinyobj::LoadObjWithCallback.
+
+     The file is memory mapped and split at line boundaries into chunks which are tokenized concurrently.
+     Parsed chunks are fed to the callbacks strictly in file order, while later chunks are still being parsed,
+     so clients observe the same sequence of calls with the same values as with tinyobj.
+     Material libraries are not read, usemtl reports material id -1 just like tinyobj does without a MaterialReader.
+     */
+    class WavefrontParser {
+    public:
+        /// @return false if the file could not be opened, error receives the reason
+        static bool Parse(const std::string &path, const tinyobj::callback_t &callback, void *userData, std::string *error = nullptr);
+    };
+
+}
+
+#endif /* WavefrontParser_hpp */
@@ -1,18 +1,23 @@
 #version 400 core
 
 // Attributes
+// Position is normalized relative to the mesh bounding box
 layout (location = 0) in vec4 iPosition;
-layout (location = 1) in vec3 iTexCoords;
+// Both uv channels are normalized relative to the uv ranges of the mesh, lightmap isn't sampled yet
+layout (location = 1) in vec2 iTexCoords;
 layout (location = 2) in vec2 iLightmapCoords;
-layout (location = 3) in vec3 iNormal;
-layout (location = 4) in vec3 iTangent;
-layout (location = 5) in vec3 iBitangent;
+// Quaternion rotating the tangent frame, sign of w is bitangent handedness
+layout (location = 3) in vec4 iTangentFrame;
 
 // Uniforms
 uniform mat4 uModelMat;
 uniform mat4 uNormalMat;
 uniform mat4 uCameraViewMat;
 uniform mat4 uCameraProjectionMat;
+uniform vec3 uPositionOffset;
+uniform vec3 uPositionScale;
+uniform vec2 uTexCoordsOffset;
+uniform vec2 uTexCoordsScale;
 
 // Output
 out vec2 vTexCoords;
@@ -21,21 +26,30 @@ out vec3 vNormal;
 out mat3 vTBN;
 
 // Functions
-mat3 TBN() {
-    vec3 T = normalize(uNormalMat * vec4(iTangent, 0.0)).xyz;
-    vec3 B = normalize(uNormalMat * vec4(iBitangent, 0.0)).xyz;
-    vec3 N = normalize(uNormalMat * vec4(iNormal, 0.0)).xyz;
+mat3 TangentFrame() {
+    vec4 q = normalize(iTangentFrame);
+    vec3 T = vec3(1.0 - 2.0 * (q.y * q.y + q.z * q.z), 2.0 * (q.x * q.y + q.w * q.z), 2.0 * (q.x * q.z - q.w * q.y));
+    vec3 N = vec3(2.0 * (q.x * q.z + q.w * q.y), 2.0 * (q.y * q.z - q.w * q.x), 1.0 - 2.0 * (q.x * q.x + q.y * q.y));
+    vec3 B = cross(N, T) * (iTangentFrame.w < 0.0 ? -1.0 : 1.0);
+    return mat3(T, B, N);
+}
+
+mat3 TBN(mat3 frame) {
+    vec3 T = normalize(uNormalMat * vec4(frame[0], 0.0)).xyz;
+    vec3 B = normalize(uNormalMat * vec4(frame[1], 0.0)).xyz;
+    vec3 N = normalize(uNormalMat * vec4(frame[2], 0.0)).xyz;
     return mat3(T, B, N);
 }
 
 void main() {
-    vec4 worldPosition = uModelMat * iPosition;
-    mat3 TBN = TBN();
+    vec4 position = vec4(uPositionOffset + iPosition.xyz * uPositionScale, 1.0);
+    vec4 worldPosition = uModelMat * position;
+    mat3 frame = TangentFrame();
 
-    vTexCoords = iTexCoords.st;
+    vTexCoords = uTexCoordsOffset + iTexCoords * uTexCoordsScale;
     vWorldPosition = worldPosition.xyz;
-	vNormal = iNormal;
-    vTBN = TBN;
+	vNormal = frame[2];
+    vTBN = TBN(frame);
 
     gl_Position = uCameraProjectionMat * uCameraViewMat * worldPosition;
 }
@@ -0,0 +1,16 @@
+#version 400 core
+
+// Uniforms
+uniform sampler2D uImage;
+
+// Inputs
+in vec2 vTexCoords;
+
+// Outputs
+out vec4 oFragColor;
+
+// Functions
+void main() {
+    // Bilinear fetch: averages 2x2 texels when downsampling, interpolates when upsampling
+    oFragColor = textureLod(uImage, vTexCoords, 0.0);
+}
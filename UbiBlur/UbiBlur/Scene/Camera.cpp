@@ -99,6 +99,14 @@ namespace Engine {
         return fabs(clipSpaceVector.w) > std::numeric_limits<float>::epsilon() ? clipSpaceVector / clipSpaceVector.w : clipSpaceVector;
     }
 
+    Ray3D Camera::rayThroughNDC(const glm::vec2 &ndc) const {
+        glm::mat4 inverse = inverseViewProjectionMatrix();
+        glm::vec4 nearPoint = inverse * glm::vec4(ndc, -1.0, 1.0);
+        glm::vec4 farPoint = inverse * glm::vec4(ndc, 1.0, 1.0);
+        glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+        return Ray3D(origin, glm::vec3(farPoint) / farPoint.w - origin);
+    }
+
 #pragma mark - Getters
 
     const glm::vec3 &Camera::position() const {
@@ -10,7 +10,9 @@
 #define Camera_hpp
 
 #include "GLViewport.hpp"
+#include "Ray3D.hpp"
 
+#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/mat4x4.hpp>
 
@@ -57,6 +59,10 @@ namespace Engine {
 
         glm::vec3 worldToNDC(const glm::vec3 &v) const;
 
+        /// Ray from the near plane through a point on the screen, for picking
+        /// @param ndc point in normalized device coordinates, [-1; 1] along both axes with y pointing up
+        Ray3D rayThroughNDC(const glm::vec2 &ndc) const;
+
         const glm::vec3 &position() const;
 
         const glm::vec3 &front() const;
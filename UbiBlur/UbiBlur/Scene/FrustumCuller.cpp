@@ -0,0 +1,203 @@
+//
+//  FrustumCuller.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "FrustumCuller.hpp"
+#include "FrustumCullerAVX.hpp"
+#include "ParallelUtils.hpp"
+
+#include <stdexcept>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FRUSTUM_CULLER_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef FRUSTUM_CULLER_AVX
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace Engine {
+
+    constexpr size_t FrustumCuller::BatchSize;
+
+    static_assert(FrustumCuller::BatchSize == FrustumCulling::BatchSize, "AVX kernel processes batches of a different size");
+
+    namespace {
+
+        using FrustumCulling::PlaneSet;
+        using FrustumCulling::BoxArrays;
+
+        /// Threads aren't worth waking up for fewer boxes than BatchesPerRange * BatchSize
+        constexpr size_t BatchesPerRange = 256;
+
+        PlaneSet MakePlaneSet(const Frustum &frustum) {
+            PlaneSet planes;
+            for (size_t p = 0; p < Frustum::PlaneCount; ++p) {
+                for (size_t c = 0; c < 3; ++c) {
+                    planes.normals[p][c] = frustum.planes[p][c];
+                    planes.absoluteNormals[p][c] = std::fabs(frustum.planes[p][c]);
+                }
+                planes.distances[p] = frustum.planes[p].w;
+            }
+            return planes;
+        }
+
+#ifdef FRUSTUM_CULLER_AVX
+
+        /// The binary is built for SSE2, AVX is used only when both the CPU and the OS (saving YMM registers
+        /// on context switches) support it
+        bool IsAVXSupported() {
+#ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 1);
+            bool hasAVX = (info[2] & (1 << 27)) && (info[2] & (1 << 28));
+            return hasAVX && (_xgetbv(0) & 0x6) == 0x6;
+#else
+            unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+            if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+                return false;
+            }
+            bool hasAVX = (ecx & bit_OSXSAVE) && (ecx & bit_AVX);
+            if (!hasAVX) {
+                return false;
+            }
+            // xgetbv is spelled out since the intrinsic would require compiling this file with XSAVE enabled
+            uint32_t xcr0Low = 0, xcr0High = 0;
+            __asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+            return (xcr0Low & 0x6) == 0x6;
+#endif
+        }
+
+#endif
+
+#if defined(FRUSTUM_CULLER_SSE2)
+
+        /// Same as the AVX kernel, batch is processed as two halves
+        void CullBatch(const BoxArrays &boxes, const PlaneSet &planes, size_t first, uint8_t *visibility) {
+            for (size_t half = 0; half < FrustumCuller::BatchSize; half += 4) {
+                __m128 center[3];
+                __m128 extent[3];
+                for (size_t c = 0; c < 3; ++c) {
+                    center[c] = _mm_loadu_ps(boxes.center[c] + first + half);
+                    extent[c] = _mm_loadu_ps(boxes.extent[c] + first + half);
+                }
+
+                __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+                for (size_t p = 0; p < Frustum::PlaneCount; ++p) {
+                    __m128 distance = _mm_set1_ps(planes.distances[p]);
+                    for (size_t c = 0; c < 3; ++c) {
+                        distance = _mm_add_ps(distance, _mm_mul_ps(center[c], _mm_set1_ps(planes.normals[p][c])));
+                        distance = _mm_add_ps(distance, _mm_mul_ps(extent[c], _mm_set1_ps(planes.absoluteNormals[p][c])));
+                    }
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+                }
+
+                int mask = _mm_movemask_ps(inside);
+                for (size_t k = 0; k < 4; ++k) {
+                    visibility[first + half + k] = uint8_t((mask >> k) & 1);
+                }
+            }
+        }
+
+#else
+
+        void CullBatch(const BoxArrays &boxes, const PlaneSet &planes, size_t first, uint8_t *visibility) {
+            for (size_t k = first; k < first + FrustumCuller::BatchSize; ++k) {
+                bool inside = true;
+                for (size_t p = 0; p < Frustum::PlaneCount && inside; ++p) {
+                    float distance = planes.distances[p];
+                    for (size_t c = 0; c < 3; ++c) {
+                        distance += boxes.center[c][k] * planes.normals[p][c] + boxes.extent[c][k] * planes.absoluteNormals[p][c];
+                    }
+                    inside = distance >= 0.f;
+                }
+                visibility[k] = uint8_t(inside);
+            }
+        }
+
+#endif
+
+    }
+
+    size_t FrustumCuller::add(const AxisAlignedBox3D &box) {
+        // Arrays grow a whole batch at a time, padding is never reported
+        if (mBoxCount % BatchSize == 0) {
+            for (auto component : { &mCenterX, &mCenterY, &mCenterZ, &mExtentX, &mExtentY, &mExtentZ }) {
+                component->resize(mBoxCount + BatchSize, 0.f);
+            }
+        }
+
+        size_t index = mBoxCount++;
+        update(index, box);
+        return index;
+    }
+
+    void FrustumCuller::update(size_t index, const AxisAlignedBox3D &box) {
+        if (index >= mBoxCount) {
+            throw std::out_of_range("Culled box index is out of range");
+        }
+
+        glm::vec3 center = box.center();
+        glm::vec3 extent = (box.max - box.min) * 0.5f;
+
+        mCenterX[index] = center.x;
+        mCenterY[index] = center.y;
+        mCenterZ[index] = center.z;
+        mExtentX[index] = extent.x;
+        mExtentY[index] = extent.y;
+        mExtentZ[index] = extent.z;
+    }
+
+    void FrustumCuller::clear() {
+        for (auto component : { &mCenterX, &mCenterY, &mCenterZ, &mExtentX, &mExtentY, &mExtentZ }) {
+            component->clear();
+        }
+        mBoxCount = 0;
+    }
+
+    size_t FrustumCuller::boxCount() const {
+        return mBoxCount;
+    }
+
+    void FrustumCuller::cull(const Frustum &frustum, std::vector<uint8_t> &visibility) const {
+#ifdef FRUSTUM_CULLER_AVX
+        static const bool UseAVX = IsAVXSupported();
+#endif
+
+        PlaneSet planes = MakePlaneSet(frustum);
+        BoxArrays boxes{
+            { mCenterX.data(), mCenterY.data(), mCenterZ.data() },
+            { mExtentX.data(), mExtentY.data(), mExtentZ.data() }
+        };
+        size_t batchCount = mCenterX.size() / BatchSize;
+
+        // Padded lanes get written and dropped by the final resize, so batches never need a partial tail
+        visibility.resize(batchCount * BatchSize);
+
+        Utils::Parallel::For(batchCount, BatchesPerRange, [&](size_t begin, size_t end) {
+#ifdef FRUSTUM_CULLER_AVX
+            if (UseAVX) {
+                FrustumCulling::CullBatchesAVX(boxes, planes, begin, end, visibility.data());
+                return;
+            }
+#endif
+            for (size_t b = begin; b < end; ++b) {
+                CullBatch(boxes, planes, b * BatchSize, visibility.data());
+            }
+        });
+
+        visibility.resize(mBoxCount);
+    }
+
+}
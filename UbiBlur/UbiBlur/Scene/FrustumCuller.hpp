@@ -0,0 +1,59 @@
+//
+//  FrustumCuller.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef FrustumCuller_hpp
+#define FrustumCuller_hpp
+
+#include "Frustum.hpp"
+#include "AxisAlignedBox3D.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace Engine {
+
+    /**
+     Tests world space bounding boxes of submeshes and instances against a view frustum in bulk.
+
+     Boxes are kept as centers and half extents, each component in its own array padded to a whole batch,
+     so that a batch of boxes is tested against a plane with a handful of vector instructions
+     (AVX when the CPU supports it, SSE2 or plain loops otherwise). Large sets are split between threads.
+     */
+    class FrustumCuller {
+    public:
+        /// Boxes tested at once, AVX register width in floats
+        static constexpr size_t BatchSize = 8;
+
+    private:
+        std::vector<float> mCenterX;
+        std::vector<float> mCenterY;
+        std::vector<float> mCenterZ;
+        std::vector<float> mExtentX;
+        std::vector<float> mExtentY;
+        std::vector<float> mExtentZ;
+        size_t mBoxCount = 0;
+
+    public:
+        /// @return index of the box in visibility results
+        size_t add(const AxisAlignedBox3D &box);
+
+        /// Replaces a box, meant for objects moving between frames
+        /// @throws std::out_of_range if there is no box with that index
+        void update(size_t index, const AxisAlignedBox3D &box);
+
+        void clear();
+
+        size_t boxCount() const;
+
+        /// @param visibility resized to boxCount(), receives 1 for every box intersecting the frustum and 0 for culled ones
+        void cull(const Frustum &frustum, std::vector<uint8_t> &visibility) const;
+    };
+
+}
+
+#endif /* FrustumCuller_hpp */
@@ -0,0 +1,55 @@
+//
+//  FrustumCullerAVX.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "FrustumCullerAVX.hpp"
+
+#ifdef FRUSTUM_CULLER_AVX
+
+// Build files enable AVX for this file alone: /arch:AVX in the Visual Studio projects, -mavx in CMake
+#if !defined(__AVX__)
+#error FrustumCullerAVX.cpp has to be compiled with AVX enabled
+#endif
+
+#include <immintrin.h>
+
+namespace Engine {
+    namespace FrustumCulling {
+
+        void CullBatchesAVX(const BoxArrays &boxes, const PlaneSet &planes, size_t firstBatch, size_t endBatch, uint8_t *visibility) {
+            for (size_t b = firstBatch; b < endBatch; ++b) {
+                size_t first = b * BatchSize;
+
+                __m256 center[3];
+                __m256 extent[3];
+                for (size_t c = 0; c < 3; ++c) {
+                    center[c] = _mm256_loadu_ps(boxes.center[c] + first);
+                    extent[c] = _mm256_loadu_ps(boxes.extent[c] + first);
+                }
+
+                __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+                for (size_t p = 0; p < Frustum::PlaneCount; ++p) {
+                    __m256 distance = _mm256_set1_ps(planes.distances[p]);
+                    for (size_t c = 0; c < 3; ++c) {
+                        distance = _mm256_add_ps(distance, _mm256_mul_ps(center[c], _mm256_set1_ps(planes.normals[p][c])));
+                        distance = _mm256_add_ps(distance, _mm256_mul_ps(extent[c], _mm256_set1_ps(planes.absoluteNormals[p][c])));
+                    }
+                    inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+                }
+
+                int mask = _mm256_movemask_ps(inside);
+                for (size_t k = 0; k < BatchSize; ++k) {
+                    visibility[first + k] = uint8_t((mask >> k) & 1);
+                }
+            }
+        }
+
+    }
+}
+
+#endif
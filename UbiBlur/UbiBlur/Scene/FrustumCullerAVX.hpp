@@ -0,0 +1,54 @@
+//
+//  FrustumCullerAVX.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef FrustumCullerAVX_hpp
+#define FrustumCullerAVX_hpp
+
+#include "Frustum.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define FRUSTUM_CULLER_AVX
+#endif
+
+namespace Engine {
+
+    /// Data shared between FrustumCuller and its AVX kernel.
+    /// Types here are plain data on purpose: an inline function compiled into both translation units
+    /// could end up as the AVX encoded copy and crash the SSE2 path on CPUs without AVX.
+    namespace FrustumCulling {
+
+        /// Boxes tested at once, AVX register width in floats
+        constexpr size_t BatchSize = 8;
+
+        /// Plane normals, their absolute values and distance terms, each broadcast to a whole register later on
+        struct PlaneSet {
+            float normals[Frustum::PlaneCount][3];
+            float absoluteNormals[Frustum::PlaneCount][3];
+            float distances[Frustum::PlaneCount];
+        };
+
+        /// Component arrays of all boxes, padded to a whole number of batches
+        struct BoxArrays {
+            const float *center[3];
+            const float *extent[3];
+        };
+
+#ifdef FRUSTUM_CULLER_AVX
+        /// Lives in FrustumCullerAVX.cpp, the only file compiled with AVX enabled.
+        /// Must only be called after the CPU and the OS were checked for AVX support.
+        void CullBatchesAVX(const BoxArrays &boxes, const PlaneSet &planes, size_t firstBatch, size_t endBatch, uint8_t *visibility);
+#endif
+
+    }
+
+}
+
+#endif /* FrustumCullerAVX_hpp */
@@ -0,0 +1,248 @@
+//
+//  LooseOctree.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "LooseOctree.hpp"
+
+#include <stdexcept>
+
+namespace Engine {
+
+    constexpr size_t LooseOctree::DefaultMaximumDepth;
+    constexpr uint32_t LooseOctree::InvalidNode;
+
+    namespace {
+
+        AxisAlignedBox3D LooseBounds(const AxisAlignedBox3D &cell) {
+            glm::vec3 halfSize = (cell.max - cell.min) * 0.5f;
+            return { cell.min - halfSize, cell.max + halfSize };
+        }
+
+        /// Index of the octet the point falls into, matches the order of AxisAlignedBox3D::octet
+        size_t Octant(const AxisAlignedBox3D &cell, const glm::vec3 &point) {
+            glm::vec3 center = cell.center();
+            return size_t(point.x >= center.x) | size_t(point.y >= center.y) << 1 | size_t(point.z >= center.z) << 2;
+        }
+
+    }
+
+#pragma mark - Lifecycle
+
+    LooseOctree::LooseOctree(const AxisAlignedBox3D &worldBounds, size_t maximumDepth)
+            : mMaximumDepth(maximumDepth) {
+        allocateNode(worldBounds, InvalidNode, 0);
+    }
+
+#pragma mark - Private
+
+    uint32_t LooseOctree::allocateNode(const AxisAlignedBox3D &cell, uint32_t parent, uint32_t depth) {
+        uint32_t index;
+        if (!mFreeNodes.empty()) {
+            index = mFreeNodes.back();
+            mFreeNodes.pop_back();
+        } else {
+            index = static_cast<uint32_t>(mNodes.size());
+            mNodes.emplace_back();
+        }
+
+        Node &node = mNodes[index];
+        node.cell = cell;
+        node.looseBounds = LooseBounds(cell);
+        node.children.fill(InvalidNode);
+        node.parent = parent;
+        node.depth = depth;
+        node.subtreeInstanceCount = 0;
+        node.instances.clear();
+        return index;
+    }
+
+    uint32_t LooseOctree::findNode(const AxisAlignedBox3D &bounds) {
+        uint32_t index = 0;
+        glm::vec3 center = bounds.center();
+
+        while (mNodes[index].depth < mMaximumDepth) {
+            const Node &node = mNodes[index];
+            size_t octant = Octant(node.cell, center);
+            uint32_t child = node.children[octant];
+
+            AxisAlignedBox3D childCell = child != InvalidNode ? mNodes[child].cell : node.cell.octet()[octant];
+            if (!LooseBounds(childCell).contains(bounds)) {
+                break;
+            }
+
+            if (child == InvalidNode) {
+                // Allocation may reallocate the node storage, node reference is not used past this point
+                child = allocateNode(childCell, index, node.depth + 1);
+                mNodes[index].children[octant] = child;
+            }
+
+            index = child;
+        }
+
+        return index;
+    }
+
+    void LooseOctree::attach(InstanceID id, uint32_t nodeIndex) {
+        Instance &instance = mInstances[id];
+        Node &node = mNodes[nodeIndex];
+
+        instance.node = nodeIndex;
+        instance.slot = static_cast<uint32_t>(node.instances.size());
+        node.instances.push_back(id);
+
+        for (uint32_t index = nodeIndex; index != InvalidNode; index = mNodes[index].parent) {
+            ++mNodes[index].subtreeInstanceCount;
+        }
+    }
+
+    void LooseOctree::detach(InstanceID id) {
+        Instance &instance = mInstances[id];
+        Node &node = mNodes[instance.node];
+
+        // Swap with the last one, so that removal doesn't shift the list
+        InstanceID last = node.instances.back();
+        node.instances[instance.slot] = last;
+        mInstances[last].slot = instance.slot;
+        node.instances.pop_back();
+
+        uint32_t index = instance.node;
+        instance.node = InvalidNode;
+
+        while (index != InvalidNode) {
+            Node &current = mNodes[index];
+            uint32_t parent = current.parent;
+
+            // Descendants of an emptied node have been released before it, on the way up
+            if (--current.subtreeInstanceCount == 0 && parent != InvalidNode) {
+                Node &parentNode = mNodes[parent];
+                for (uint32_t &child : parentNode.children) {
+                    if (child == index) {
+                        child = InvalidNode;
+                    }
+                }
+                mFreeNodes.push_back(index);
+            }
+
+            index = parent;
+        }
+    }
+
+    void LooseOctree::collectSubtree(uint32_t nodeIndex, std::vector<InstanceID> &instances) const {
+        const Node &node = mNodes[nodeIndex];
+        instances.insert(instances.end(), node.instances.begin(), node.instances.end());
+
+        for (uint32_t child : node.children) {
+            if (child != InvalidNode) {
+                collectSubtree(child, instances);
+            }
+        }
+    }
+
+    const LooseOctree::Instance &LooseOctree::liveInstance(InstanceID id) const {
+        if (id >= mInstances.size() || mInstances[id].node == InvalidNode) {
+            throw std::out_of_range("Octree has no instance with this identifier");
+        }
+        return mInstances[id];
+    }
+
+#pragma mark - Public
+
+    LooseOctree::InstanceID LooseOctree::insert(const AxisAlignedBox3D &bounds) {
+        InstanceID id;
+        if (!mFreeInstances.empty()) {
+            id = mFreeInstances.back();
+            mFreeInstances.pop_back();
+        } else {
+            id = static_cast<InstanceID>(mInstances.size());
+            mInstances.emplace_back();
+        }
+
+        mInstances[id].bounds = bounds;
+        attach(id, findNode(bounds));
+        ++mInstanceCount;
+        return id;
+    }
+
+    void LooseOctree::move(InstanceID id, const AxisAlignedBox3D &bounds) {
+        liveInstance(id);
+
+        Instance &instance = mInstances[id];
+        const Node &node = mNodes[instance.node];
+        glm::vec3 center = bounds.center();
+
+        // Small moves usually keep the instance in its node: the center stays in the cell, so the descent takes the same
+        // octants, the box still fits the loose bounds of the node, hence of all its ancestors, but not of the next child
+        bool staysInNode = node.cell.contains(center) && node.looseBounds.contains(bounds) &&
+                           (node.depth >= mMaximumDepth || !LooseBounds(node.cell.octet()[Octant(node.cell, center)]).contains(bounds));
+
+        instance.bounds = bounds;
+
+        if (!staysInNode) {
+            // Detaching first, new path might otherwise hang off a node released by the detachment
+            detach(id);
+            attach(id, findNode(bounds));
+        }
+    }
+
+    void LooseOctree::remove(InstanceID id) {
+        liveInstance(id);
+
+        detach(id);
+        mFreeInstances.push_back(id);
+        --mInstanceCount;
+    }
+
+    const AxisAlignedBox3D &LooseOctree::bounds(InstanceID id) const {
+        return liveInstance(id).bounds;
+    }
+
+    size_t LooseOctree::instanceCount() const {
+        return mInstanceCount;
+    }
+
+    size_t LooseOctree::nodeCount() const {
+        return mNodes.size() - mFreeNodes.size();
+    }
+
+    void LooseOctree::query(const Frustum &frustum, std::vector<InstanceID> &visible) const {
+        visible.clear();
+
+        std::vector<uint32_t> pending{ 0 };
+
+        while (!pending.empty()) {
+            uint32_t index = pending.back();
+            pending.pop_back();
+
+            const Node &node = mNodes[index];
+
+            // Root also holds instances outside of the world, its bounds don't cover them
+            if (index != 0) {
+                if (!frustum.intersects(node.looseBounds)) {
+                    continue;
+                }
+
+                if (frustum.contains(node.looseBounds)) {
+                    collectSubtree(index, visible);
+                    continue;
+                }
+            }
+
+            for (InstanceID id : node.instances) {
+                if (frustum.intersects(mInstances[id].bounds)) {
+                    visible.push_back(id);
+                }
+            }
+
+            for (uint32_t child : node.children) {
+                if (child != InvalidNode) {
+                    pending.push_back(child);
+                }
+            }
+        }
+    }
+
+}
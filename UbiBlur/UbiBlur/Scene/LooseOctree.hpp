@@ -0,0 +1,110 @@
+//
+//  LooseOctree.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef LooseOctree_hpp
+#define LooseOctree_hpp
+
+#include "AxisAlignedBox3D.hpp"
+#include "Frustum.hpp"
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace Engine {
+
+    /**
+     Spatial index of dynamic scene instances for visibility queries.
+
+     Every node bounds its contents with its cell grown by half on each side (Ulrich 2000), so an instance fits into
+     the node of the octet its center falls into as long as it is not larger than the cell. Instances therefore never
+     straddle node boundaries and are stored in exactly one node, which makes insertion, moving and removal
+     a single descent plus a constant amount of bookkeeping. Nodes are created on demand and released once empty.
+
+     Queries skip whole subtrees outside the frustum and take subtrees entirely inside it without testing
+     their instances, so their cost follows the visible part of the scene rather than its size.
+     */
+    class LooseOctree {
+    public:
+        using InstanceID = uint32_t;
+
+        static constexpr size_t DefaultMaximumDepth = 8;
+
+    private:
+        static constexpr uint32_t InvalidNode = std::numeric_limits<uint32_t>::max();
+
+        struct Node {
+            AxisAlignedBox3D cell;
+            /// Cell grown by half its size on every side, bounds everything stored in the node
+            AxisAlignedBox3D looseBounds;
+            std::array<uint32_t, 8> children;
+            uint32_t parent = InvalidNode;
+            uint32_t depth = 0;
+            /// Instances in the node and all its descendants, only the root may have none
+            uint32_t subtreeInstanceCount = 0;
+            std::vector<InstanceID> instances;
+        };
+
+        struct Instance {
+            AxisAlignedBox3D bounds;
+            uint32_t node = InvalidNode;
+            /// Position in the instance list of the node
+            uint32_t slot = 0;
+        };
+
+        std::vector<Node> mNodes;
+        std::vector<uint32_t> mFreeNodes;
+        std::vector<Instance> mInstances;
+        std::vector<InstanceID> mFreeInstances;
+        size_t mMaximumDepth;
+        size_t mInstanceCount = 0;
+
+        uint32_t allocateNode(const AxisAlignedBox3D &cell, uint32_t parent, uint32_t depth);
+
+        /// Deepest node whose loose bounds contain the box, created if missing.
+        /// Boxes not fitting into the world go to the root.
+        uint32_t findNode(const AxisAlignedBox3D &bounds);
+
+        void attach(InstanceID id, uint32_t node);
+
+        /// Releases nodes left empty on the way up
+        void detach(InstanceID id);
+
+        void collectSubtree(uint32_t node, std::vector<InstanceID> &instances) const;
+
+        const Instance &liveInstance(InstanceID id) const;
+
+    public:
+        /// @param worldBounds cell of the root, instances outside of it are still indexed, only less efficiently
+        /// @param maximumDepth depth of the smallest cells, the root being at depth 0
+        explicit LooseOctree(const AxisAlignedBox3D &worldBounds, size_t maximumDepth = DefaultMaximumDepth);
+
+        InstanceID insert(const AxisAlignedBox3D &bounds);
+
+        /// @throws std::out_of_range if there is no such instance
+        void move(InstanceID id, const AxisAlignedBox3D &bounds);
+
+        /// Identifier may be handed out again by later insertions
+        /// @throws std::out_of_range if there is no such instance
+        void remove(InstanceID id);
+
+        /// @throws std::out_of_range if there is no such instance
+        const AxisAlignedBox3D &bounds(InstanceID id) const;
+
+        size_t instanceCount() const;
+
+        size_t nodeCount() const;
+
+        /// @param visible cleared and filled with instances whose bounds intersect the frustum, in no particular order
+        void query(const Frustum &frustum, std::vector<InstanceID> &visible) const;
+    };
+
+}
+
+#endif /* LooseOctree_hpp */
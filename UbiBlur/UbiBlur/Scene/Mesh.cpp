@@ -9,8 +9,48 @@
 #include "Mesh.hpp"
 #include "Triangle3D.hpp"
 
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+#include <glm/geometric.hpp>
+
 namespace Engine {
 
+    static_assert(sizeof(Vertex1P1N2UV) % sizeof(uint32_t) == 0, "Corner attributes are hashed as a sequence of 32-bit words");
+    static_assert(sizeof(Vertex1P1N2UV1T1BT) == sizeof(Vertex1P1N2UV) + 2 * sizeof(glm::vec3), "Tangent frame must follow corner attributes without padding");
+
+    /// Corners sharing position, texture coordinates and normal are welded when their tangent frames have the same handedness
+    static bool IsRightHanded(const Vertex1P1N2UV1T1BT &vertex) {
+        return glm::dot(glm::cross(vertex.normal, vertex.tangent), vertex.bitangent) >= 0.f;
+    }
+
+    static uint64_t HashCorner(const Vertex1P1N2UV1T1BT &vertex, bool isRightHanded) {
+        uint32_t words[sizeof(Vertex1P1N2UV) / sizeof(uint32_t)];
+        std::memcpy(words, &vertex, sizeof(words));
+
+        uint64_t hash = 14695981039346656037ull;
+        for (uint32_t word : words) {
+            hash = (hash ^ word) * 1099511628211ull;
+        }
+        hash = (hash ^ uint64_t(isRightHanded)) * 1099511628211ull;
+        return hash ^ (hash >> 32);
+    }
+
+    static bool IsSameCorner(const Vertex1P1N2UV1T1BT &lhs, const Vertex1P1N2UV1T1BT &rhs) {
+        return std::memcmp(&lhs, &rhs, sizeof(Vertex1P1N2UV)) == 0 && IsRightHanded(lhs) == IsRightHanded(rhs);
+    }
+
+    /// Degenerate texture coordinates produce infinite or zero tangents, such directions are rejected
+    static bool NormalizeDirection(const glm::vec3 &direction, glm::vec3 &normalized) {
+        float length = glm::length(direction);
+        if (!std::isfinite(length) || length < 1e-20f) {
+            return false;
+        }
+        normalized = direction / length;
+        return true;
+    }
+
     const std::string &Mesh::name() const {
         return mName;
     }
@@ -31,6 +71,26 @@ namespace Engine {
         return mVertices;
     }
 
+    const std::vector<uint32_t> &Mesh::indices() const {
+        return mIndices;
+    }
+
+    std::vector<uint32_t> &Mesh::indices() {
+        return mIndices;
+    }
+
+    bool Mesh::isIndexed() const {
+        return !mIndices.empty();
+    }
+
+    const std::vector<Mesh::LevelOfDetail> &Mesh::levelsOfDetail() const {
+        return mLevelsOfDetail;
+    }
+
+    void Mesh::setLevelsOfDetail(const std::vector<LevelOfDetail> &levels) {
+        mLevelsOfDetail = levels;
+    }
+
     float Mesh::surfaceArea() const {
         return mArea;
     }
@@ -48,7 +108,12 @@ namespace Engine {
         mBoundingBox.max = glm::max(glm::vec3(vertex.position), mBoundingBox.max);
         mVertices.push_back(vertex);
 
-        if ((mVertices.size() % 3) == 0) {
+        if (isIndexed()) {
+            mIndices.push_back(static_cast<uint32_t>(mVertices.size() - 1));
+        }
+
+        size_t cornerCount = isIndexed() ? mIndices.size() : mVertices.size();
+        if ((cornerCount % 3) == 0) {
             size_t count = mVertices.size();
             auto &v0 = mVertices[count - 3];
             auto &v1 = mVertices[count - 2];
@@ -59,4 +124,59 @@ namespace Engine {
         }
     }
 
+    void Mesh::weldVertices() {
+        const uint32_t emptySlot = std::numeric_limits<uint32_t>::max();
+        size_t cornerCount = isIndexed() ? mIndices.size() : mVertices.size();
+
+        // Open addressing table of indices into the welded vertex array, kept at most half full
+        size_t tableSize = 16;
+        while (tableSize < mVertices.size() * 2) {
+            tableSize *= 2;
+        }
+        size_t mask = tableSize - 1;
+        std::vector<uint32_t> table(tableSize, emptySlot);
+
+        std::vector<Vertex1P1N2UV1T1BT> weldedVertices;
+        std::vector<glm::vec3> tangentSums;
+        std::vector<glm::vec3> bitangentSums;
+        weldedVertices.reserve(mVertices.size());
+        std::vector<uint32_t> indices(cornerCount);
+
+        for (size_t i = 0; i < cornerCount; ++i) {
+            const Vertex1P1N2UV1T1BT &vertex = mVertices[isIndexed() ? mIndices[i] : i];
+            size_t slot = HashCorner(vertex, IsRightHanded(vertex)) & mask;
+
+            while (table[slot] != emptySlot && !IsSameCorner(weldedVertices[table[slot]], vertex)) {
+                slot = (slot + 1) & mask;
+            }
+
+            if (table[slot] == emptySlot) {
+                table[slot] = static_cast<uint32_t>(weldedVertices.size());
+                weldedVertices.push_back(vertex);
+                tangentSums.emplace_back(0.f);
+                bitangentSums.emplace_back(0.f);
+            }
+
+            uint32_t index = table[slot];
+            glm::vec3 direction;
+            if (NormalizeDirection(vertex.tangent, direction)) {
+                tangentSums[index] += direction;
+            }
+            if (NormalizeDirection(vertex.bitangent, direction)) {
+                bitangentSums[index] += direction;
+            }
+            indices[i] = index;
+        }
+
+        // Per-face tangent frames of welded corners are averaged, corners without a usable frame keep the first one
+        for (size_t i = 0; i < weldedVertices.size(); ++i) {
+            NormalizeDirection(tangentSums[i], weldedVertices[i].tangent);
+            NormalizeDirection(bitangentSums[i], weldedVertices[i].bitangent);
+        }
+
+        weldedVertices.shrink_to_fit();
+        mVertices.swap(weldedVertices);
+        mIndices.swap(indices);
+    }
+
 }
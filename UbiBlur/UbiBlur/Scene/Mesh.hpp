@@ -20,10 +20,21 @@
 namespace Engine {
 
     class Mesh {
+    public:
+        /// Range of indices() forming one level of detail
+        struct LevelOfDetail {
+            uint32_t firstIndex = 0;
+            uint32_t indexCount = 0;
+            /// Estimated geometric deviation from the full detail level, in mesh space units
+            float error = 0.f;
+        };
+
     private:
         std::string mName;
         std::string mMaterialName;
         std::vector<Vertex1P1N2UV1T1BT> mVertices;
+        std::vector<uint32_t> mIndices;
+        std::vector<LevelOfDetail> mLevelsOfDetail;
         AxisAlignedBox3D mBoundingBox = AxisAlignedBox3D::MaximumReversed();
         float mArea = 0.0;
 
@@ -40,13 +51,32 @@ namespace Engine {
 
         std::vector<Vertex1P1N2UV1T1BT> &vertices();
 
+        /// Triangle list indices into vertices(), empty until the mesh is welded
+        const std::vector<uint32_t> &indices() const;
+
+        std::vector<uint32_t> &indices();
+
+        bool isIndexed() const;
+
+        /// Levels stored back to back in indices(), starting from the full detail one.
+        /// Empty if the mesh was never simplified, all indices then make up the only level.
+        const std::vector<LevelOfDetail> &levelsOfDetail() const;
+
+        void setLevelsOfDetail(const std::vector<LevelOfDetail> &levels);
+
         float surfaceArea() const;
 
         void setName(const std::string &name);
 
         void setMaterialName(const std::string &name);
 
+        /// Appends a vertex of a new triangle, indexed meshes receive a matching index as well
         void addVertex(const Vertex1P1N2UV1T1BT &vertex);
+
+        /// Merges corners with identical position, texture coordinates and normal and turns the mesh into an indexed one.
+        /// Tangent frames of merged corners are averaged, corners with opposite handedness are never merged.
+        /// Triangles, bounding box and surface area are not affected.
+        void weldVertices();
     };
 
 }
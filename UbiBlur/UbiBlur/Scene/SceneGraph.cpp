@@ -0,0 +1,218 @@
+//
+//  SceneGraph.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "SceneGraph.hpp"
+#include "ParallelUtils.hpp"
+
+#include <glm/matrix.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Engine {
+
+    constexpr SceneGraph::NodeID SceneGraph::NoParent;
+    constexpr size_t SceneGraph::NodesPerRange;
+
+#pragma mark - Private
+
+    void SceneGraph::markDirty(NodeID node) {
+        if (!mDirtyFlags[node]) {
+            mDirtyFlags[node] = true;
+            mDirtyNodes.push_back(node);
+        }
+    }
+
+    bool SceneGraph::hasDirtyAncestor(NodeID node) const {
+        for (NodeID ancestor = mParents[node]; ancestor != NoParent; ancestor = mParents[ancestor]) {
+            if (mDirtyFlags[ancestor]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void SceneGraph::detachFromParent(NodeID node) {
+        NodeID parent = mParents[node];
+        if (parent == NoParent) {
+            return;
+        }
+
+        // Order of children doesn't matter, swap with the last one
+        auto &siblings = mChildren[parent];
+        auto it = std::find(siblings.begin(), siblings.end(), node);
+        *it = siblings.back();
+        siblings.pop_back();
+
+        mParents[node] = NoParent;
+    }
+
+    void SceneGraph::resolveNode(NodeID node) {
+        glm::mat4 local = mLocalTransformations[node].modelMatrix();
+        NodeID parent = mParents[node];
+        glm::mat4 world = parent == NoParent ? local : mWorldMatrices[parent] * local;
+
+        mWorldMatrices[node] = world;
+        // Translation doesn't affect directions, inverting the upper 3x3 part is enough
+        mNormalMatrices[node] = glm::mat4(glm::transpose(glm::inverse(glm::mat3(world))));
+    }
+
+    void SceneGraph::validateNode(NodeID node) const {
+        if (node >= mAliveFlags.size() || !mAliveFlags[node]) {
+            throw std::out_of_range("Scene graph has no node with this identifier");
+        }
+    }
+
+#pragma mark - Public
+
+    SceneGraph::NodeID SceneGraph::createNode(const Transformation &localTransformation, NodeID parent) {
+        if (parent != NoParent) {
+            validateNode(parent);
+        }
+
+        NodeID node;
+        if (!mFreeNodes.empty()) {
+            node = mFreeNodes.back();
+            mFreeNodes.pop_back();
+        } else {
+            node = static_cast<NodeID>(mAliveFlags.size());
+            mLocalTransformations.emplace_back();
+            mParents.push_back(NoParent);
+            mChildren.emplace_back();
+            mWorldMatrices.emplace_back(1.f);
+            mNormalMatrices.emplace_back(1.f);
+            mDirtyFlags.push_back(false);
+            mAliveFlags.push_back(false);
+        }
+
+        mLocalTransformations[node] = localTransformation;
+        mParents[node] = parent;
+        mChildren[node].clear();
+        mAliveFlags[node] = true;
+
+        if (parent != NoParent) {
+            mChildren[parent].push_back(node);
+        }
+
+        markDirty(node);
+        ++mNodeCount;
+        return node;
+    }
+
+    void SceneGraph::destroyNode(NodeID node) {
+        validateNode(node);
+        detachFromParent(node);
+
+        std::vector<NodeID> pending{ node };
+        while (!pending.empty()) {
+            NodeID current = pending.back();
+            pending.pop_back();
+
+            pending.insert(pending.end(), mChildren[current].begin(), mChildren[current].end());
+            mChildren[current].clear();
+            mParents[current] = NoParent;
+            mAliveFlags[current] = false;
+            mFreeNodes.push_back(current);
+            --mNodeCount;
+        }
+    }
+
+    void SceneGraph::setParent(NodeID node, NodeID parent) {
+        validateNode(node);
+        if (parent != NoParent) {
+            validateNode(parent);
+            for (NodeID ancestor = parent; ancestor != NoParent; ancestor = mParents[ancestor]) {
+                if (ancestor == node) {
+                    throw std::invalid_argument("Node can't be parented to itself or to one of its descendants");
+                }
+            }
+        }
+
+        if (mParents[node] == parent) {
+            return;
+        }
+
+        detachFromParent(node);
+        mParents[node] = parent;
+        if (parent != NoParent) {
+            mChildren[parent].push_back(node);
+        }
+        markDirty(node);
+    }
+
+    SceneGraph::NodeID SceneGraph::parent(NodeID node) const {
+        validateNode(node);
+        return mParents[node];
+    }
+
+    void SceneGraph::setLocalTransformation(NodeID node, const Transformation &localTransformation) {
+        validateNode(node);
+        mLocalTransformations[node] = localTransformation;
+        markDirty(node);
+    }
+
+    const Transformation &SceneGraph::localTransformation(NodeID node) const {
+        validateNode(node);
+        return mLocalTransformations[node];
+    }
+
+    const glm::mat4 &SceneGraph::worldMatrix(NodeID node) const {
+        validateNode(node);
+        return mWorldMatrices[node];
+    }
+
+    const glm::mat4 &SceneGraph::normalMatrix(NodeID node) const {
+        validateNode(node);
+        return mNormalMatrices[node];
+    }
+
+    size_t SceneGraph::nodeCount() const {
+        return mNodeCount;
+    }
+
+    size_t SceneGraph::update() {
+        if (mDirtyNodes.empty()) {
+            return 0;
+        }
+
+        // Marked nodes without marked ancestors start the update, their parents' matrices are already up to date
+        // and the rest of the marked nodes are reached through them
+        mCurrentLevel.clear();
+        for (NodeID node : mDirtyNodes) {
+            if (mAliveFlags[node] && !hasDirtyAncestor(node)) {
+                mCurrentLevel.push_back(node);
+            }
+        }
+
+        size_t resolvedCount = 0;
+
+        while (!mCurrentLevel.empty()) {
+            // Nodes of one step never depend on each other
+            Utils::Parallel::For(mCurrentLevel.size(), NodesPerRange, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    resolveNode(mCurrentLevel[i]);
+                }
+            });
+            resolvedCount += mCurrentLevel.size();
+
+            mNextLevel.clear();
+            for (NodeID node : mCurrentLevel) {
+                mNextLevel.insert(mNextLevel.end(), mChildren[node].begin(), mChildren[node].end());
+            }
+            std::swap(mCurrentLevel, mNextLevel);
+        }
+
+        for (NodeID node : mDirtyNodes) {
+            mDirtyFlags[node] = false;
+        }
+        mDirtyNodes.clear();
+
+        return resolvedCount;
+    }
+
+}
@@ -0,0 +1,108 @@
+//
+//  SceneGraph.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef SceneGraph_hpp
+#define SceneGraph_hpp
+
+#include "Transformation.hpp"
+
+#include <glm/mat4x4.hpp>
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+
+namespace Engine {
+
+    /**
+     Hierarchy of local transformations resolved into world and normal matrices.
+
+     Node data is kept in parallel arrays indexed by node identifier. Changing a local transformation or a parent
+     only marks the node, matrices are recomputed by update() for the marked subtrees alone, one depth level
+     at a time, so that every parent is resolved before its children and large levels are split between threads.
+     A hierarchy nobody touched costs nothing to update.
+     */
+    class SceneGraph {
+    public:
+        using NodeID = uint32_t;
+
+        static constexpr NodeID NoParent = std::numeric_limits<NodeID>::max();
+
+    private:
+        /// Levels narrower than this are resolved on the calling thread
+        static constexpr size_t NodesPerRange = 1024;
+
+        std::vector<Transformation> mLocalTransformations;
+        std::vector<NodeID> mParents;
+        std::vector<std::vector<NodeID>> mChildren;
+        std::vector<glm::mat4> mWorldMatrices;
+        std::vector<glm::mat4> mNormalMatrices;
+        /// Set when the node matrices have to be recomputed, stays set until the next update even for destroyed nodes
+        std::vector<uint8_t> mDirtyFlags;
+        std::vector<uint8_t> mAliveFlags;
+
+        std::vector<NodeID> mFreeNodes;
+        /// Nodes marked since the last update, each listed once
+        std::vector<NodeID> mDirtyNodes;
+        size_t mNodeCount = 0;
+
+        /// Scratch lists of nodes resolved by the current and the next update step
+        std::vector<NodeID> mCurrentLevel;
+        std::vector<NodeID> mNextLevel;
+
+        void markDirty(NodeID node);
+
+        bool hasDirtyAncestor(NodeID node) const;
+
+        void detachFromParent(NodeID node);
+
+        void resolveNode(NodeID node);
+
+        /// @throws std::out_of_range if there is no such node
+        void validateNode(NodeID node) const;
+
+    public:
+        /// @param parent NoParent makes the node a root of its own hierarchy
+        /// @throws std::out_of_range if there is no such parent
+        NodeID createNode(const Transformation &localTransformation = Transformation(), NodeID parent = NoParent);
+
+        /// Destroys the whole subtree, identifiers may be handed out again by later creations
+        /// @throws std::out_of_range if there is no such node
+        void destroyNode(NodeID node);
+
+        /// @throws std::out_of_range if either node doesn't exist
+        /// @throws std::invalid_argument if the parent is the node itself or one of its descendants
+        void setParent(NodeID node, NodeID parent);
+
+        /// @throws std::out_of_range if there is no such node
+        NodeID parent(NodeID node) const;
+
+        /// @throws std::out_of_range if there is no such node
+        void setLocalTransformation(NodeID node, const Transformation &localTransformation);
+
+        /// @throws std::out_of_range if there is no such node
+        const Transformation &localTransformation(NodeID node) const;
+
+        /// Up to date as of the last update
+        /// @throws std::out_of_range if there is no such node
+        const glm::mat4 &worldMatrix(NodeID node) const;
+
+        /// Inverse transpose of the world matrix, up to date as of the last update
+        /// @throws std::out_of_range if there is no such node
+        const glm::mat4 &normalMatrix(NodeID node) const;
+
+        size_t nodeCount() const;
+
+        /// Recomputes matrices of every subtree changed since the previous update
+        /// @return number of nodes whose matrices have been recomputed
+        size_t update();
+    };
+
+}
+
+#endif /* SceneGraph_hpp */
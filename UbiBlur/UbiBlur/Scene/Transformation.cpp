@@ -31,7 +31,13 @@ namespace Engine {
     }
 
     glm::mat4 Transformation::modelMatrix() const {
-        return glm::translate(translation) * glm::mat4_cast(rotation) * glm::scale(scale);
+        // Same as translation * rotation * scale, without two full matrix products
+        glm::mat4 matrix = glm::mat4_cast(rotation);
+        matrix[0] *= scale.x;
+        matrix[1] *= scale.y;
+        matrix[2] *= scale.z;
+        matrix[3] = glm::vec4(translation, 1.f);
+        return matrix;
     }
 
     glm::mat4 Transformation::scaleMatrix() const {
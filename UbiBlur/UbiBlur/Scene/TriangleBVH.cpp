@@ -0,0 +1,563 @@
+//
+//  TriangleBVH.cpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#include "TriangleBVH.hpp"
+#include "ParallelUtils.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <array>
+#include <mutex>
+#include <cmath>
+
+#include <glm/geometric.hpp>
+#include <glm/common.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRIANGLE_BVH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Engine {
+
+    constexpr size_t TriangleBVH::BinCount;
+    constexpr size_t TriangleBVH::MaximumLeafTriangles;
+
+    namespace {
+
+        /// SAH costs of visiting a node and intersecting a triangle, relative to each other
+        constexpr float TraversalCost = 1.f;
+        constexpr float IntersectionCost = 1.f;
+
+        /// Deeper nodes are turned into leaves, bounds the traversal stack
+        constexpr size_t MaximumDepth = 64;
+
+        constexpr size_t TrianglesPerRange = 4096;
+
+        struct Bounds {
+            glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+            glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+            void grow(const glm::vec3 &point) {
+                min = glm::min(min, point);
+                max = glm::max(max, point);
+            }
+
+            void grow(const Bounds &bounds) {
+                min = glm::min(min, bounds.min);
+                max = glm::max(max, bounds.max);
+            }
+
+            float surfaceArea() const {
+                if (min.x > max.x) {
+                    return 0.f;
+                }
+                glm::vec3 extent = max - min;
+                return 2.f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+            }
+        };
+
+        struct Bin {
+            Bounds bounds;
+            uint32_t count = 0;
+        };
+
+        using AxisBins = std::array<Bin, TriangleBVH::BinCount>;
+
+        struct BuildTask {
+            uint32_t node;
+            uint32_t begin;
+            uint32_t end;
+            uint32_t depth;
+            Bounds bounds;
+            Bounds centroidBounds;
+        };
+
+        /// Outcome of processing a task, children are only meaningful if it was split
+        struct BuildDecision {
+            bool isLeaf = true;
+            uint32_t middle = 0;
+            Bounds leftBounds;
+            Bounds leftCentroidBounds;
+            Bounds rightBounds;
+            Bounds rightCentroidBounds;
+        };
+
+        /// Triangle bounds carried along while triangles get partitioned, so that binning reads memory sequentially
+        struct BuildPrimitive {
+            glm::vec3 min;
+            uint32_t triangle;
+            glm::vec3 max;
+            float padding;
+
+            glm::vec3 centroid() const {
+                return (min + max) * 0.5f;
+            }
+        };
+
+        using BuildPrimitives = std::vector<BuildPrimitive>;
+
+        /// Maps centroids of a node to bins, small nodes use fewer bins than there are triangles in them
+        struct Binning {
+            size_t binCount;
+            glm::vec3 minimum;
+            glm::vec3 scale;
+
+            Binning(const Bounds &centroidBounds, size_t triangleCount) : minimum(centroidBounds.min) {
+                binCount = std::max(std::min(triangleCount, TriangleBVH::BinCount), size_t(2));
+
+                glm::vec3 extent = centroidBounds.max - centroidBounds.min;
+                for (int axis = 0; axis < 3; ++axis) {
+                    scale[axis] = extent[axis] > 0.f ? float(binCount) / extent[axis] : 0.f;
+                }
+            }
+
+            /// Has to be the only place computing bin indices, so that binning and partitioning always agree
+            size_t index(const glm::vec3 &centroid, size_t axis) const {
+                size_t index = static_cast<size_t>((centroid[axis] - minimum[axis]) * scale[axis]);
+                return std::min(index, binCount - 1);
+            }
+        };
+
+        void BinRange(const BuildPrimitives &primitives, const Binning &binning, size_t begin, size_t end, std::array<AxisBins, 3> &bins) {
+            for (size_t i = begin; i < end; ++i) {
+                const BuildPrimitive &primitive = primitives[i];
+                glm::vec3 centroid = primitive.centroid();
+
+                for (size_t axis = 0; axis < 3; ++axis) {
+                    Bin &bin = bins[axis][binning.index(centroid, axis)];
+                    bin.bounds.min = glm::min(bin.bounds.min, primitive.min);
+                    bin.bounds.max = glm::max(bin.bounds.max, primitive.max);
+                    ++bin.count;
+                }
+            }
+        }
+
+        void MergeBins(std::array<AxisBins, 3> &destination, const std::array<AxisBins, 3> &source, size_t binCount) {
+            for (size_t axis = 0; axis < 3; ++axis) {
+                for (size_t b = 0; b < binCount; ++b) {
+                    destination[axis][b].bounds.grow(source[axis][b].bounds);
+                    destination[axis][b].count += source[axis][b].count;
+                }
+            }
+        }
+
+        /// Fills child bounds of a decision from primitives on either side of its middle
+        void BoundChildren(const BuildPrimitives &primitives, const BuildTask &task, BuildDecision &decision) {
+            for (uint32_t i = task.begin; i < task.end; ++i) {
+                const BuildPrimitive &primitive = primitives[i];
+                bool isLeft = i < decision.middle;
+                Bounds &bounds = isLeft ? decision.leftBounds : decision.rightBounds;
+                bounds.min = glm::min(bounds.min, primitive.min);
+                bounds.max = glm::max(bounds.max, primitive.max);
+                (isLeft ? decision.leftCentroidBounds : decision.rightCentroidBounds).grow(primitive.centroid());
+            }
+        }
+
+        BuildDecision ProcessTask(BuildPrimitives &primitives, const BuildTask &task, bool parallelBinning) {
+            size_t count = task.end - task.begin;
+            bool canBeLeaf = count <= TriangleBVH::MaximumLeafTriangles;
+
+            if (count <= 1 || task.depth + 1 >= MaximumDepth) {
+                return BuildDecision();
+            }
+
+            Binning binning(task.centroidBounds, count);
+            size_t binCount = binning.binCount;
+
+            std::array<AxisBins, 3> bins;
+            if (parallelBinning) {
+                std::mutex binsMutex;
+                Utils::Parallel::For(count, TrianglesPerRange, [&](size_t begin, size_t end) {
+                    std::array<AxisBins, 3> rangeBins;
+                    BinRange(primitives, binning, task.begin + begin, task.begin + end, rangeBins);
+
+                    std::lock_guard<std::mutex> lock(binsMutex);
+                    MergeBins(bins, rangeBins, binCount);
+                });
+            } else {
+                BinRange(primitives, binning, task.begin, task.end, bins);
+            }
+
+            // Sweeps from both sides give areas and counts on either side of every bin boundary
+            float bestCost = std::numeric_limits<float>::max();
+            size_t bestAxis = 3;
+            size_t bestBoundary = 0;
+
+            for (size_t axis = 0; axis < 3; ++axis) {
+                if (binning.scale[axis] == 0.f) {
+                    continue;
+                }
+
+                std::array<float, TriangleBVH::BinCount> rightCosts;
+                Bounds accumulated;
+                uint32_t accumulatedCount = 0;
+                for (size_t b = binCount - 1; b > 0; --b) {
+                    accumulated.grow(bins[axis][b].bounds);
+                    accumulatedCount += bins[axis][b].count;
+                    rightCosts[b] = accumulated.surfaceArea() * accumulatedCount;
+                }
+
+                accumulated = Bounds();
+                accumulatedCount = 0;
+                for (size_t b = 1; b < binCount; ++b) {
+                    accumulated.grow(bins[axis][b - 1].bounds);
+                    accumulatedCount += bins[axis][b - 1].count;
+                    if (accumulatedCount == 0 || accumulatedCount == count) {
+                        continue;
+                    }
+
+                    float cost = accumulated.surfaceArea() * accumulatedCount + rightCosts[b];
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestBoundary = b;
+                    }
+                }
+            }
+
+            BuildDecision decision;
+
+            if (bestAxis == 3) {
+                // Centroids coincide, binning can't tell triangles apart, so the range is simply halved
+                if (canBeLeaf) {
+                    return decision;
+                }
+
+                decision.isLeaf = false;
+                decision.middle = task.begin + static_cast<uint32_t>(count / 2);
+                BoundChildren(primitives, task, decision);
+                return decision;
+            }
+
+            float parentArea = task.bounds.surfaceArea();
+            float splitCost = TraversalCost + IntersectionCost * (parentArea > 0.f ? bestCost / parentArea : float(count));
+            float leafCost = IntersectionCost * count;
+            if (canBeLeaf && splitCost >= leafCost) {
+                return BuildDecision();
+            }
+
+            auto middle = std::partition(primitives.begin() + task.begin, primitives.begin() + task.end, [&](const BuildPrimitive &primitive) {
+                return binning.index(primitive.centroid(), bestAxis) < bestBoundary;
+            });
+
+            decision.isLeaf = false;
+            decision.middle = static_cast<uint32_t>(middle - primitives.begin());
+            BoundChildren(primitives, task, decision);
+            return decision;
+        }
+
+#pragma mark - Traversal
+
+        struct RayData {
+#ifdef TRIANGLE_BVH_SSE2
+            /// Fourth lanes are zero, so that whatever nodes keep there after the bounds doesn't affect the result
+            __m128 origin;
+            __m128 inverseDirection;
+#else
+            glm::vec3 origin;
+            glm::vec3 inverseDirection;
+#endif
+        };
+
+        RayData PrepareRay(const Ray3D &ray) {
+            glm::vec3 inverseDirection;
+            for (int c = 0; c < 3; ++c) {
+                // Axis-parallel rays would produce infinities and NaNs in the slab test, a huge finite factor works the same
+                float d = ray.direction[c];
+                float clamped = std::fabs(d) > 1e-20f ? d : std::copysign(1e-20f, d);
+                inverseDirection[c] = 1.f / clamped;
+            }
+
+            RayData data;
+#ifdef TRIANGLE_BVH_SSE2
+            data.origin = _mm_set_ps(0.f, ray.origin.z, ray.origin.y, ray.origin.x);
+            data.inverseDirection = _mm_set_ps(0.f, inverseDirection.z, inverseDirection.y, inverseDirection.x);
+#else
+            data.origin = ray.origin;
+            data.inverseDirection = inverseDirection;
+#endif
+            return data;
+        }
+
+        /// Slab test of the ray segment [0; maximumDistance] against node bounds
+        /// @param entry receives distance at which the ray enters the box
+        template<typename Node>
+        inline bool IntersectBox(const Node &node, const RayData &ray, float maximumDistance, float &entry) {
+#ifdef TRIANGLE_BVH_SSE2
+            const __m128 boundsMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+            __m128 minimum = _mm_and_ps(_mm_loadu_ps(&node.min.x), boundsMask);
+            __m128 maximum = _mm_and_ps(_mm_loadu_ps(&node.max.x), boundsMask);
+            __m128 t1 = _mm_mul_ps(_mm_sub_ps(minimum, ray.origin), ray.inverseDirection);
+            __m128 t2 = _mm_mul_ps(_mm_sub_ps(maximum, ray.origin), ray.inverseDirection);
+
+            // Fourth lanes turn into the segment limits: zero is already there for the near distances
+            __m128 tNear = _mm_min_ps(t1, t2);
+            __m128 tFar = _mm_or_ps(_mm_and_ps(boundsMask, _mm_max_ps(t1, t2)), _mm_andnot_ps(boundsMask, _mm_set1_ps(maximumDistance)));
+
+            tNear = _mm_max_ps(tNear, _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(1, 0, 3, 2)));
+            tNear = _mm_max_ps(tNear, _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(2, 3, 0, 1)));
+            tFar = _mm_min_ps(tFar, _mm_shuffle_ps(tFar, tFar, _MM_SHUFFLE(1, 0, 3, 2)));
+            tFar = _mm_min_ps(tFar, _mm_shuffle_ps(tFar, tFar, _MM_SHUFFLE(2, 3, 0, 1)));
+
+            entry = _mm_cvtss_f32(tNear);
+            return entry <= _mm_cvtss_f32(tFar);
+#else
+            glm::vec3 t1 = (node.min - ray.origin) * ray.inverseDirection;
+            glm::vec3 t2 = (node.max - ray.origin) * ray.inverseDirection;
+            glm::vec3 tNear = glm::min(t1, t2);
+            glm::vec3 tFar = glm::max(t1, t2);
+
+            entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.f));
+            float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maximumDistance));
+            return entry <= exit;
+#endif
+        }
+
+    }
+
+#pragma mark - Lifecycle
+
+    TriangleBVH::TriangleBVH(const Mesh &mesh) {
+        const auto &vertices = mesh.vertices();
+
+        if (mesh.isIndexed()) {
+            const auto &levels = mesh.levelsOfDetail();
+            size_t indexCount = levels.empty() ? mesh.indices().size() : levels.front().indexCount;
+            build(vertices.data(), vertices.size(), mesh.indices().data(), indexCount / 3);
+        } else {
+            build(vertices.data(), vertices.size(), nullptr, vertices.size() / 3);
+        }
+    }
+
+    TriangleBVH::TriangleBVH(const Vertex1P1N2UV1T1BT *vertices, size_t vertexCount, const uint32_t *indices, size_t indexCount) {
+        if (indexCount % 3 != 0) {
+            throw std::invalid_argument("Triangle list index count has to be a multiple of 3");
+        }
+
+        build(vertices, vertexCount, indices, indexCount / 3);
+    }
+
+#pragma mark - Building
+
+    void TriangleBVH::build(const Vertex1P1N2UV1T1BT *vertices, size_t vertexCount, const uint32_t *indices, size_t triangleCount) {
+        if (triangleCount == 0) {
+            return;
+        }
+
+        // Checked up front, the parallel passes below read vertices without bounds checks
+        if (indices) {
+            for (size_t i = 0; i < triangleCount * 3; ++i) {
+                if (indices[i] >= vertexCount) {
+                    throw std::invalid_argument("Triangle index is out of vertex range");
+                }
+            }
+        } else if (triangleCount * 3 > vertexCount) {
+            throw std::invalid_argument("Non-indexed triangle list is longer than the vertex array");
+        }
+
+        auto position = [&](size_t triangle, size_t corner) {
+            size_t index = indices ? indices[triangle * 3 + corner] : triangle * 3 + corner;
+            return glm::vec3(vertices[index].position);
+        };
+
+        BuildPrimitives primitives(triangleCount);
+
+        BuildTask root{ 0, 0, static_cast<uint32_t>(triangleCount), 0, Bounds(), Bounds() };
+        std::mutex rootMutex;
+
+        Utils::Parallel::For(triangleCount, TrianglesPerRange, [&](size_t begin, size_t end) {
+            Bounds bounds;
+            Bounds centroidBounds;
+
+            for (size_t t = begin; t < end; ++t) {
+                Bounds triangleBounds;
+                for (size_t corner = 0; corner < 3; ++corner) {
+                    triangleBounds.grow(position(t, corner));
+                }
+
+                primitives[t] = { triangleBounds.min, static_cast<uint32_t>(t), triangleBounds.max, 0.f };
+                bounds.grow(triangleBounds);
+                centroidBounds.grow(primitives[t].centroid());
+            }
+
+            std::lock_guard<std::mutex> lock(rootMutex);
+            root.bounds.grow(bounds);
+            root.centroidBounds.grow(centroidBounds);
+        });
+
+        mNodes.reserve(triangleCount * 2 - 1);
+        mNodes.push_back({ root.bounds.min, 0, root.bounds.max, 0 });
+
+        // Breadth-first, nodes of one level are independent and own disjoint ranges of primitives
+        std::vector<BuildTask> tasks{ root };
+        std::vector<BuildTask> nextTasks;
+        std::vector<BuildDecision> decisions;
+
+        while (!tasks.empty()) {
+            decisions.assign(tasks.size(), BuildDecision());
+
+            if (tasks.size() >= Utils::Parallel::ConcurrencyLevel()) {
+                Utils::Parallel::For(tasks.size(), 1, [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        decisions[i] = ProcessTask(primitives, tasks[i], false);
+                    }
+                });
+            } else {
+                for (size_t i = 0; i < tasks.size(); ++i) {
+                    decisions[i] = ProcessTask(primitives, tasks[i], true);
+                }
+            }
+
+            nextTasks.clear();
+            for (size_t i = 0; i < tasks.size(); ++i) {
+                const BuildTask &task = tasks[i];
+                const BuildDecision &decision = decisions[i];
+
+                if (decision.isLeaf) {
+                    mNodes[task.node].offset = task.begin;
+                    mNodes[task.node].triangleCount = task.end - task.begin;
+                    continue;
+                }
+
+                uint32_t left = static_cast<uint32_t>(mNodes.size());
+                mNodes[task.node].offset = left;
+                mNodes.push_back({ decision.leftBounds.min, 0, decision.leftBounds.max, 0 });
+                mNodes.push_back({ decision.rightBounds.min, 0, decision.rightBounds.max, 0 });
+
+                nextTasks.push_back({ left, task.begin, decision.middle, task.depth + 1, decision.leftBounds, decision.leftCentroidBounds });
+                nextTasks.push_back({ left + 1, decision.middle, task.end, task.depth + 1, decision.rightBounds, decision.rightCentroidBounds });
+            }
+
+            tasks.swap(nextTasks);
+        }
+
+        mNodes.shrink_to_fit();
+
+        mTriangleIndices.resize(triangleCount);
+        mTriangles.resize(triangleCount);
+
+        Utils::Parallel::For(triangleCount, TrianglesPerRange, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                uint32_t triangle = primitives[i].triangle;
+                mTriangleIndices[i] = triangle;
+                glm::vec3 vertex = position(triangle, 0);
+                mTriangles[i] = { vertex, position(triangle, 1) - vertex, position(triangle, 2) - vertex };
+            }
+        });
+    }
+
+#pragma mark - Queries
+
+    bool TriangleBVH::closestHit(const Ray3D &ray, Hit &hit, float maximumDistance) const {
+        if (mNodes.empty()) {
+            return false;
+        }
+
+        RayData rayData = PrepareRay(ray);
+        float closest = maximumDistance;
+        bool isHit = false;
+
+        float entry = 0.f;
+        if (!IntersectBox(mNodes.front(), rayData, closest, entry)) {
+            return false;
+        }
+
+        struct StackEntry {
+            uint32_t node;
+            float entry;
+        };
+
+        std::array<StackEntry, MaximumDepth> stack;
+        size_t stackSize = 0;
+        uint32_t nodeIndex = 0;
+
+        while (true) {
+            const Node &node = mNodes[nodeIndex];
+
+            if (node.triangleCount > 0) {
+                for (uint32_t i = node.offset; i < node.offset + node.triangleCount; ++i) {
+                    const LeafTriangle &triangle = mTriangles[i];
+
+                    // Moller-Trumbore, without culling either face
+                    glm::vec3 p = glm::cross(ray.direction, triangle.edge2);
+                    float determinant = glm::dot(triangle.edge1, p);
+                    if (std::fabs(determinant) < std::numeric_limits<float>::min()) {
+                        continue;
+                    }
+
+                    float inverseDeterminant = 1.f / determinant;
+                    glm::vec3 s = ray.origin - triangle.vertex;
+                    float u = glm::dot(s, p) * inverseDeterminant;
+                    if (u < 0.f || u > 1.f) {
+                        continue;
+                    }
+
+                    glm::vec3 q = glm::cross(s, triangle.edge1);
+                    float v = glm::dot(ray.direction, q) * inverseDeterminant;
+                    if (v < 0.f || u + v > 1.f) {
+                        continue;
+                    }
+
+                    float distance = glm::dot(triangle.edge2, q) * inverseDeterminant;
+                    if (distance >= 0.f && distance < closest) {
+                        closest = distance;
+                        hit.triangle = mTriangleIndices[i];
+                        hit.distance = distance;
+                        hit.barycentrics = glm::vec2(u, v);
+                        isHit = true;
+                    }
+                }
+            } else {
+                float leftEntry = 0.f;
+                float rightEntry = 0.f;
+                bool hitsLeft = IntersectBox(mNodes[node.offset], rayData, closest, leftEntry);
+                bool hitsRight = IntersectBox(mNodes[node.offset + 1], rayData, closest, rightEntry);
+
+                // Nearer child goes first, so that hits found there let the farther one be skipped
+                if (hitsLeft && hitsRight) {
+                    bool leftIsNearer = leftEntry <= rightEntry;
+                    stack[stackSize++] = leftIsNearer ? StackEntry{ node.offset + 1, rightEntry } : StackEntry{ node.offset, leftEntry };
+                    nodeIndex = leftIsNearer ? node.offset : node.offset + 1;
+                    continue;
+                }
+
+                if (hitsLeft || hitsRight) {
+                    nodeIndex = hitsLeft ? node.offset : node.offset + 1;
+                    continue;
+                }
+            }
+
+            // Postponed nodes may have ended up behind a hit found in the meantime
+            while (stackSize > 0 && stack[stackSize - 1].entry > closest) {
+                --stackSize;
+            }
+
+            if (stackSize == 0) {
+                break;
+            }
+            nodeIndex = stack[--stackSize].node;
+        }
+
+        return isHit;
+    }
+
+    AxisAlignedBox3D TriangleBVH::boundingBox() const {
+        return mNodes.empty() ? AxisAlignedBox3D::Zero() : AxisAlignedBox3D(mNodes.front().min, mNodes.front().max);
+    }
+
+    size_t TriangleBVH::nodeCount() const {
+        return mNodes.size();
+    }
+
+    size_t TriangleBVH::triangleCount() const {
+        return mTriangles.size();
+    }
+
+}
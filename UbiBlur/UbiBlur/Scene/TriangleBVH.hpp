@@ -0,0 +1,97 @@
+//
+//  TriangleBVH.hpp
+//  Engine
+//
+//  Created by Pavlo Muratov on 19.10.2026.
+//  Copyright © 2026 MPO. All rights reserved.
+//
+
+#ifndef TriangleBVH_hpp
+#define TriangleBVH_hpp
+
+#include "Mesh.hpp"
+#include "Ray3D.hpp"
+#include "AxisAlignedBox3D.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+
+namespace Engine {
+
+    /**
+     Bounding volume hierarchy over mesh triangles for ray casts and picking.
+
+     Built top-down with binned surface area heuristic (Wald 2007): triangle centroids are sorted into bins along
+     each axis and the cheapest bin boundary of all three axes becomes the split. Nodes of one tree level are built
+     concurrently, the top few levels, having too few nodes for that, bin their triangles concurrently instead.
+
+     Nodes are 32 bytes, two per cache line, siblings are adjacent so interior nodes only store the first child.
+     Triangles are copied in leaf order, precomputed for Moller-Trumbore intersection.
+     */
+    class TriangleBVH {
+    public:
+        /// Number of candidate split positions per axis is one less than that, nodes with fewer triangles use fewer bins
+        static constexpr size_t BinCount = 16;
+        static constexpr size_t MaximumLeafTriangles = 8;
+
+        struct Hit {
+            /// Index of the triangle in the source index list, i.e. first index / 3
+            uint32_t triangle = 0;
+            float distance = 0.f;
+            /// Weights of the second and third vertices, the first one gets 1 - x - y
+            glm::vec2 barycentrics = glm::vec2(0.f);
+        };
+
+    private:
+        struct Node {
+            glm::vec3 min;
+            /// First triangle for leaves, left child for interior nodes, the right one follows it
+            uint32_t offset;
+            glm::vec3 max;
+            /// Zero for interior nodes
+            uint32_t triangleCount;
+        };
+
+        static_assert(sizeof(Node) == 32, "Nodes are expected to pack two per cache line");
+
+        struct LeafTriangle {
+            glm::vec3 vertex;
+            glm::vec3 edge1;
+            glm::vec3 edge2;
+        };
+
+        std::vector<Node> mNodes;
+        std::vector<LeafTriangle> mTriangles;
+        /// Source triangle index of every leaf triangle
+        std::vector<uint32_t> mTriangleIndices;
+
+        /// @throws std::invalid_argument if a triangle references a vertex past vertexCount
+        void build(const Vertex1P1N2UV1T1BT *vertices, size_t vertexCount, const uint32_t *indices, size_t triangleCount);
+
+    public:
+        /// Indexes the full detail level of the mesh
+        /// @throws std::invalid_argument if an index is out of range
+        explicit TriangleBVH(const Mesh &mesh);
+
+        /// @param indices triangle list, or nullptr for a non-indexed mesh
+        /// @throws std::invalid_argument if an index is out of range or index count is not a multiple of 3
+        TriangleBVH(const Vertex1P1N2UV1T1BT *vertices, size_t vertexCount, const uint32_t *indices, size_t indexCount);
+
+        /// Finds the nearest triangle the ray hits in front of its origin, both faces count
+        /// @return false if there is no hit closer than maximumDistance
+        bool closestHit(const Ray3D &ray, Hit &hit, float maximumDistance = std::numeric_limits<float>::max()) const;
+
+        AxisAlignedBox3D boundingBox() const;
+
+        size_t nodeCount() const;
+
+        size_t triangleCount() const;
+    };
+
+}
+
+#endif /* TriangleBVH_hpp */
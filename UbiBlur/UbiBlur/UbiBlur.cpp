@@ -2,9 +2,18 @@
 //
 
 #include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
 #include <glad/glad.h>
-#include <glfw3.h>
 #include "Renderer.hpp"
+#include "GLHeadlessContext.hpp"
+#include "StringUtils.hpp"
+#include "PNGEncoder.hpp"
+
+#if UBIBLUR_HAS_GLFW
+#include <glfw3.h>
 
 static void error_callback(int error, const char* description) {
 	fprintf(stderr, "Error: %s\n", description);
@@ -29,10 +38,87 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
 	}
 }
 
+static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
+	if (button != GLFW_MOUSE_BUTTON_LEFT || action != GLFW_PRESS) {
+		return;
+	}
+
+	Engine::Renderer *renderer = static_cast<Engine::Renderer*>(glfwGetWindowUserPointer(window));
+
+	double x, y;
+	int width, height;
+	glfwGetCursorPos(window, &x, &y);
+	glfwGetWindowSize(window, &width, &height);
+
+	// Window coordinates grow downwards, NDC grow upwards
+	glm::vec2 ndc(2.0 * x / width - 1.0, 1.0 - 2.0 * y / height);
+
+	// Shown in the title bar, the window has no other UI
+	Engine::TriangleBVH::Hit hit;
+	if (renderer->pick(ndc, hit)) {
+		glfwSetWindowTitle(window, string_format("Blur - triangle %u at %.3f", hit.triangle, hit.distance).c_str());
+	} else {
+		glfwSetWindowTitle(window, "Blur");
+	}
+}
+
+#endif
+
+static int run_headless(const filesystem::path &resourceRoot, const Engine::Size2D &rtSize, int frameCount, const std::string &outputPath) {
+	try {
+		Engine::GLHeadlessContext context;
+		gladLoadGLLoader((GLADloadproc)Engine::GLHeadlessContext::ProcAddress);
+
+		Engine::Renderer renderer(resourceRoot, rtSize);
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < frameCount; i++) {
+			renderer.render();
+		}
+		glFinish();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+		printf("Rendered %d frames at %dx%d in %.2f ms (%.3f ms/frame)\n",
+			frameCount, int(rtSize.width), int(rtSize.height), elapsed.count(), elapsed.count() / frameCount);
+
+		// Last frame as a PNG, lets rendering changes be compared pixel by pixel
+		if (!outputPath.empty()) {
+			std::vector<uint8_t> pixels = renderer.readFrame();
+			Engine::PNGEncoder::Write(outputPath, pixels.data(), size_t(rtSize.width), size_t(rtSize.height), 4, true);
+		}
+	}
+	catch (const std::exception &e) {
+		fprintf(stderr, "Error: %s\n", e.what());
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
 int main(int argc, char* argv[]) {
 	filesystem::path path(argv[0]);
 	Engine::Size2D rtSize(1280, 720);
 
+	bool headless = false;
+	int frameCount = 100;
+	std::string outputPath;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--headless") == 0) {
+			headless = true;
+		} else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			frameCount = std::max(atoi(argv[++i]), 1);
+		} else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+			outputPath = argv[++i];
+		}
+	}
+
+	// Builds without GLFW have nothing to open a window with
+	if (headless || !UBIBLUR_HAS_GLFW) {
+		exit(run_headless(path.parent_path(), rtSize, frameCount, outputPath));
+	}
+
+#if UBIBLUR_HAS_GLFW
 	if (!glfwInit()) {
 		exit(EXIT_FAILURE);
 	}
@@ -51,6 +137,7 @@ int main(int argc, char* argv[]) {
 	}
 
 	glfwSetKeyCallback(window, key_callback);
+	glfwSetMouseButtonCallback(window, mouse_button_callback);
 	glfwMakeContextCurrent(window);
 	gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
 	glfwSwapInterval(1);
@@ -60,6 +147,7 @@ int main(int argc, char* argv[]) {
 
 	while (!glfwWindowShouldClose(window)) {
 		renderer.render();
+		renderer.present();
 		glfwSwapBuffers(window);
 		glfwPollEvents();
 	}
@@ -67,4 +155,5 @@ int main(int argc, char* argv[]) {
 	glfwDestroyWindow(window);
 	glfwTerminate();
 	exit(EXIT_SUCCESS);
+#endif
 }
\ No newline at end of file